@@ -0,0 +1,65 @@
+#ifndef ALLPAIRS_H
+#define ALLPAIRS_H
+
+    #include "Settings.h"
+    #include "graph.h"
+    #include "ShortestPath.h"
+
+    /// @brief Côté des tuiles carrées de l'algorithme de Floyd-Warshall par blocs.
+    /// Une tuile de distances (64 x 64 float, 16 Ko) tient dans le cache L1.
+    #define ALL_PAIRS_BLOCK 64
+
+    /// @brief Distances et premiers sommets des plus courts chemins entre tous
+    /// les couples de sommets.
+    /// Les matrices sont stockées ligne par ligne, avec stride cases par ligne
+    /// (nodesCount arrondi au multiple de ALL_PAIRS_BLOCK supérieur).
+    /// La mémoire utilisée est en O(n^2) : ce calcul est réservé aux graphes de
+    /// quelques milliers de sommets.
+    typedef struct AllPairs
+    {
+        int nodesCount;
+        int stride;
+
+        /// @brief Distance de i à j dans la case i * stride + j, INFINITY s'il
+        /// n'existe pas de chemin.
+        float* distances;
+
+        /// @brief Sommet suivant i sur un plus court chemin de i à j dans la case
+        /// i * stride + j, -1 s'il n'existe pas de chemin. nextHops[i][i] vaut i.
+        int* nextHops;
+    } AllPairs;
+
+    /// @brief Calcule les plus courts chemins entre tous les couples de sommets
+    /// avec l'algorithme de Floyd-Warshall par blocs.
+    /// Pour chaque bloc k, la tuile diagonale (k, k) est calculée, puis les
+    /// tuiles de la ligne et de la colonne k, puis toutes les autres ; les
+    /// tuiles d'une même étape sont indépendantes et réparties entre plusieurs
+    /// threads. Le noyau de mise à jour d'une tuile utilise AVX2 si le
+    /// processeur le permet (voir Platform_hasAvx2()).
+    /// Les poids des arcs doivent être positifs ou nuls.
+    /// Les distances sont les mêmes que celles de Graph_dijkstra() avec end < 0
+    /// lancé depuis chaque sommet.
+    /// @param graph le graphe.
+    /// @return Les matrices calculées, à détruire avec AllPairs_destroy().
+    AllPairs* Graph_allPairs(Graph* graph);
+
+    void AllPairs_destroy(AllPairs* allPairs);
+
+    INLINE float AllPairs_distance(const AllPairs* allPairs, int from, int to)
+    {
+        assert(allPairs && from >= 0 && from < allPairs->nodesCount && to >= 0 && to < allPairs->nodesCount);
+        return allPairs->distances[(size_t)from * allPairs->stride + to];
+    }
+
+    INLINE int AllPairs_nextHop(const AllPairs* allPairs, int from, int to)
+    {
+        assert(allPairs && from >= 0 && from < allPairs->nodesCount && to >= 0 && to < allPairs->nodesCount);
+        return allPairs->nextHops[(size_t)from * allPairs->stride + to];
+    }
+
+    /// @brief Reconstruit le plus court chemin de from à to en suivant les
+    /// sommets suivants, en O(longueur du chemin).
+    /// @return Le chemin s'il existe, NULL sinon.
+    Path* AllPairs_getPath(const AllPairs* allPairs, int from, int to);
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef ALTINDEX_H
+#define ALTINDEX_H
+
+    #include "Settings.h"
+    #include "graph.h"
+
+    /// @brief Extension du fichier des tables, ajoutée au nom complet du fichier
+    /// du graphe par AltIndex_loadOrBuild() : graph.json.alt pour graph.json,
+    /// comme le journal des modifications.
+    #define ALT_FILE_EXTENSION ".alt"
+
+    /// @brief Stratégie de choix des repères.
+    typedef enum AltLandmarkStrategy
+    {
+        /// @brief Chaque nouveau repère est le sommet le plus éloigné des
+        /// repères déjà choisis.
+        ALT_LANDMARKS_FARTHEST = 0,
+
+        /// @brief Stratégie "avoid" de Goldberg et Werneck : le nouveau repère est
+        /// une feuille d'un arbre de plus courts chemins, atteinte en suivant les
+        /// sous-arbres où les bornes des repères actuels sont les plus mauvaises.
+        ALT_LANDMARKS_AVOID
+    } AltLandmarkStrategy;
+
+    /// @brief Index ALT (A*, Landmarks, Triangle inequality).
+    /// Pour chaque repère L et chaque sommet v, l'index stocke d(L, v) et d(v, L).
+    /// Par l'inégalité triangulaire, d(v, t) >= d(L, t) - d(L, v) et
+    /// d(v, t) >= d(v, L) - d(t, L), ce qui donne une heuristique admissible pour A*.
+    typedef struct AltIndex
+    {
+        /// @brief Nombre de sommets et d'arcs et empreinte (Graph_fingerprint())
+        /// du graphe lors du calcul des tables.
+        int nodesCount;
+        int graphArcsCount;
+        uint64_t graphFingerprint;
+
+        /// @brief Nombre de repères et indices des sommets repères.
+        int landmarksCount;
+        int* landmarks;
+
+        /// @brief fromLandmark[v * landmarksCount + i] = d(landmarks[i], v).
+        /// Les distances d'un même sommet sont contiguës : le calcul de la borne
+        /// d'un sommet ne lit qu'une ligne de chaque table.
+        float* fromLandmark;
+
+        /// @brief toLandmark[v * landmarksCount + i] = d(v, landmarks[i]).
+        float* toLandmark;
+    } AltIndex;
+
+    /// @brief Choisit les repères et calcule les tables de distances.
+    /// Les recherches depuis et vers chaque repère s'exécutent en parallèle.
+    /// @param graph le graphe.
+    /// @param landmarksCount le nombre de repères (limité au nombre de sommets).
+    /// @param strategy la stratégie de choix des repères.
+    /// @return L'index créé.
+    AltIndex* AltIndex_build(Graph* graph, int landmarksCount, AltLandmarkStrategy strategy);
+
+    /// @brief Détruit un index.
+    void AltIndex_destroy(AltIndex* alt);
+
+    /// @brief Indique si l'index correspond encore au graphe : même nombre de
+    /// sommets et d'arcs et même empreinte. Un poids modifié, une renumérotation
+    /// ou un autre graphe de même taille rendraient les bornes fausses.
+    bool AltIndex_matches(AltIndex* alt, Graph* graph);
+
+    /// @brief Enregistre l'index dans un fichier binaire.
+    /// @return true en cas de succès.
+    bool AltIndex_save(AltIndex* alt, const char* fileName);
+
+    /// @brief Charge un index enregistré avec AltIndex_save().
+    /// @return L'index, NULL si le fichier est absent ou invalide.
+    AltIndex* AltIndex_load(const char* fileName);
+
+    /// @brief Charge l'index du fichier fileName s'il correspond au graphe et au
+    /// nombre de repères demandé, sinon le construit et l'enregistre dans ce fichier.
+    /// Si fileName vaut NULL, le fichier est celui du graphe suivi de ALT_FILE_EXTENSION.
+    AltIndex* AltIndex_loadOrBuild(Graph* graph, const char* fileName, int landmarksCount, AltLandmarkStrategy strategy);
+
+    /// @brief Renvoie un minorant de la distance du sommet node au sommet target.
+    /// Renvoie INFINITY si l'index prouve que target est inaccessible depuis node.
+    INLINE float AltIndex_lowerBound(const AltIndex* alt, int node, int target)
+    {
+        assert(alt && node >= 0 && node < alt->nodesCount && target >= 0 && target < alt->nodesCount);
+
+        int k = alt->landmarksCount;
+        const float* fromNode = alt->fromLandmark + (size_t)node * k;
+        const float* fromTarget = alt->fromLandmark + (size_t)target * k;
+        const float* toNode = alt->toLandmark + (size_t)node * k;
+        const float* toTarget = alt->toLandmark + (size_t)target * k;
+
+        float bound = 0.0f;
+        for (int i = 0; i < k; i++) {
+            // An infinite term on one side only is a valid (infinite) bound,
+            // infinite on both sides gives no information
+            if (!(isinf(fromTarget[i]) && isinf(fromNode[i]))) {
+                bound = fmaxf(bound, fromTarget[i] - fromNode[i]);
+            }
+            if (!(isinf(toNode[i]) && isinf(toTarget[i]))) {
+                bound = fmaxf(bound, toNode[i] - toTarget[i]);
+            }
+        }
+        return bound;
+    }
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef ASYNCSAVE_H
+#define ASYNCSAVE_H
+
+    #include "Settings.h"
+    #include "graph.h"
+
+    struct PlatformThread;
+
+    /// @brief Enregistrement d'un graphe sur un thread séparé.
+    ///
+    /// Le graphe est copié (voir Graph_snapshot()) par le thread qui lance
+    /// l'enregistrement ; la copie est ensuite écrite par un autre thread avec
+    /// Graph_saveAs(), qui remplace le fichier d'un seul coup une fois écrit.
+    /// Le graphe d'origine peut donc être affiché et modifié pendant
+    /// l'écriture, et un arrêt brutal ne laisse jamais de fichier incomplet.
+    typedef struct AsyncSave
+    {
+        /// @brief Copie du graphe en cours d'écriture.
+        Graph* snapshot;
+
+        /// @brief Thread qui écrit la copie, NULL si l'écriture a eu lieu
+        /// sur le thread appelant faute de pouvoir créer un thread.
+        struct PlatformThread* thread;
+
+        /// @brief Nombre de sommets déjà écrits, mis à jour par Graph_saveAs().
+        volatile uint64_t progress;
+
+        /// @brief Passe à 1 quand l'écriture est terminée.
+        volatile uint64_t done;
+
+        /// @brief Résultat de Graph_saveAs(), valide une fois le thread terminé.
+        bool ok;
+    } AsyncSave;
+
+    /// @brief Lance l'enregistrement du graphe dans son fichier, au même
+    /// format que saveGraph(). Seule la copie du graphe est faite avant le retour.
+    /// @return L'enregistrement en cours, à terminer avec AsyncSave_finish().
+    AsyncSave* Graph_saveAsync(Graph* graph);
+
+    /// @brief Indique si l'écriture est terminée, sans attendre.
+    bool AsyncSave_isDone(AsyncSave* save);
+
+    /// @brief Renvoie l'avancement de l'écriture, entre 0 et 1.
+    float AsyncSave_progress(AsyncSave* save);
+
+    /// @brief Attend la fin de l'écriture et libère l'enregistrement.
+    /// @return true si le fichier a été enregistré.
+    bool AsyncSave_finish(AsyncSave* save);
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef BREADTHFIRSTSEARCH_H
+#define BREADTHFIRSTSEARCH_H
+
+    #include "Settings.h"
+    #include "graph.h"
+    #include "ShortestPath.h"
+
+    /// @brief Le parcours passe en mode ascendant quand les arcs sortants de la
+    /// frontière dépassent 1 / BFS_ALPHA des arcs des sommets non visités.
+    #define BFS_ALPHA 14
+
+    /// @brief Le parcours repasse en mode descendant quand la frontière contient
+    /// moins de 1 / BFS_BETA des sommets.
+    #define BFS_BETA 24
+
+    /// @brief Calcule les plus courts chemins depuis start dans un graphe dont
+    /// tous les arcs ont le même poids, par un parcours en largeur niveau par niveau.
+    /// Le parcours change de sens selon la taille de la frontière (méthode de
+    /// Beamer, Asanović et Patterson) :
+    /// - en mode descendant, les arcs sortants des sommets de la frontière sont
+    ///   parcourus ;
+    /// - en mode ascendant, chaque sommet non visité cherche parmi ses arcs
+    ///   entrants un sommet de la frontière, stockée sous forme de bitmap, et
+    ///   s'arrête au premier trouvé. Ce mode est bien plus rapide quand la
+    ///   frontière couvre une grande partie du graphe.
+    /// Les tableaux predecessors et distances ont le même sens que pour
+    /// Graph_dijkstra() : Graph_dijkstraGetPath() les accepte tels quels.
+    ///
+    /// @param graph le graphe.
+    /// @param start l'indice du sommet de départ.
+    /// @param end l'indice du sommet d'arrivée. Le parcours s'arrête à la fin du
+    ///     niveau qui l'atteint. Si end < 0, tous les sommets accessibles sont visités.
+    /// @param predecessors tableau des prédecesseurs.
+    /// @param distances tableau des distances.
+    /// @param weight le poids commun des arcs (voir Graph_uniformWeight()).
+    /// @param stats si non NULL, reçoit le nombre de sommets visités.
+    void Graph_bfs(Graph* graph, int start, int end, int* predecessors, float* distances, int weight, ShortestPathStats* stats);
+
+#endif
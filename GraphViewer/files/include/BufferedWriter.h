@@ -0,0 +1,63 @@
+#ifndef BUFFEREDWRITER_H
+#define BUFFEREDWRITER_H
+
+    #include "Settings.h"
+
+    /// @brief Taille par défaut du tampon d'écriture.
+    #define BUFFERED_WRITER_CAPACITY (1 << 20)
+
+    /// @brief Ecriture d'un fichier par blocs : le texte est formaté directement
+    /// dans un grand tampon, vidé dans le fichier par un seul fwrite() quand il
+    /// est plein. Les entiers et les réels sont convertis sans passer par printf.
+    typedef struct BufferedWriter
+    {
+        FILE* file;
+        char* buffer;
+        size_t capacity;
+
+        /// @brief Nombre d'octets en attente dans le tampon.
+        size_t length;
+
+        /// @brief Nombre d'octets déjà écrits dans le fichier.
+        uint64_t written;
+
+        /// @brief true si une écriture dans le fichier a échoué.
+        bool failed;
+    } BufferedWriter;
+
+    /// @brief Prépare l'écriture dans un fichier ouvert.
+    /// @param capacity la taille du tampon, 0 pour BUFFERED_WRITER_CAPACITY.
+    void BufferedWriter_init(BufferedWriter* writer, FILE* file, size_t capacity);
+
+    /// @brief Ecrit le contenu du tampon dans le fichier.
+    void BufferedWriter_flush(BufferedWriter* writer);
+
+    /// @brief Vide le tampon et libère sa mémoire. Le fichier n'est pas fermé.
+    /// @return false si une écriture a échoué.
+    bool BufferedWriter_finish(BufferedWriter* writer);
+
+    /// @brief Ajoute size octets.
+    void BufferedWriter_write(BufferedWriter* writer, const void* data, size_t size);
+
+    /// @brief Ajoute un entier en base 10, comme printf("%d").
+    void BufferedWriter_writeInt(BufferedWriter* writer, int value);
+
+    /// @brief Ajoute un réel avec un chiffre après la virgule, comme printf("%.1f").
+    void BufferedWriter_writeFloat1(BufferedWriter* writer, float value);
+
+    INLINE void BufferedWriter_writeChar(BufferedWriter* writer, char c)
+    {
+        if (writer->length == writer->capacity)
+        {
+            BufferedWriter_flush(writer);
+        }
+        writer->buffer[writer->length++] = c;
+    }
+
+    /// @brief Ajoute une chaîne terminée par '\0', sans le '\0'.
+    INLINE void BufferedWriter_writeString(BufferedWriter* writer, const char* str)
+    {
+        BufferedWriter_write(writer, str, strlen(str));
+    }
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+
+    #include "Settings.h"
+    #include "graph.h"
+    #include "ShortestPath.h"
+
+    /// @brief Arc de la hiérarchie : arc du graphe d'origine ou raccourci.
+    typedef struct ChArc
+    {
+        int from;
+        int to;
+        float weight;
+
+        /// @brief Pour un raccourci from -> to créé en contractant un sommet m,
+        /// indices des arcs from -> m et m -> to. -1 pour un arc d'origine.
+        int firstChild;
+        int secondChild;
+    } ChArc;
+
+    /// @brief Contraction Hierarchy d'un graphe.
+    /// Chaque sommet reçoit un rang (son ordre de contraction) ; la requête est une
+    /// recherche bidirectionnelle qui ne suit que des arcs montant vers des
+    /// sommets de rang supérieur.
+    /// Les tableaux de requête sont réutilisés d'une requête à l'autre : une même
+    /// hiérarchie ne doit pas être interrogée par plusieurs threads à la fois.
+    typedef struct ContractionHierarchy
+    {
+        /// @brief Nombre de sommets et d'arcs et empreinte (Graph_fingerprint())
+        /// du graphe lors du prétraitement.
+        int nodesCount;
+        int graphArcsCount;
+        uint64_t graphFingerprint;
+
+        /// @brief Rang de chaque sommet.
+        int* rank;
+
+        /// @brief Arcs d'origine et raccourcis.
+        ChArc* arcs;
+        int arcsCount;
+
+        /// @brief Arcs montants u -> v (rank[v] > rank[u]) rangés par sommet u.
+        int* upOffsets;
+        int* upArcs;
+
+        /// @brief Arcs descendants u -> v (rank[u] > rank[v]) rangés par sommet v,
+        /// suivis à l'envers par la recherche arrière.
+        int* downOffsets;
+        int* downArcs;
+
+        /// @brief Etat des recherches, remis à zéro uniquement sur les sommets visités.
+        float* forwardDistances;
+        float* backwardDistances;
+        int* forwardParents;
+        int* backwardParents;
+        int* touched;
+        int touchedCount;
+        IndexedHeap* forwardHeap;
+        IndexedHeap* backwardHeap;
+    } ContractionHierarchy;
+
+    /// @brief Construit la hiérarchie d'un graphe.
+    /// Les sommets sont contractés par ordre croissant de priorité
+    /// (différence d'arcs + nombre de voisins déjà contractés), avec mise à jour
+    /// paresseuse des priorités. Un raccourci u -> w n'est ajouté que si une
+    /// recherche de témoin limitée ne trouve pas de chemin plus court évitant
+    /// le sommet contracté.
+    /// @param graph le graphe.
+    /// @return La hiérarchie créée.
+    ContractionHierarchy* ContractionHierarchy_build(Graph* graph);
+
+    /// @brief Détruit une hiérarchie.
+    void ContractionHierarchy_destroy(ContractionHierarchy* ch);
+
+    /// @brief Indique si la hiérarchie correspond encore au graphe : même nombre
+    /// de sommets et d'arcs et même empreinte (poids et numérotation compris).
+    bool ContractionHierarchy_matches(ContractionHierarchy* ch, Graph* graph);
+
+    /// @brief Enregistre la hiérarchie dans un fichier binaire.
+    /// @return true en cas de succès.
+    bool ContractionHierarchy_save(ContractionHierarchy* ch, const char* fileName);
+
+    /// @brief Charge une hiérarchie enregistrée avec ContractionHierarchy_save().
+    /// Les rangs, les extrémités des arcs et les enfants des raccourcis sont
+    /// vérifiés avant d'être utilisés.
+    /// @return La hiérarchie, NULL si le fichier est absent ou invalide.
+    ContractionHierarchy* ContractionHierarchy_load(const char* fileName);
+
+    /// @brief Charge la hiérarchie du fichier fileName si elle correspond au
+    /// graphe, sinon la construit et l'enregistre dans ce fichier.
+    ContractionHierarchy* ContractionHierarchy_loadOrBuild(Graph* graph, const char* fileName);
+
+    /// @brief Renvoie la distance entre deux sommets, INFINITY s'il n'existe pas de chemin.
+    /// @param stats si non NULL, reçoit le nombre de sommets traités.
+    float ContractionHierarchy_distance(ContractionHierarchy* ch, int start, int end, ShortestPathStats* stats);
+
+    /// @brief Renvoie un plus court chemin entre deux sommets, les raccourcis
+    /// étant dépliés en arcs du graphe d'origine.
+    /// @return Le chemin, NULL s'il n'existe pas.
+    Path* ContractionHierarchy_shortestPath(ContractionHierarchy* ch, Graph* graph, int start, int end, ShortestPathStats* stats);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef DELTASTEPPING_H
+#define DELTASTEPPING_H
+
+    #include "Settings.h"
+    #include "graph.h"
+    #include "ShortestPath.h"
+
+    /// @brief Taille minimale d'une frontière pour que ses relâchements soient
+    /// répartis entre plusieurs threads.
+    #define DELTA_STEPPING_PARALLEL_THRESHOLD 256
+
+    /// @brief Calcule les plus courts chemins depuis start vers tous les sommets
+    /// avec l'algorithme delta-stepping de Meyer et Sanders.
+    /// Les sommets sont rangés dans des seaux de largeur delta selon leur
+    /// distance provisoire. Les seaux sont traités dans l'ordre : les arcs légers
+    /// (poids <= delta) sont relâchés jusqu'à ce que le seau se stabilise, puis
+    /// les arcs lourds de tous les sommets du seau le sont une seule fois.
+    /// Chaque phase de relâchement est répartie entre plusieurs threads,
+    /// démarrés une seule fois par appel (voir Platform_startPool()) ; les
+    /// distances sont mises à jour par compare-and-swap.
+    /// Les poids des arcs doivent être positifs ou nuls.
+    /// Les tableaux predecessors et distances ont le même sens que pour
+    /// Graph_dijkstra() avec end < 0 : Graph_dijkstraGetPath() les accepte tels quels.
+    ///
+    /// @param graph le graphe.
+    /// @param start l'indice du sommet de départ.
+    /// @param predecessors tableau des prédecesseurs.
+    /// @param distances tableau des distances.
+    /// @param delta la largeur des seaux, ou une valeur <= 0 pour utiliser le
+    ///     poids moyen des arcs.
+    /// @param stats si non NULL, reçoit le nombre de sommets traités (un sommet
+    ///     peut être traité plusieurs fois).
+    void Graph_deltaStepping(Graph* graph, int start, int* predecessors, float* distances, float delta, ShortestPathStats* stats);
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef DYNAMICSHORTESTPATH_H
+#define DYNAMICSHORTESTPATH_H
+
+    #include "Settings.h"
+    #include "graph.h"
+    #include "ShortestPath.h"
+
+    /// @brief Arbre des plus courts chemins depuis une source, maintenu à jour
+    /// pendant l'édition du graphe.
+    /// L'arbre s'enregistre comme observateur du graphe (Graph_addObserver()) :
+    /// chaque modification faite par les fonctions d'édition ne recalcule que
+    /// ce qui a pu changer.
+    /// - Un arc ajouté ou dont le poids diminue propage l'amélioration depuis
+    ///   son sommet d'arrivée, comme l'algorithme de Dijkstra.
+    /// - Un arc supprimé ou dont le poids augmente ne change rien s'il
+    ///   n'appartient pas à l'arbre. Sinon seul le sous-arbre sous cet arc est
+    ///   recalculé : ses sommets reprennent le meilleur arc entrant venant de
+    ///   l'extérieur du sous-arbre, puis les distances sont propagées à
+    ///   l'intérieur du sous-arbre.
+    /// - La suppression d'un sommet décale les indices et recalcule tout l'arbre.
+    /// Les poids des arcs doivent être positifs ou nuls.
+    typedef struct DynamicShortestPath
+    {
+        Graph* graph;
+
+        /// @brief Sommet source, -1 s'il a été supprimé du graphe.
+        int source;
+
+        /// @brief Sommet d'arrivée suivi par DynamicShortestPath_getPath(),
+        /// -1 s'il n'y en a pas ou s'il a été supprimé du graphe.
+        int target;
+
+        /// @brief Distance depuis la source et prédécesseur dans l'arbre de
+        /// chaque sommet (INFINITY et -1 si le sommet n'est pas atteignable).
+        float* distances;
+        int* predecessors;
+
+        /// @brief Taille allouée des tableaux par sommet.
+        int capacity;
+
+        IndexedHeap* heap;
+
+        /// @brief Sommets du sous-arbre en cours de réparation, et tampons
+        /// marquant leur appartenance au sous-arbre.
+        int* subtree;
+        uint32_t* stamps;
+        uint32_t stamp;
+
+        /// @brief Incrémenté à chaque modification du graphe susceptible de
+        /// changer l'arbre.
+        int version;
+
+        /// @brief Nombre de sommets recalculés lors de la dernière mise à jour.
+        int updatedCount;
+    } DynamicShortestPath;
+
+    /// @brief Calcule l'arbre des plus courts chemins depuis source et
+    /// l'enregistre comme observateur du graphe.
+    /// @param graph le graphe.
+    /// @param source l'indice du sommet source.
+    /// @return L'arbre, à détruire avec DynamicShortestPath_destroy() avant le graphe.
+    DynamicShortestPath* DynamicShortestPath_create(Graph* graph, int source);
+
+    /// @brief Retire l'arbre des observateurs de son graphe et le détruit.
+    void DynamicShortestPath_destroy(DynamicShortestPath* tree);
+
+    /// @brief Change le sommet d'arrivée suivi par l'arbre.
+    /// @param target l'indice du sommet, -1 pour n'en suivre aucun.
+    void DynamicShortestPath_setTarget(DynamicShortestPath* tree, int target);
+
+    /// @brief Reconstruit le chemin de la source vers le sommet d'arrivée suivi.
+    /// @return Le plus court chemin s'il existe, NULL sinon.
+    Path* DynamicShortestPath_getPath(DynamicShortestPath* tree);
+
+    INLINE float DynamicShortestPath_distance(const DynamicShortestPath* tree, int node)
+    {
+        assert(tree && node >= 0 && node < tree->graph->nodesCount);
+        return tree->distances[node];
+    }
+
+    INLINE int DynamicShortestPath_predecessor(const DynamicShortestPath* tree, int node)
+    {
+        assert(tree && node >= 0 && node < tree->graph->nodesCount);
+        return tree->predecessors[node];
+    }
+
+#endif
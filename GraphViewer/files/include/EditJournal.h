@@ -0,0 +1,112 @@
+#ifndef EDITJOURNAL_H
+#define EDITJOURNAL_H
+
+    #include "Settings.h"
+    #include "graph.h"
+
+    struct EditJournalCompaction;
+
+    /// @brief Extension du journal, ajoutée au nom du fichier du graphe.
+    #define EDIT_JOURNAL_EXTENSION ".journal"
+
+    /// @brief Taille en dessous de laquelle le journal n'est jamais compacté.
+    #define EDIT_JOURNAL_MIN_COMPACT_SIZE (1 << 16)
+
+    /// @brief Journal des modifications d'un graphe (write-ahead log).
+    ///
+    /// Au lieu de réécrire tout le fichier du graphe à chaque enregistrement,
+    /// les modifications faites par les fonctions d'édition (ajout, suppression,
+    /// renommage et déplacement de sommets, ajout, suppression et poids des
+    /// arcs, renumérotation) sont ajoutées sous forme d'enregistrements binaires
+    /// compacts au fichier <graphe>.journal : un enregistrement coûte
+    /// O(taille de la modification), quelle que soit la taille du graphe.
+    ///
+    /// Le fichier du graphe sert d'instantané : au chargement, les
+    /// enregistrements du journal lui sont réappliqués. L'en-tête du journal
+    /// contient la taille et l'identifiant (Graph.snapshotId) de l'instantané
+    /// auquel il s'applique, si bien qu'un journal n'est jamais rejoué sur un
+    /// autre fichier. Un fichier JSON, qui n'a pas d'identifiant, est identifié
+    /// par l'empreinte du graphe chargé (Graph_fingerprint()), sans être relu.
+    /// Chaque enregistrement porte sa propre somme de contrôle : une fin de
+    /// journal incomplète (arrêt brutal pendant une écriture) est ignorée.
+    ///
+    /// Quand le journal dépasse la moitié de la taille de l'instantané,
+    /// celui-ci est réécrit sur un autre thread (compaction), puis le journal
+    /// est vidé des enregistrements qu'il contient désormais. Un
+    /// enregistrement de point de contrôle marque l'état copié et porte
+    /// l'identifiant du nouvel instantané : si le programme s'arrête entre le
+    /// remplacement de l'instantané et celui du journal, seuls les
+    /// enregistrements postérieurs au point de contrôle sont rejoués, et
+    /// seulement sur cet instantané.
+    typedef struct EditJournal
+    {
+        /// @brief Graphe suivi et nom de son journal.
+        Graph* graph;
+        char* fileName;
+
+        /// @brief Fichier du journal ouvert en ajout, NULL tant qu'il n'existe pas.
+        FILE* file;
+
+        /// @brief Taille du fichier du journal.
+        uint64_t size;
+
+        /// @brief Position dans le fichier du premier enregistrement à rejouer
+        /// sur l'instantané actuel. Elle suit l'en-tête, sauf si le journal n'a
+        /// pas pu être réécrit après une compaction : elle suit alors le point
+        /// de contrôle, et le journal est réécrit avant tout nouvel ajout.
+        uint64_t base;
+
+        /// @brief Taille et identifiant de l'instantané auquel s'applique le journal.
+        uint64_t snapshotSize;
+        uint64_t snapshotId;
+
+        /// @brief Enregistrements des modifications pas encore validées par
+        /// EditJournal_commit().
+        char* pending;
+        size_t pendingSize;
+        size_t pendingCapacity;
+
+        /// @brief Position dans le tampon du dernier enregistrement en attente,
+        /// valide si le tampon n'est pas vide.
+        size_t lastRecord;
+
+        /// @brief Compaction en cours, NULL sinon, et taille du journal juste
+        /// après son point de contrôle.
+        struct EditJournalCompaction* compaction;
+        uint64_t checkpoint;
+    } EditJournal;
+
+    /// @brief Ouvre le journal d'un graphe qui vient d'être chargé depuis son
+    /// fichier, lui réapplique les modifications enregistrées, puis suit ses
+    /// modifications. Le fichier du graphe n'est pas relu : l'ouverture d'un
+    /// graphe projeté ne parcourt pas le graphe.
+    /// Par la suite, le fichier du graphe ne doit plus être enregistré que par
+    /// la compaction du journal.
+    /// @return Le journal, NULL si le fichier du graphe ne peut pas être lu.
+    EditJournal* EditJournal_open(Graph* graph);
+
+    /// @brief Termine la compaction en cours et ferme le journal.
+    /// Les modifications non validées par EditJournal_commit() sont perdues,
+    /// comme celles d'un graphe qui n'a pas été enregistré.
+    void EditJournal_close(EditJournal* journal);
+
+    /// @brief Enregistre les modifications faites depuis la dernière validation
+    /// : leurs enregistrements sont ajoutés au journal, qui est forcé sur le
+    /// disque. Lance la compaction si le journal est devenu trop grand.
+    /// @return true en cas de succès.
+    bool EditJournal_commit(EditJournal* journal);
+
+    /// @brief Termine la compaction si le thread qui réécrit l'instantané a fini.
+    /// A appeler régulièrement, par exemple à chaque image.
+    void EditJournal_update(EditJournal* journal);
+
+    /// @brief Indique si une compaction est en cours.
+    bool EditJournal_isCompacting(EditJournal* journal);
+
+    /// @brief Lance la compaction sans attendre que le journal soit trop grand.
+    /// Les modifications doivent avoir été validées par EditJournal_commit().
+    /// @return false si une compaction est déjà en cours ou si des
+    /// modifications ne sont pas validées.
+    bool EditJournal_compact(EditJournal* journal);
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef HUBLABELS_H
+#define HUBLABELS_H
+
+    #include "Settings.h"
+    #include "graph.h"
+    #include "ShortestPath.h"
+
+    /// @brief Nombre maximal de sommets traités simultanément par une étape de
+    /// la construction parallèle.
+    #define HUB_LABELS_MAX_BATCH 64
+
+    /// @brief Index de distances par étiquetage de hubs (Pruned Landmark Labeling,
+    /// Akiba, Iwata et Yoshida).
+    ///
+    /// Les sommets sont classés par importance (produit des degrés entrant et
+    /// sortant). Chaque sommet v reçoit une étiquette sortante Lout(v) et une
+    /// étiquette entrante Lin(v), listes de couples (hub, distance) triées par
+    /// rang de hub, telles que pour tout couple de sommets :
+    /// d(s, t) = min { d(s, h) + d(h, t) : h dans Lout(s) et dans Lin(t) }.
+    /// Une requête est donc une fusion de deux listes triées, sans aucun
+    /// parcours du graphe.
+    ///
+    /// Les étiquettes sont stockées en tableaux séparés (rangs puis distances)
+    /// pour que la fusion puisse comparer les hubs par blocs de 8 en AVX2, si
+    /// le processeur le permet (voir Platform_hasAvx2()).
+    /// Les requêtes ne modifient pas l'index : plusieurs threads peuvent
+    /// l'interroger en même temps.
+    typedef struct HubLabels
+    {
+        /// @brief Nombre de sommets et d'arcs et empreinte (Graph_fingerprint())
+        /// du graphe lors du calcul des étiquettes.
+        int nodesCount;
+        int graphArcsCount;
+        uint64_t graphFingerprint;
+
+        /// @brief Les couples de l'étiquette sortante du sommet v sont rangés dans
+        /// [outOffsets[v], outOffsets[v + 1][.
+        int64_t* outOffsets;
+        int* outHubs;
+        float* outDistances;
+
+        /// @brief Etiquettes entrantes, même organisation.
+        int64_t* inOffsets;
+        int* inHubs;
+        float* inDistances;
+    } HubLabels;
+
+    /// @brief Calcule les étiquettes d'un graphe.
+    /// Pour chaque sommet, par ordre d'importance, une recherche de Dijkstra vers
+    /// l'avant et une vers l'arrière ajoutent le sommet comme hub aux étiquettes
+    /// des sommets atteints ; la recherche est élaguée aux sommets dont la
+    /// distance est déjà donnée par les étiquettes existantes.
+    /// Les sommets sont traités par groupes dont les recherches s'exécutent en
+    /// parallèle : au sein d'un groupe, l'élagage ne tient compte que des
+    /// groupes précédents. Les premiers groupes, qui élaguent le plus, ne
+    /// contiennent qu'un sommet ; les suivants grandissent jusqu'à
+    /// HUB_LABELS_MAX_BATCH sommets.
+    /// @param graph le graphe, dont les poids doivent être positifs ou nuls.
+    /// @return L'index créé.
+    HubLabels* HubLabels_build(Graph* graph);
+
+    /// @brief Détruit un index.
+    void HubLabels_destroy(HubLabels* labels);
+
+    /// @brief Indique si l'index correspond encore au graphe : même nombre de
+    /// sommets et d'arcs et même empreinte (poids et numérotation compris).
+    bool HubLabels_matches(HubLabels* labels, Graph* graph);
+
+    /// @brief Renvoie le nombre moyen de couples par étiquette.
+    float HubLabels_averageSize(HubLabels* labels);
+
+    /// @brief Enregistre l'index dans un fichier binaire.
+    /// @return true en cas de succès.
+    bool HubLabels_save(HubLabels* labels, const char* fileName);
+
+    /// @brief Charge un index enregistré avec HubLabels_save().
+    /// Les tailles de l'en-tête sont comparées à celle du fichier avant toute
+    /// allocation, puis les bornes et les hubs des étiquettes sont vérifiés.
+    /// @return L'index, NULL si le fichier est absent ou invalide.
+    HubLabels* HubLabels_load(const char* fileName);
+
+    /// @brief Charge l'index du fichier fileName s'il correspond au graphe,
+    /// sinon le construit et l'enregistre dans ce fichier.
+    HubLabels* HubLabels_loadOrBuild(Graph* graph, const char* fileName);
+
+    /// @brief Renvoie la distance entre deux sommets, INFINITY s'il n'existe pas
+    /// de chemin. Complexité linéaire en la taille des deux étiquettes.
+    float HubLabels_distance(const HubLabels* labels, int start, int end);
+
+    /// @brief Renvoie un plus court chemin entre deux sommets.
+    /// Le chemin est reconstruit en suivant depuis start un arc u -> v tel que
+    /// w(u, v) + d(v, end) = d(u, end), chaque distance étant une requête dans
+    /// les étiquettes. Si des arcs de poids nul empêchent de conclure, le
+    /// chemin est calculé par l'algorithme de Dijkstra.
+    /// @param stats si non NULL, reçoit le nombre de requêtes de distance effectuées.
+    /// @return Le chemin, NULL s'il n'existe pas.
+    Path* HubLabels_shortestPath(const HubLabels* labels, Graph* graph, int start, int end, ShortestPathStats* stats);
+
+#endif
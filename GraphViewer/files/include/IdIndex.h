@@ -0,0 +1,54 @@
+#ifndef IDINDEX_H
+#define IDINDEX_H
+
+    #include "Settings.h"
+
+    /// @brief Table de hachage à adressage ouvert (sondage linéaire) associant
+    /// l'identifiant d'un sommet à son indice dans le graphe.
+    /// La table ne stocke que des indices : les chaînes sont lues dans le
+    /// tableau ids du graphe, qui sert aussi d'index inverse indice -> identifiant.
+    typedef struct IdIndex
+    {
+        /// @brief Indice du sommet stocké dans chaque case, -1 si la case est vide.
+        int* slots;
+
+        /// @brief Hash de l'identifiant stocké dans chaque case.
+        uint32_t* hashes;
+
+        /// @brief Nombre de cases de la table (puissance de deux).
+        int capacity;
+
+        /// @brief Nombre d'identifiants stockés.
+        int count;
+    } IdIndex;
+
+    /// @brief Calcule le hash (FNV-1a) d'un identifiant.
+    uint32_t IdIndex_hash(const char* id);
+
+    /// @brief Reconstruit entièrement la table à partir du tableau des identifiants.
+    /// @param index la table.
+    /// @param ids tableau des identifiants des sommets.
+    /// @param count nombre de sommets.
+    void IdIndex_rebuild(IdIndex* index, char** ids, int count);
+
+    /// @brief Libère la mémoire de la table.
+    void IdIndex_free(IdIndex* index);
+
+    /// @brief Recherche un identifiant dans la table.
+    /// @return L'indice du sommet, -1 s'il n'existe pas.
+    int IdIndex_find(const IdIndex* index, char** ids, const char* id);
+
+    /// @brief Recherche un identifiant dans la table, les identifiants étant
+    /// rangés les uns après les autres dans une même zone mémoire.
+    /// @param strings les identifiants, terminés chacun par '\0'.
+    /// @param offsets position de l'identifiant de chaque sommet dans strings.
+    /// @return L'indice du sommet, -1 s'il n'existe pas.
+    int IdIndex_findPacked(const IdIndex* index, const char* strings, const int64_t* offsets, const char* id);
+
+    /// @brief Ajoute le sommet nodeIndex, dont l'identifiant est ids[nodeIndex].
+    void IdIndex_insert(IdIndex* index, char** ids, int nodeIndex);
+
+    /// @brief Retire le sommet nodeIndex, dont l'identifiant est ids[nodeIndex].
+    void IdIndex_remove(IdIndex* index, char** ids, int nodeIndex);
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef NODEORDERING_H
+#define NODEORDERING_H
+
+    #include "Settings.h"
+    #include "graph.h"
+
+    /// @brief Ordre dans lequel renuméroter les sommets d'un graphe.
+    /// Des sommets voisins qui ont des indices proches sont rangés côte à côte
+    /// dans les tableaux du graphe et des algorithmes, ce qui réduit les défauts
+    /// de cache lors des parcours sur les grands graphes.
+    typedef enum NodeOrder
+    {
+        /// @brief Ordre de découverte d'un parcours en largeur, lancé depuis
+        /// le premier sommet non visité de chaque composante.
+        NODE_ORDER_BFS = 0,
+
+        /// @brief Reverse Cuthill–McKee : parcours en largeur lancé depuis un
+        /// sommet de degré minimal de chaque composante, les voisins étant
+        /// visités par degré croissant, puis ordre inversé. Réduit la largeur
+        /// de bande de la matrice d'adjacence.
+        NODE_ORDER_RCM,
+
+        /// @brief Ordre des sommets le long d'une courbe de Hilbert tracée sur
+        /// leurs positions : des sommets proches à l'écran ont des indices proches.
+        NODE_ORDER_HILBERT
+    } NodeOrder;
+
+    /// @brief Correspondance entre les anciens et les nouveaux indices des sommets.
+    typedef struct NodePermutation
+    {
+        int count;
+
+        /// @brief Nouvel indice du sommet d'ancien indice i.
+        int* newIndices;
+
+        /// @brief Ancien indice du sommet de nouvel indice i.
+        int* oldIndices;
+    } NodePermutation;
+
+    /// @brief Calcule une renumérotation des sommets sans modifier le graphe.
+    /// Les parcours en largeur ignorent le sens des arcs (arcs sortants et
+    /// entrants) ; complexité en O(n + m), plus le tri des voisins pour
+    /// NODE_ORDER_RCM et un tri en O(n log n) pour NODE_ORDER_HILBERT.
+    /// @return La permutation, à détruire avec NodePermutation_destroy().
+    NodePermutation* Graph_computeOrder(Graph* graph, NodeOrder order);
+
+    /// @brief Renumérote les sommets du graphe dans l'ordre demandé avec
+    /// Graph_permuteNodes() : les arcs sont réécrits et les observateurs prévenus.
+    /// @return La correspondance entre anciens et nouveaux indices, à détruire
+    /// avec NodePermutation_destroy().
+    NodePermutation* Graph_renumber(Graph* graph, NodeOrder order);
+
+    void NodePermutation_destroy(NodePermutation* permutation);
+
+#endif
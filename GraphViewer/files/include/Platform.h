@@ -0,0 +1,156 @@
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+    // This header must not include Settings.h : Platform.c includes windows.h,
+    // whose declarations conflict with raylib.h.
+
+    #include <stdbool.h>
+    #include <stddef.h>
+    #include <stdint.h>
+    #include <stdio.h>
+
+    #ifdef _MSC_VER
+    #  include <intrin.h>
+    #  define PLATFORM_INLINE static __inline
+    #else
+    #  define PLATFORM_INLINE static inline
+    #endif
+
+    /// @brief PLATFORM_AVX2 est défini si le compilateur peut produire des
+    /// fonctions AVX2 sans que tout le programme le soit : elles sont précédées
+    /// de PLATFORM_AVX2_TARGET et ne doivent être appelées que si
+    /// Platform_hasAvx2() renvoie true.
+    #if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #  define PLATFORM_AVX2
+    #  define PLATFORM_AVX2_TARGET
+    #elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #  define PLATFORM_AVX2
+    #  define PLATFORM_AVX2_TARGET __attribute__((target("avx2")))
+    #endif
+
+    /// @brief Indique si le processeur et le système permettent d'exécuter des
+    /// instructions AVX2. Le test n'est fait qu'au premier appel.
+    bool Platform_hasAvx2(void);
+
+    /// @brief Tâche exécutée par Platform_parallelFor() pour l'indice index.
+    /// worker, dans [0, Platform_workerCount(count)[, identifie le thread qui
+    /// exécute la tâche : il permet d'utiliser des données propres à chaque thread.
+    typedef void (*ParallelTask)(void* context, int index, int worker);
+
+    /// @brief Renvoie le nombre de processeurs logiques de la machine.
+    int Platform_processorCount(void);
+
+    /// @brief Renvoie le nombre de threads utilisés par Platform_parallelFor()
+    /// pour count tâches.
+    int Platform_workerCount(int count);
+
+    /// @brief Exécute task(context, i, worker) pour chaque i de [0, count[ en répartissant
+    /// les indices entre au plus Platform_processorCount() threads.
+    /// La fonction rend la main une fois toutes les tâches terminées.
+    /// Les tâches ne doivent pas écrire dans des données partagées sans synchronisation.
+    void Platform_parallelFor(int count, ParallelTask task, void* context);
+
+    /// @brief Fonction exécutée par un thread créé avec Platform_startThread().
+    typedef void (*ThreadMain)(void* context);
+
+    /// @brief Thread créé par Platform_startThread().
+    typedef struct PlatformThread PlatformThread;
+
+    /// @brief Exécute main(context) sur un nouveau thread.
+    /// @return Le thread, NULL s'il n'a pas pu être créé.
+    PlatformThread* Platform_startThread(ThreadMain main, void* context);
+
+    /// @brief Attend la fin d'un thread créé avec Platform_startThread() et le libère.
+    void Platform_joinThread(PlatformThread* thread);
+
+    /// @brief Groupe de threads créés une seule fois puis réutilisés par
+    /// Platform_runPool(), pour les algorithmes qui enchaînent de nombreuses
+    /// boucles parallèles courtes.
+    typedef struct PlatformPool PlatformPool;
+
+    /// @brief Crée un groupe de workerCount threads, le thread appelant compris
+    /// : workerCount - 1 threads sont démarrés et attendent du travail.
+    /// @return Le groupe, NULL s'il n'a pas pu être créé.
+    PlatformPool* Platform_startPool(int workerCount);
+
+    /// @brief Comme Platform_parallelFor(), mais sur les threads du groupe :
+    /// worker est dans [0, workerCount[, 0 désignant le thread appelant. La
+    /// fonction sert de barrière : elle rend la main une fois que tous les
+    /// threads ont terminé leurs tâches, dont les écritures sont alors visibles.
+    void Platform_runPool(PlatformPool* pool, int count, ParallelTask task, void* context);
+
+    /// @brief Arrête les threads d'un groupe créé avec Platform_startPool() et le libère.
+    void Platform_stopPool(PlatformPool* pool);
+
+    /// @brief Ecrit sur le disque les données d'un fichier ouvert, tampon de
+    /// la bibliothèque C compris (fflush() puis fsync()).
+    /// @return true en cas de succès.
+    bool Platform_syncFile(FILE* file);
+
+    /// @brief Renvoie le nombre d'octets d'un fichier ouvert situés après la
+    /// position de lecture, 0 en cas d'erreur. Permet de vérifier les tailles
+    /// lues dans un en-tête avant de faire les allocations correspondantes.
+    uint64_t Platform_remainingBytes(FILE* file);
+
+    /// @brief Remplace atomiquement target par source : un autre processus, ou
+    /// le même après un arrêt brutal, trouve soit l'ancien fichier, soit le
+    /// nouveau, jamais un mélange des deux. Le renommage est lui aussi écrit
+    /// sur le disque avant le retour.
+    /// @return true en cas de succès.
+    bool Platform_replaceFile(const char* source, const char* target);
+
+    /// @brief Fichier projeté en mémoire par Platform_mapFile().
+    typedef struct FileMapping FileMapping;
+
+    /// @brief Projette un fichier entier en mémoire, en copie sur écriture :
+    /// les pages modifiées deviennent privées au processus et le fichier n'est
+    /// jamais modifié. Les pages sont lues à la demande lors du premier accès.
+    /// @return La projection, NULL si le fichier est absent, vide ou ne peut
+    /// pas être projeté.
+    FileMapping* Platform_mapFile(const char* fileName);
+
+    /// @brief Libère une projection créée avec Platform_mapFile().
+    void Platform_unmapFile(FileMapping* mapping);
+
+    /// @brief Renvoie l'adresse du début du fichier projeté (alignée sur une page).
+    void* FileMapping_data(const FileMapping* mapping);
+
+    /// @brief Renvoie la taille du fichier projeté en octets.
+    size_t FileMapping_size(const FileMapping* mapping);
+
+    /// @brief Lecture atomique d'un entier 64 bits.
+    PLATFORM_INLINE uint64_t Atomic_load64(volatile uint64_t* target)
+    {
+    #ifdef _MSC_VER
+        return (uint64_t)_InterlockedCompareExchange64((volatile __int64*)target, 0, 0);
+    #else
+        return __atomic_load_n(target, __ATOMIC_RELAXED);
+    #endif
+    }
+
+    /// @brief Ecriture atomique d'un entier 64 bits.
+    PLATFORM_INLINE void Atomic_store64(volatile uint64_t* target, uint64_t value)
+    {
+    #ifdef _MSC_VER
+        _InterlockedExchange64((volatile __int64*)target, (__int64)value);
+    #else
+        __atomic_store_n(target, value, __ATOMIC_RELAXED);
+    #endif
+    }
+
+    /// @brief Remplace *target par desired si *target vaut *expected.
+    /// En cas d'échec, *expected reçoit la valeur actuelle de *target.
+    /// @return true si le remplacement a eu lieu.
+    PLATFORM_INLINE bool Atomic_compareExchange64(volatile uint64_t* target, uint64_t* expected, uint64_t desired)
+    {
+    #ifdef _MSC_VER
+        uint64_t previous = (uint64_t)_InterlockedCompareExchange64((volatile __int64*)target, (__int64)desired, (__int64)*expected);
+        if (previous == *expected) return true;
+        *expected = previous;
+        return false;
+    #else
+        return __atomic_compare_exchange_n(target, expected, desired, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    #endif
+    }
+
+#endif
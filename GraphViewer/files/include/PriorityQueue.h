@@ -0,0 +1,151 @@
+#ifndef PRIORITYQUEUE_H
+#define PRIORITYQUEUE_H
+
+    #include "Settings.h"
+
+    /// @brief File de priorité min implémentée par un tas d-aire indexé.
+    /// Les éléments sont des entiers de [0, capacity[ (des indices de sommets),
+    /// ce qui permet de diminuer la clé d'un élément déjà présent dans le tas.
+    typedef struct IndexedHeap
+    {
+        /// @brief Nombre de fils de chaque noeud du tas (2 pour un tas binaire).
+        int arity;
+
+        /// @brief Nombre d'éléments dans le tas.
+        int size;
+
+        /// @brief Nombre maximal d'éléments distincts.
+        int capacity;
+
+        /// @brief Elément stocké à chaque position du tas.
+        int* heap;
+
+        /// @brief Position de chaque élément dans le tas, -1 s'il n'y est pas.
+        int* positions;
+
+        /// @brief Clé de chaque élément.
+        float* keys;
+    } IndexedHeap;
+
+    /// @brief Crée un tas vide.
+    /// @param capacity le nombre d'éléments distincts (les éléments sont dans [0, capacity[).
+    /// @param arity le nombre de fils de chaque noeud (au moins 2).
+    /// @return Le tas créé.
+    IndexedHeap* IndexedHeap_create(int capacity, int arity);
+
+    /// @brief Détruit un tas créé avec IndexedHeap_create().
+    void IndexedHeap_destroy(IndexedHeap* heap);
+
+    /// @brief Vide le tas. Le coût est proportionnel au nombre d'éléments présents.
+    void IndexedHeap_clear(IndexedHeap* heap);
+
+    INLINE bool IndexedHeap_isEmpty(IndexedHeap* heap)
+    {
+        return heap->size == 0;
+    }
+
+    INLINE bool IndexedHeap_contains(IndexedHeap* heap, int item)
+    {
+        return heap->positions[item] >= 0;
+    }
+
+    /// @brief Insère un élément ou diminue sa clé s'il est déjà présent.
+    /// Si l'élément est présent avec une clé plus petite, le tas n'est pas modifié.
+    /// @param heap le tas.
+    /// @param item l'élément.
+    /// @param key la nouvelle clé.
+    void IndexedHeap_push(IndexedHeap* heap, int item, float key);
+
+    /// @brief Renvoie la plus petite clé du tas.
+    /// L'utilisateur doit au préalable vérifier que le tas n'est pas vide.
+    INLINE float IndexedHeap_minKey(IndexedHeap* heap)
+    {
+        assert(heap->size > 0);
+        return heap->keys[heap->heap[0]];
+    }
+
+    /// @brief Supprime et renvoie l'élément de plus petite clé.
+    /// L'utilisateur doit au préalable vérifier que le tas n'est pas vide.
+    int IndexedHeap_pop(IndexedHeap* heap);
+
+    /// @brief Couple (clé entière, élément) stocké dans les files à seaux.
+    typedef struct BucketEntry
+    {
+        uint64_t key;
+        int item;
+    } BucketEntry;
+
+    /// @brief Tableau dynamique d'entrées, utilisé comme seau.
+    typedef struct Bucket
+    {
+        BucketEntry* entries;
+        int count;
+        int capacity;
+    } Bucket;
+
+    /// @brief Tas radix : file de priorité monotone sur des clés entières.
+    /// Les clés insérées ne doivent jamais être inférieures à la dernière clé
+    /// extraite, ce qui est le cas dans l'algorithme de Dijkstra.
+    /// Un élément peut être inséré plusieurs fois, c'est à l'utilisateur
+    /// d'ignorer les entrées obsolètes lors de l'extraction.
+    typedef struct RadixHeap
+    {
+        /// @brief Seau i : clés dont le bit de poids fort différent de last est le bit i - 1.
+        Bucket buckets[65];
+
+        /// @brief Dernière clé extraite.
+        uint64_t last;
+
+        /// @brief Nombre d'entrées dans le tas.
+        int size;
+    } RadixHeap;
+
+    RadixHeap* RadixHeap_create();
+    void RadixHeap_destroy(RadixHeap* heap);
+
+    INLINE bool RadixHeap_isEmpty(RadixHeap* heap)
+    {
+        return heap->size == 0;
+    }
+
+    /// @brief Insère un élément. La clé doit être supérieure ou égale à la dernière clé extraite.
+    void RadixHeap_push(RadixHeap* heap, int item, uint64_t key);
+
+    /// @brief Supprime et renvoie une entrée de plus petite clé.
+    /// L'utilisateur doit au préalable vérifier que le tas n'est pas vide.
+    BucketEntry RadixHeap_pop(RadixHeap* heap);
+
+    /// @brief File à seaux de Dial pour des poids entiers bornés par maxWeight.
+    /// Les clés présentes dans la file sont toutes dans [cursor, cursor + maxWeight],
+    /// un tableau circulaire de maxWeight + 1 seaux suffit donc.
+    /// Comme pour le tas radix, les entrées obsolètes doivent être ignorées par l'utilisateur.
+    typedef struct BucketQueue
+    {
+        Bucket* buckets;
+
+        /// @brief Nombre de seaux (maxWeight + 1).
+        int bucketCount;
+
+        /// @brief Plus petite clé pouvant encore être présente dans la file.
+        uint64_t cursor;
+
+        /// @brief Nombre d'entrées dans la file.
+        int size;
+    } BucketQueue;
+
+    BucketQueue* BucketQueue_create(int maxWeight);
+    void BucketQueue_destroy(BucketQueue* queue);
+
+    INLINE bool BucketQueue_isEmpty(BucketQueue* queue)
+    {
+        return queue->size == 0;
+    }
+
+    /// @brief Insère un élément. La clé doit être dans [cursor, cursor + maxWeight].
+    void BucketQueue_push(BucketQueue* queue, int item, uint64_t key);
+
+    /// @brief Supprime et renvoie une entrée de plus petite clé.
+    /// L'utilisateur doit au préalable vérifier que la file n'est pas vide.
+    BucketEntry BucketQueue_pop(BucketQueue* queue);
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef REACHABILITYINDEX_H
+#define REACHABILITYINDEX_H
+
+    #include "Settings.h"
+    #include "graph.h"
+
+    /// @brief Nombre d'étiquettes d'intervalle par composante (un parcours en
+    /// profondeur du graphe des composantes par étiquette).
+    #define REACHABILITY_LABELS 2
+
+    /// @brief Réponse à une question d'accessibilité.
+    typedef enum ReachabilityAnswer
+    {
+        /// @brief Il n'existe aucun chemin.
+        REACHABILITY_NO = 0,
+
+        /// @brief Il existe un chemin.
+        REACHABILITY_YES,
+
+        /// @brief L'index ne permet pas de conclure, une recherche est nécessaire.
+        REACHABILITY_MAYBE
+    } ReachabilityAnswer;
+
+    /// @brief Index permettant de rejeter en temps constant les requêtes sans chemin.
+    ///
+    /// Graphe orienté : les composantes fortement connexes sont calculées par
+    /// l'algorithme de Tarjan (version itérative). Deux sommets d'une même
+    /// composante sont mutuellement accessibles. Tarjan numérote les
+    /// composantes dans l'ordre topologique inverse du graphe des composantes
+    /// (un DAG) : u ne peut atteindre v que si comp(u) > comp(v). Chaque
+    /// composante reçoit de plus REACHABILITY_LABELS intervalles [low, post]
+    /// (méthode GRAIL) issus de parcours en profondeur du DAG dans des ordres
+    /// aléatoires : si u atteint v, l'intervalle de v est inclus dans celui de u.
+    ///
+    /// Graphe non orienté : les composantes connexes sont maintenues par une
+    /// structure union-find. Deux sommets de composantes différentes ne sont
+    /// pas reliés ; l'éditeur n'ajoutant qu'un arc par arête, deux sommets
+    /// d'une même composante donnent REACHABILITY_MAYBE.
+    ///
+    /// L'index s'enregistre comme observateur du graphe. Les modifications qui
+    /// ne peuvent pas rendre une réponse fausse sont absorbées en temps constant
+    /// (union de deux composantes, arc ajouté entre composantes déjà ordonnées,
+    /// arc supprimé entre deux composantes) ; les autres marquent l'index comme
+    /// périmé et il est recalculé en O(n + m) par la requête suivante.
+    typedef struct ReachabilityIndex
+    {
+        Graph* graph;
+        bool oriented;
+
+        /// @brief Taille allouée du tableau components.
+        int capacity;
+
+        /// @brief Graphe orienté : composante fortement connexe de chaque sommet.
+        /// Graphe non orienté : parent de chaque sommet dans la structure union-find.
+        int* components;
+        int componentsCount;
+
+        /// @brief Etiquettes de la composante c dans les cases
+        /// [c * REACHABILITY_LABELS, (c + 1) * REACHABILITY_LABELS[.
+        int* lows;
+        int* posts;
+
+        /// @brief true si l'index doit être recalculé avant la prochaine requête.
+        bool dirty;
+
+        /// @brief Nombre de calculs complets de l'index.
+        int rebuildsCount;
+    } ReachabilityIndex;
+
+    /// @brief Construit l'index d'un graphe et l'enregistre comme observateur du graphe.
+    /// @return L'index, à détruire avec ReachabilityIndex_destroy() avant le graphe.
+    ReachabilityIndex* ReachabilityIndex_create(Graph* graph);
+
+    /// @brief Retire l'index des observateurs de son graphe et le détruit.
+    void ReachabilityIndex_destroy(ReachabilityIndex* index);
+
+    /// @brief Indique s'il existe un chemin de from à to.
+    /// La réponse est en temps constant (à l'inverse d'Ackermann près pour un
+    /// graphe non orienté) sauf si l'index doit d'abord être recalculé.
+    ReachabilityAnswer ReachabilityIndex_query(ReachabilityIndex* index, int from, int to);
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef SELFTEST_H
+#define SELFTEST_H
+
+    #include "Settings.h"
+    #include "graph.h"
+
+    /// @brief Taille des graphes aléatoires vérifiés par SelfTest_run().
+    #define SELF_TEST_NODES 200
+    #define SELF_TEST_ARCS 1000
+
+    /// @brief Poids maximal des arcs du graphe aléatoire pondéré (les arcs de
+    /// poids nul sont inclus).
+    #define SELF_TEST_MAX_WEIGHT 9
+
+    /// @brief Nombre de sommets de départ et d'arrivée des requêtes vérifiées,
+    /// répartis régulièrement parmi les sommets du graphe.
+    #define SELF_TEST_SOURCES 16
+    #define SELF_TEST_TARGETS 256
+
+    /// @brief Au-delà de ce nombre de sommets, l'algorithme de Floyd-Warshall
+    /// (en O(n^3)) n'est pas vérifié.
+    #define SELF_TEST_ALL_PAIRS_MAX 2048
+
+    /// @brief Nombre de modifications aléatoires des arcs appliquées à l'arbre
+    /// des plus courts chemins dynamique.
+    #define SELF_TEST_EDITS 64
+
+    /// @brief Capacité du cache des plus courts chemins vérifié : les graphes
+    /// qui n'ont pas plus de sommets ne permettent pas de le remplir.
+    #define SELF_TEST_CACHE_CAPACITY 8
+
+    /// @brief Fichiers temporaires écrits par la vérification du journal et par
+    /// celle du format JSON, dans le dossier courant. Ils sont supprimés à la
+    /// fin du test.
+    #define SELF_TEST_FILE "selftest.gvb"
+    #define SELF_TEST_JSON_FILE "selftest.json"
+
+    /// @brief Vérifie chaque moteur sur un graphe chargé depuis un fichier et
+    /// sur trois graphes aléatoires, toujours les mêmes (l'un pondéré, un
+    /// autre dont tous les arcs pèsent 1, le dernier dont les arcs pèsent 0 ou 1) :
+    /// - Dijkstra avec chaque file de priorité, sa version entière, le parcours
+    ///   en largeur, delta-stepping, Dijkstra bidirectionnel, A* guidé par les
+    ///   coordonnées ou par des repères (ALT), Floyd-Warshall, la hiérarchie de
+    ///   contraction, les étiquettes de hubs et les lots de requêtes doivent
+    ///   donner les distances de Graph_dijkstra() ;
+    /// - les chaînes de prédécesseurs et les chemins renvoyés doivent remonter
+    ///   à la source par des arcs de plus courts chemins ;
+    /// - l'arbre des plus courts chemins dynamique doit rester exact pendant
+    ///   des modifications aléatoires des arcs ;
+    /// - le cache des plus courts chemins doit resservir une requête répétée,
+    ///   recalculer une requête après une modification du graphe et remplacer
+    ///   une entrée quand il est plein ;
+    /// - l'index d'accessibilité ne doit jamais contredire Graph_dijkstra() ;
+    /// - Kruskal et Borůvka doivent donner des forêts couvrantes de même poids,
+    ///   avec un arbre par composante connexe ;
+    /// - un graphe enregistré au format JSON puis rechargé doit être inchangé ;
+    /// - un journal réappliqué sur son instantané doit redonner le graphe modifié ;
+    /// - une renumérotation des sommets, dans chaque ordre, ne doit changer ni
+    ///   les distances, ni les sommets désignés par les identifiants, et doit
+    ///   être rejouée par le journal.
+    /// Chaque moteur est signalé sur la sortie standard comme réussi ou non.
+    /// @param fileName le fichier du graphe, NULL pour les seuls graphes aléatoires.
+    /// @return Le nombre de moteurs en échec, 0 si tout est correct.
+    int SelfTest_run(const char* fileName);
+
+#endif
@@ -4,24 +4,193 @@
     #include "Settings.h"
     #include "graph.h"
     #include "ListSTR.h"
+    #include "PriorityQueue.h"
 
     /// @brief Structure représentant un chemin dans un graphe.
+    /// Le chemin ne stocke que les indices de ses sommets : les identifiants ne
+    /// sont lus dans le graphe qu'à l'affichage ou à l'export (Path_toList()).
     typedef struct Path
     {
-        /// @brief Liste des sommets du chemin.
-        /// Le premier élément de la liste est le sommet et départ
+        /// @brief Indices des sommets du chemin.
+        /// Le premier élément du tableau est le sommet de départ
         /// et le dernier élément le sommet d'arrivée.
-        ListStr *list;
+        int* nodes;
+
+        /// @brief Nombre de sommets du chemin.
+        int length;
+
+        /// @brief Taille allouée du tableau nodes.
+        int capacity;
 
         /// @brief Longueur du chemin.
         /// Autrement dit la somme des poids des arcs qui composent le chemin.
         float distance;
     } Path;
 
+    /// @brief File de priorité utilisée par l'algorithme de Dijkstra.
+    typedef enum DijkstraQueue
+    {
+        /// @brief Tas d-aire indexé, complexité en O((n + m) log n).
+        DIJKSTRA_QUEUE_HEAP = 0,
+
+        /// @brief Recherche linéaire du prochain sommet parmi tous les sommets,
+        /// complexité en O(n^2). Adapté aux petits graphes denses.
+        DIJKSTRA_QUEUE_SCAN,
+
+        /// @brief Calcul sur des distances entières exactes avec Graph_dijkstraInt()
+        /// (file de Dial ou tas radix), les distances sont converties en float à la fin.
+        DIJKSTRA_QUEUE_BUCKET
+    } DijkstraQueue;
+
+    /// @brief Distance d'un sommet inaccessible pour Graph_dijkstraInt().
+    #define INT_DISTANCE_INFINITY INT64_MAX
+
+    /// @brief Poids maximal pour lequel Graph_dijkstraInt() utilise la file de Dial
+    /// plutôt que le tas radix.
+    #define DIAL_MAX_WEIGHT 1024
+
+    /// @brief Algorithme utilisé par Graph_shortestPath().
+    typedef enum ShortestPathMethod
+    {
+        /// @brief Algorithme de Dijkstra, voir Graph_dijkstra().
+        /// Sans options->workspace, Graph_shortestPath() le remplace par un
+        /// parcours en largeur (Graph_bfs()) si tous les arcs ont le même poids
+        /// et que la file choisie est celle par défaut (DIJKSTRA_QUEUE_HEAP).
+        SHORTEST_PATH_DIJKSTRA = 0,
+
+        /// @brief Algorithme A* guidé par les coordonnées des sommets, voir Graph_astar().
+        SHORTEST_PATH_ASTAR,
+
+        /// @brief Algorithme de Dijkstra bidirectionnel, voir Graph_bidirectionalDijkstra().
+        SHORTEST_PATH_BIDIRECTIONAL,
+
+        /// @brief Requête dans une Contraction Hierarchy prétraitée, voir
+        /// ContractionHierarchy_shortestPath(). options->hierarchy doit être renseigné.
+        SHORTEST_PATH_CH,
+
+        /// @brief Chemin reconstruit à partir des distances d'un index
+        /// d'étiquettes de hubs, voir HubLabels_shortestPath().
+        /// options->hubLabels doit être renseigné.
+        SHORTEST_PATH_HUB_LABELS
+    } ShortestPathMethod;
+
+    struct ContractionHierarchy;
+    struct AltIndex;
+    struct HubLabels;
+    struct ReachabilityIndex;
+
+    /// @brief Espace de travail réutilisable des algorithmes de Dijkstra et A*.
+    /// Il est alloué une fois par graphe et par thread : un même espace ne doit
+    /// pas servir à deux requêtes simultanées.
+    /// Chaque requête incrémente le numéro de génération ; la distance et le
+    /// prédécesseur d'un sommet ne sont valides que si son tampon est égal à la
+    /// génération courante. Seuls les sommets atteints par une requête sont
+    /// donc écrits, au lieu de réinitialiser les n cases à chaque appel.
+    typedef struct DijkstraWorkspace
+    {
+        /// @brief Nombre de sommets pour lequel les tableaux sont alloués.
+        int capacity;
+
+        /// @brief Génération de la requête courante.
+        uint32_t generation;
+
+        /// @brief Génération de la dernière écriture de chaque sommet.
+        uint32_t* stamps;
+
+        float* distances;
+        int* predecessors;
+
+        /// @brief File de priorité, vidée au début de chaque requête.
+        IndexedHeap* heap;
+    } DijkstraWorkspace;
+
+    /// @brief Crée un espace de travail dimensionné pour un graphe.
+    DijkstraWorkspace* DijkstraWorkspace_create(Graph* graph);
+
+    /// @brief Détruit un espace de travail.
+    void DijkstraWorkspace_destroy(DijkstraWorkspace* workspace);
+
+    /// @brief Commence une nouvelle requête : toutes les distances redeviennent
+    /// infinies en temps constant. Les tableaux sont agrandis si le graphe a grossi.
+    /// @param arity le nombre de fils de chaque noeud du tas.
+    void DijkstraWorkspace_reset(DijkstraWorkspace* workspace, Graph* graph, int arity);
+
+    /// @brief Renvoie la distance d'un sommet calculée par la dernière requête,
+    /// INFINITY s'il n'a pas été atteint.
+    INLINE float DijkstraWorkspace_distance(const DijkstraWorkspace* workspace, int node)
+    {
+        assert(workspace && node >= 0 && node < workspace->capacity);
+        return workspace->stamps[node] == workspace->generation ? workspace->distances[node] : INFINITY;
+    }
+
+    /// @brief Renvoie le prédécesseur d'un sommet calculé par la dernière requête,
+    /// -1 s'il n'a pas été atteint.
+    INLINE int DijkstraWorkspace_predecessor(const DijkstraWorkspace* workspace, int node)
+    {
+        assert(workspace && node >= 0 && node < workspace->capacity);
+        return workspace->stamps[node] == workspace->generation ? workspace->predecessors[node] : -1;
+    }
+
+    /// @brief Statistiques remplies par les algorithmes de plus court chemin.
+    typedef struct ShortestPathStats
+    {
+        /// @brief Nombre de sommets extraits de la file de priorité
+        /// (sommets définitivement traités).
+        int settledCount;
+    } ShortestPathStats;
+
+    /// @brief Paramètres des algorithmes de plus court chemin.
+    typedef struct ShortestPathOptions
+    {
+        /// @brief Algorithme utilisé par Graph_shortestPath().
+        ShortestPathMethod method;
+
+        /// @brief File de priorité utilisée par l'algorithme de Dijkstra.
+        DijkstraQueue queue;
+
+        /// @brief Nombre de fils de chaque noeud du tas (DIJKSTRA_QUEUE_HEAP).
+        int heapArity;
+
+        /// @brief Facteur multipliant la distance euclidienne dans l'heuristique de A*.
+        /// Une valeur négative utilise Graph_astarAdmissibleScale().
+        float heuristicScale;
+
+        /// @brief Si non NULL, A* utilise les bornes de cet index ALT comme
+        /// heuristique à la place de la distance euclidienne.
+        struct AltIndex* landmarks;
+
+        /// @brief Si non NULL, reçoit les statistiques de la recherche.
+        ShortestPathStats* stats;
+
+        /// @brief Hiérarchie du graphe utilisée par SHORTEST_PATH_CH.
+        struct ContractionHierarchy* hierarchy;
+
+        /// @brief Etiquettes de hubs du graphe utilisées par SHORTEST_PATH_HUB_LABELS.
+        struct HubLabels* hubLabels;
+
+        /// @brief Si non NULL, Dijkstra et A* travaillent dans cet espace au lieu
+        /// d'allouer et d'initialiser leurs tableaux à chaque appel.
+        DijkstraWorkspace* workspace;
+
+        /// @brief Si non NULL, Graph_shortestPath() interroge cet index avant
+        /// toute recherche et renvoie NULL immédiatement s'il n'existe pas de chemin.
+        struct ReachabilityIndex* reachability;
+    } ShortestPathOptions;
+
+    /// @brief Renvoie les paramètres par défaut (Dijkstra, tas 4-aire).
+    ShortestPathOptions ShortestPathOptions_default();
+
     /// @brief Crée un nouveau chemin.
-    /// @param start le sommet de départ du chemin.
+    /// @param start l'indice du sommet de départ du chemin.
     /// @return Le chemin créé.
-    Path* Path_create(const char* startId);
+    Path* Path_create(int start);
+
+    /// @brief Ajoute un sommet à la fin d'un chemin.
+    /// La distance du chemin n'est pas mise à jour.
+    void Path_append(Path* path, int node);
+
+    /// @brief Renvoie une copie d'un chemin, NULL si path est NULL.
+    Path* Path_copy(const Path* path);
 
     /// @brief Détruit un chemin créé avec Path_create().
     /// @param path le chemin à détruire.
@@ -29,18 +198,27 @@
 
     /// @brief Affiche un chemin.
     /// @param path le chemin.
-    void Path_print(Path *path);
+    /// @param graph le graphe dans lequel lire les identifiants des sommets.
+    void Path_print(Path *path, Graph* graph);
+
+    /// @brief Renvoie la liste des identifiants des sommets d'un chemin.
+    /// @return Une nouvelle liste, à détruire avec ListStr_destroy().
+    ListStr* Path_toList(Path* path, Graph* graph);
 
     /// @brief Renvoie un plus court chemin entre deux sommets d'un graphe.
-    /// Si aucun chemin n'existe, renvoie NULL.
+    /// Si aucun chemin n'existe, renvoie NULL. Si les deux sommets sont les
+    /// mêmes, renvoie le chemin réduit à ce sommet, quelle que soit la méthode.
     /// Cette fonction suit l'algorithme de Dijkstra.
-    /// Elle a une complexité en O(n^2) où n désigne le nombre de noeuds du graphe.
+    /// Avec la file par défaut, elle a une complexité en O((n + m) log n) où n
+    /// désigne le nombre de noeuds et m le nombre d'arcs du graphe.
     /// 
     /// @param graph le graphe.
     /// @param start l'identifiant du sommet de départ.
     /// @param end l'identifiant du sommet d'arrivée.
+    /// @param options les paramètres de l'algorithme, NULL pour les paramètres par défaut.
+    ///     Avec options->workspace, Dijkstra et A* n'allouent aucun tableau de taille n.
     /// @return Un plus court chemin en cas d'existance, NULL sinon.
-    Path* Graph_shortestPath(Graph* graph, const char* startId, const char* endId);
+    Path* Graph_shortestPath(Graph* graph, const char* startId, const char* endId, const ShortestPathOptions* options);
 
     /// @brief Effectue l'algorithme de Dijkstra.
     /// Si end >= 0, cette fonction calcule un plus court chemin entre les noeuds
@@ -60,7 +238,71 @@
     /// @param distances tableau péalablement alloué dont la taille est égale au
     ///     nombre de noeuds du graphe. Après l'appel à la fonction, il contient
     ///     pour chaque noeud sa distance avec le noeud start.
-    void Graph_dijkstra(Graph* graph, int start, int end, int* predecessors, float* distances);
+    /// @param options les paramètres de l'algorithme, NULL pour les paramètres par défaut.
+    ///     Si options->workspace est renseigné, le résultat se lit avec
+    ///     DijkstraWorkspace_distance() et DijkstraWorkspace_predecessor() ;
+    ///     predecessors et distances peuvent alors être NULL, sinon ils sont
+    ///     remplis en O(n).
+    void Graph_dijkstra(Graph* graph, int start, int end, int* predecessors, float* distances, const ShortestPathOptions* options);
+
+    /// @brief Effectue l'algorithme de Dijkstra sur des distances entières exactes.
+    /// Les poids des arcs doivent être positifs ou nuls.
+    /// Si le poids maximal (Graph_maxWeight()) est inférieur ou égal à
+    /// DIAL_MAX_WEIGHT, la frontière est une file à seaux de Dial (complexité
+    /// en O(m + D) où D est la distance maximale), sinon c'est un tas radix
+    /// (complexité en O(m + n log C) où C est le poids maximal).
+    /// Les paramètres ont le même sens que pour Graph_dijkstra().
+    /// 
+    /// @param distances tableau péalablement alloué dont la taille est égale au
+    ///     nombre de noeuds du graphe. Après l'appel à la fonction, il contient
+    ///     pour chaque noeud sa distance avec le noeud start, ou
+    ///     INT_DISTANCE_INFINITY si le noeud est inaccessible.
+    /// @return Le nombre de sommets définitivement traités.
+    int Graph_dijkstraInt(Graph* graph, int start, int end, int* predecessors, int64_t* distances);
+
+    /// @brief Effectue l'algorithme A* entre les noeuds start et end.
+    /// L'heuristique d'un noeud est sa distance euclidienne au noeud end
+    /// multipliée par options->heuristicScale.
+    /// Le chemin est optimal tant que ce facteur ne dépasse pas
+    /// Graph_astarAdmissibleScale().
+    /// Si options->landmarks est renseigné, l'heuristique est le minorant
+    /// AltIndex_lowerBound(), toujours admissible, et les sommets dont l'index
+    /// prouve qu'ils ne mènent pas à end ne sont pas explorés.
+    /// options->workspace est utilisé comme pour Graph_dijkstra(). Les tableaux predecessors et distances ont
+    /// le même sens que pour Graph_dijkstra().
+    /// 
+    /// @param graph le graphe.
+    /// @param start l'indice du sommet de départ.
+    /// @param end l'indice du sommet d'arrivée.
+    /// @param predecessors tableau des prédecesseurs.
+    /// @param distances tableau des distances.
+    /// @param options les paramètres de l'algorithme, NULL pour les paramètres par défaut.
+    void Graph_astar(Graph* graph, int start, int end, int* predecessors, float* distances, const ShortestPathOptions* options);
+
+    /// @brief Effectue l'algorithme de Dijkstra bidirectionnel entre les noeuds
+    /// start et end : une recherche part de start sur les arcs sortants, l'autre
+    /// part de end sur les arcs entrants (voir Graph_buildReverse()).
+    /// La recherche s'arrête dès que la somme des deux plus petites clés dépasse
+    /// la longueur du meilleur chemin trouvé.
+    /// En sortie, les tableaux predecessors et distances permettent de
+    /// reconstruire le chemin vers end avec Graph_dijkstraGetPath(). Les distances
+    /// des autres sommets ne sont pas forcément définitives.
+    /// 
+    /// @param graph le graphe.
+    /// @param start l'indice du sommet de départ.
+    /// @param end l'indice du sommet d'arrivée.
+    /// @param predecessors tableau des prédecesseurs.
+    /// @param distances tableau des distances.
+    /// @param options les paramètres de l'algorithme, NULL pour les paramètres par défaut.
+    void Graph_bidirectionalDijkstra(Graph* graph, int start, int end, int* predecessors, float* distances, const ShortestPathOptions* options);
+
+    /// @brief Renvoie le plus grand facteur d'échelle rendant l'heuristique de A*
+    /// admissible (et consistante), c'est-à-dire le minimum sur tous les arcs du
+    /// rapport poids / longueur euclidienne.
+    /// Le résultat est conservé jusqu'à la prochaine modification du graphe ou
+    /// au prochain déplacement d'un sommet : le calcul en O(m) n'est fait
+    /// qu'une fois (voir Graph_uniformWeight()).
+    float Graph_astarAdmissibleScale(Graph* graph);
 
     /// @brief Reconstruit un chemin à partir de la sortie de l'algorithme de
     /// Dijkstra.
@@ -71,4 +313,10 @@
     /// @return Le plus court chemin arrivant au noeud end s'il existe, NULL sinon.
     Path* Graph_dijkstraGetPath(Graph* graph, int* predecessors, float* distances, int end);
 
+    /// @brief Reconstruit le chemin vers end calculé par la dernière requête
+    /// effectuée dans un espace de travail.
+    /// @return Le plus court chemin arrivant au noeud end s'il existe, NULL sinon
+    /// (sans message, contrairement à Graph_dijkstraGetPath()).
+    Path* DijkstraWorkspace_getPath(DijkstraWorkspace* workspace, Graph* graph, int end);
+
 #endif
\ No newline at end of file
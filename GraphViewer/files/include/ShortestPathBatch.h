@@ -0,0 +1,83 @@
+#ifndef SHORTESTPATHBATCH_H
+#define SHORTESTPATHBATCH_H
+
+    #include "Settings.h"
+    #include "graph.h"
+    #include "ShortestPath.h"
+
+    /// @brief Résultat d'un lot de requêtes de plus court chemin.
+    /// Les résultats forment une matrice de rowsCount lignes et columnsCount
+    /// colonnes stockée ligne par ligne : pour une matrice de distances, la case
+    /// (i, j) correspond à la source i et à la cible j ; pour une liste de
+    /// paires, la ligne i (une seule colonne) correspond à la paire i.
+    typedef struct ShortestPathBatch
+    {
+        int rowsCount;
+        int columnsCount;
+
+        /// @brief Distance de chaque case, INFINITY s'il n'existe pas de chemin.
+        float* distances;
+
+        /// @brief Chemins compacts, NULL s'ils n'ont pas été demandés.
+        /// Les indices des sommets du chemin de la case c (du départ à l'arrivée)
+        /// occupent les cases [pathOffsets[c], pathOffsets[c + 1][ de pathNodes.
+        /// Un chemin inexistant est vide.
+        int* pathOffsets;
+        int* pathNodes;
+    } ShortestPathBatch;
+
+    /// @brief Calcule les plus courts chemins d'une liste de paires (départ, arrivée).
+    /// Les requêtes sont réparties entre plusieurs threads, chacun disposant de
+    /// son propre DijkstraWorkspace.
+    /// @param graph le graphe.
+    /// @param startIds les identifiants des sommets de départ.
+    /// @param endIds les identifiants des sommets d'arrivée.
+    /// @param count le nombre de paires.
+    /// @param withPaths true pour calculer aussi les chemins.
+    /// @param options les paramètres des recherches, NULL pour les paramètres par
+    ///     défaut. Seules les méthodes SHORTEST_PATH_DIJKSTRA et SHORTEST_PATH_ASTAR
+    ///     sont prises en charge, les autres sont remplacées par Dijkstra.
+    ///     options->workspace est ignoré ; options->stats reçoit le nombre total
+    ///     de sommets traités.
+    /// @return Les résultats, une ligne par paire.
+    ShortestPathBatch* Graph_shortestPathPairs(Graph* graph, const char* startIds[], const char* endIds[], int count, bool withPaths, const ShortestPathOptions* options);
+
+    /// @brief Calcule la matrice des distances entre des sources et des cibles.
+    /// Une seule recherche vers tous les sommets (Graph_dijkstra() avec end < 0)
+    /// est effectuée par source, les sources étant réparties entre plusieurs threads.
+    /// @param graph le graphe.
+    /// @param sourceIds les identifiants des sources.
+    /// @param sourcesCount le nombre de sources.
+    /// @param targetIds les identifiants des cibles.
+    /// @param targetsCount le nombre de cibles.
+    /// @param withPaths true pour calculer aussi les chemins.
+    /// @param options les paramètres des recherches, comme pour Graph_shortestPathPairs().
+    ///     La méthode est toujours Dijkstra.
+    /// @return Les résultats, une ligne par source et une colonne par cible.
+    ShortestPathBatch* Graph_distanceMatrix(Graph* graph, const char* sourceIds[], int sourcesCount, const char* targetIds[], int targetsCount, bool withPaths, const ShortestPathOptions* options);
+
+    /// @brief Détruit les résultats d'un lot.
+    void ShortestPathBatch_destroy(ShortestPathBatch* batch);
+
+    INLINE float ShortestPathBatch_distance(ShortestPathBatch* batch, int row, int column)
+    {
+        assert(batch && row >= 0 && row < batch->rowsCount && column >= 0 && column < batch->columnsCount);
+        return batch->distances[(size_t)row * batch->columnsCount + column];
+    }
+
+    /// @brief Renvoie le nombre de sommets du chemin d'une case, 0 s'il n'existe pas.
+    INLINE int ShortestPathBatch_pathLength(ShortestPathBatch* batch, int row, int column)
+    {
+        assert(batch && batch->pathOffsets && row >= 0 && row < batch->rowsCount && column >= 0 && column < batch->columnsCount);
+        size_t cell = (size_t)row * batch->columnsCount + column;
+        return batch->pathOffsets[cell + 1] - batch->pathOffsets[cell];
+    }
+
+    /// @brief Renvoie les indices des sommets du chemin d'une case.
+    INLINE const int* ShortestPathBatch_path(ShortestPathBatch* batch, int row, int column)
+    {
+        assert(batch && batch->pathOffsets && row >= 0 && row < batch->rowsCount && column >= 0 && column < batch->columnsCount);
+        return batch->pathNodes + batch->pathOffsets[(size_t)row * batch->columnsCount + column];
+    }
+
+#endif
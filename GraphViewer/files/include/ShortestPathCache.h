@@ -0,0 +1,82 @@
+#ifndef SHORTESTPATHCACHE_H
+#define SHORTESTPATHCACHE_H
+
+    #include "Settings.h"
+    #include "graph.h"
+    #include "ShortestPath.h"
+
+    /// @brief Résultat mémorisé d'une requête.
+    typedef struct ShortestPathCacheEntry
+    {
+        /// @brief Clé de l'entrée : sommets de départ et d'arrivée, et version
+        /// du graphe au moment du calcul (voir Graph_version()).
+        int start;
+        int end;
+        uint64_t version;
+
+        /// @brief Chemin trouvé, NULL s'il n'existe pas de chemin.
+        Path* path;
+
+        /// @brief Entrée suivante de la même case de la table de hachage, -1 si aucune.
+        int next;
+
+        /// @brief true si l'entrée contient un résultat.
+        bool used;
+
+        /// @brief true si l'entrée a servi depuis le dernier passage de l'aiguille.
+        bool referenced;
+    } ShortestPathCacheEntry;
+
+    /// @brief Cache des résultats de Graph_shortestPath(), de taille fixe.
+    /// Les entrées sont retrouvées par une table de hachage sur (départ,
+    /// arrivée, version du graphe) et remplacées selon l'algorithme CLOCK
+    /// (approximation de LRU) : l'aiguille parcourt les entrées en donnant une
+    /// seconde chance à celles qui ont servi depuis son dernier passage.
+    /// Toute modification du graphe change sa version, un résultat calculé
+    /// avant une modification ne peut donc plus être renvoyé ; les entrées
+    /// périmées sont remplacées au fil des insertions.
+    typedef struct ShortestPathCache
+    {
+        ShortestPathCacheEntry* entries;
+        int capacity;
+
+        /// @brief Première entrée de chaque case de la table de hachage, -1 si aucune.
+        int* buckets;
+        int bucketsMask;
+
+        /// @brief Position de l'aiguille de l'algorithme CLOCK.
+        int hand;
+
+        /// @brief Nombre de requêtes servies par le cache et calculées.
+        long long hitsCount;
+        long long missesCount;
+    } ShortestPathCache;
+
+    /// @brief Crée un cache vide.
+    /// @param capacity le nombre maximal de résultats mémorisés.
+    ShortestPathCache* ShortestPathCache_create(int capacity);
+
+    /// @brief Détruit un cache et tous les chemins qu'il contient.
+    void ShortestPathCache_destroy(ShortestPathCache* cache);
+
+    /// @brief Vide un cache. Les compteurs ne sont pas remis à zéro.
+    void ShortestPathCache_clear(ShortestPathCache* cache);
+
+    /// @brief Équivalent à Graph_shortestPath() en réutilisant si possible un
+    /// résultat calculé pour la même paire et la même version du graphe.
+    /// Toutes les méthodes renvoient un plus court chemin : un résultat est
+    /// réutilisé quelles que soient les options de la requête.
+    /// @param options comme pour Graph_shortestPath(). Lorsque le résultat est
+    ///     trouvé dans le cache, options->stats reçoit 0 sommet traité.
+    /// @return Un nouveau chemin, à détruire avec Path_destroy(), NULL s'il
+    ///     n'existe pas de chemin.
+    Path* ShortestPathCache_shortestPath(ShortestPathCache* cache, Graph* graph, const char* startId, const char* endId, const ShortestPathOptions* options);
+
+    /// @brief Renvoie la proportion des requêtes servies par le cache.
+    INLINE double ShortestPathCache_hitRate(const ShortestPathCache* cache)
+    {
+        long long total = cache->hitsCount + cache->missesCount;
+        return total > 0 ? (double)cache->hitsCount / total : 0.0;
+    }
+
+#endif
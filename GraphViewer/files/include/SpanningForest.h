@@ -0,0 +1,61 @@
+#ifndef SPANNINGFOREST_H
+#define SPANNINGFOREST_H
+
+    #include "Settings.h"
+    #include "graph.h"
+
+    /// @brief Nombre minimal d'arcs pour que le tri de Kruskal et les passes de
+    /// Borůvka soient répartis entre plusieurs threads.
+    #define SPANNING_PARALLEL_THRESHOLD 4096
+
+    /// @brief Arête d'un arbre couvrant.
+    typedef struct SpanningEdge
+    {
+        int from;
+        int to;
+        int weight;
+    } SpanningEdge;
+
+    /// @brief Forêt couvrante de poids minimal : un arbre couvrant minimal par
+    /// composante connexe du graphe.
+    /// Les arcs sont considérés comme des arêtes non orientées ; dans un graphe
+    /// non orienté, les deux arcs d'une même arête peuvent être présents.
+    typedef struct SpanningForest
+    {
+        /// @brief Arêtes de la forêt, nodesCount - treesCount au total.
+        SpanningEdge* edges;
+        int edgesCount;
+
+        /// @brief Nombre d'arbres de la forêt (composantes connexes du graphe).
+        int treesCount;
+
+        /// @brief Somme des poids des arêtes de la forêt.
+        int64_t totalWeight;
+    } SpanningForest;
+
+    /// @brief Calcule une forêt couvrante minimale avec l'algorithme de Kruskal.
+    /// Les arcs sont triés par poids croissant (chaque thread trie une partie
+    /// des arcs, puis les parties sont fusionnées deux à deux en parallèle) et
+    /// ajoutés s'ils relient deux arbres différents, ce que vérifie une
+    /// structure union-find avec compression des chemins.
+    /// Complexité en O(m log m).
+    /// @param graph le graphe, en principe non orienté (oriented == 0).
+    /// @return La forêt, à détruire avec SpanningForest_destroy().
+    SpanningForest* Graph_kruskal(Graph* graph);
+
+    /// @brief Calcule une forêt couvrante minimale avec l'algorithme de Borůvka.
+    /// A chaque passe, chaque arbre choisit son arc sortant de poids minimal ;
+    /// les arcs sont répartis entre plusieurs threads qui mettent à jour ce
+    /// minimum par compare-and-swap. Les arcs choisis sont ensuite ajoutés et
+    /// les arbres fusionnés. Le nombre d'arbres est au moins divisé par deux à
+    /// chaque passe, d'où une complexité en O(m log n) bien répartie entre les
+    /// threads sur les grands graphes.
+    /// Les poids égaux sont départagés par l'indice des arcs : la forêt obtenue
+    /// a le même poids que celle de Graph_kruskal().
+    /// @param graph le graphe, en principe non orienté (oriented == 0).
+    /// @return La forêt, à détruire avec SpanningForest_destroy().
+    SpanningForest* Graph_boruvka(Graph* graph);
+
+    void SpanningForest_destroy(SpanningForest* forest);
+
+#endif
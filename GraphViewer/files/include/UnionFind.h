@@ -0,0 +1,59 @@
+#ifndef UNIONFIND_H
+#define UNIONFIND_H
+
+    #include "Settings.h"
+
+    // Structure union-find stockée dans un tableau de parents :
+    // parents[i] == i si i est le représentant de son ensemble.
+
+    /// @brief Initialise count singletons.
+    INLINE void UnionFind_init(int* parents, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            parents[i] = i;
+        }
+    }
+
+    /// @brief Renvoie le représentant de l'ensemble de node, avec compression
+    /// des chemins : tous les sommets parcourus sont rattachés au représentant.
+    INLINE int UnionFind_find(int* parents, int node)
+    {
+        int root = node;
+        while (parents[root] != root)
+        {
+            root = parents[root];
+        }
+        while (parents[node] != root)
+        {
+            int next = parents[node];
+            parents[node] = root;
+            node = next;
+        }
+        return root;
+    }
+
+    /// @brief Réunit les ensembles de a et b. Le représentant est le plus petit
+    /// des deux, ce qui suffit à garder des arbres peu profonds avec la
+    /// compression des chemins.
+    /// @return false si a et b étaient déjà dans le même ensemble.
+    INLINE bool UnionFind_union(int* parents, int a, int b)
+    {
+        a = UnionFind_find(parents, a);
+        b = UnionFind_find(parents, b);
+        if (a == b)
+        {
+            return false;
+        }
+        if (a < b)
+        {
+            parents[b] = a;
+        }
+        else
+        {
+            parents[a] = b;
+        }
+        return true;
+    }
+
+#endif
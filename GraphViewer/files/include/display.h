@@ -2,9 +2,26 @@
 #define DISPLAY_H
 
 	#include "graph.h"
+	#include "ShortestPath.h"
+	#include "DynamicShortestPath.h"
+	#include "SpanningForest.h"
+	#include "AsyncSave.h"
+	#include "EditJournal.h"
 
 	void displayGraphCLI(Graph* graph);
-	void displayGraphWindow(Graph* graph);
+
+	/// @brief Ouvre la fenêtre d'édition du graphe.
+	/// La touche M affiche ou masque la forêt couvrante minimale du graphe,
+	/// recalculée après chaque modification.
+	/// La touche S enregistre les modifications dans le journal du graphe
+	/// (voir EditJournal_commit()) ; sans journal, elle enregistre tout le
+	/// graphe sur un autre thread (voir Graph_saveAsync()). Dans les deux cas,
+	/// la fenêtre continue d'être affichée et montre l'avancement de l'écriture.
+	/// @param tree un arbre de plus courts chemins dont le chemin vers le sommet
+	/// d'arrivée suivi est mis en évidence, ou NULL. Le chemin est mis à jour
+	/// après chaque modification du graphe.
+	/// @param journal le journal des modifications du graphe, ou NULL.
+	void displayGraphWindow(Graph* graph, DynamicShortestPath* tree, EditJournal* journal);
 
 	///////////////////////////////////////////
 	// 
@@ -14,25 +31,25 @@
 	///////////////////////////////////////////
 	void prepareGraphToDraw(Graph* graph, Vector2 startPoint,
 		int* pressed, int* show, Rectangle* textBox,
-		int* letterCount, char* edgeWeight, NodesList** editedEges, int* framesCounter, int* creatingNode,
-		Node** movingNode, Vector2* mouse, int* createEdge);
+		int* letterCount, char* edgeWeight, int* editedArc, int* framesCounter, int* creatingNode,
+		int* movingNode, Vector2* mouse, int* createEdge);
 
 	void getUserInput(int* show, bool* edited, Rectangle* textBox, Vector2* mouse, int* letterCount, char* editedText, int* framesCounter, bool acceptChar);
 
 
-	void manageNodeRenameEditBox(Graph* graph, Node* node, int* show, Rectangle* textBox,
-		Vector2* mouse, int* letterCount, char* editedText, int* framesCounter, bool* overNode, Node** nodeToEdit);
+	void manageNodeRenameEditBox(Graph* graph, int node, int* show, Rectangle* textBox,
+		Vector2* mouse, int* letterCount, char* editedText, int* framesCounter, bool* overNode, int* nodeToEdit);
 
-	bool checkOverEdge(bool oriented, Node* node, Vector2* mouse, NodesList** editedEges);
-	void manageEdgeWeightEditBox(Graph* graph, Node* node, int* show, Rectangle* textBox,
-		Vector2* mouse, int* letterCount, char* editedText, int* framesCounter, bool* overEdge, NodesList** editedEges);
+	bool checkOverEdge(Graph* graph, int node, Vector2* mouse, int* editedArc);
+	void manageEdgeWeightEditBox(Graph* graph, int node, int* show, Rectangle* textBox,
+		Vector2* mouse, int* letterCount, char* editedText, int* framesCounter, bool* overEdge, int* editedArc);
 
-	bool deleteNodeManagement(Vector2* mouse, Node* node, NodesList* prevNodeList, NodesList* currentNodeList, Graph* graph);
-	bool deleteEdgeManagement(Graph* graph, Node* node, Vector2* mouse, NodesList** editedEges);
+	bool deleteNodeManagement(Vector2* mouse, Graph* graph, int node);
+	bool deleteEdgeManagement(Graph* graph, int node, Vector2* mouse, int* editedArc);
 
 	void createNodeManagement(int* creatingNode, Graph* graph, Vector2* mouse);
 
-	void edgeCreationManagement(Node** nodeToMove, Vector2* mouse, int* createEdge, Graph* graph);
+	void edgeCreationManagement(int* nodeToMove, Vector2* mouse, int* createEdge, Graph* graph);
 
 	///////////////////////////////////////////
 	// 
@@ -43,10 +60,23 @@
 	void drawGraph(int show, Rectangle* textBox,
 		char* name, int letterCount, int framesCounter,
 		Vector2* currentPoint, Vector2* startPoint,
-		Graph* graph, int moveStartPoint, Node* movingNode, int pressed,
-		Vector2* mouse, int* createEdge);
+		Graph* graph, int moveStartPoint, int movingNode, int pressed,
+		Vector2* mouse, int* createEdge, Path* path, SpanningForest* forest,
+		AsyncSave* save, const char* saveMessage);
+
+	/// @brief Met en évidence les arcs d'un chemin.
+	/// Les arcs qui n'existent plus depuis le calcul du chemin sont ignorés.
+	void drawPath(Graph* graph, Path* path);
+
+	/// @brief Met en évidence les arêtes d'une forêt couvrante.
+	/// Les arêtes qui n'existent plus depuis le calcul de la forêt sont ignorées.
+	void drawSpanningForest(Graph* graph, SpanningForest* forest);
+
+	/// @brief Affiche l'avancement de l'enregistrement en cours, ou à défaut
+	/// le message message s'il n'est pas NULL.
+	void drawSaveStatus(AsyncSave* save, const char* message);
 
 	void drawEdgeWeightEditBox(int show, Rectangle* textBox, char* edgeWeight, int letterCount, int framesCounter);
-	void drawOrientedCurve(Node* node, NodesList* adjencyList, Vector2* middle);
+	void drawOrientedCurve(Vector2 from, Vector2 to, Vector2* middle);
 
 #endif // !DISPLAY_H
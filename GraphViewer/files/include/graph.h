@@ -1,48 +1,424 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
-	#include "readJson.h"
-
-	struct node {
-		char* id;
-		int data;
-		float x;
-		float y;
-		struct nodesList* adjacent;
-	};
+	#include "Settings.h"
+	#include "IdIndex.h"
+
+	struct Graph;
+	struct FileMapping;
+
+	/// @brief Extension des fichiers de graphe au format binaire (voir Graph_saveBinary()).
+	#define GRAPH_BINARY_EXTENSION ".gvb"
+
+	/// @brief Nature d'une modification du graphe signalée aux observateurs.
+	typedef enum GraphEditType {
+		GRAPH_EDIT_ADD_NODE,
+		GRAPH_EDIT_REMOVE_NODE,
+		GRAPH_EDIT_RENAME_NODE,
+		GRAPH_EDIT_ADD_ARC,
+		GRAPH_EDIT_REMOVE_ARC,
+		GRAPH_EDIT_SET_WEIGHT,
+		GRAPH_EDIT_PERMUTE_NODES,
+		GRAPH_EDIT_MOVE_NODE
+	} GraphEditType;
+
+	/// @brief Description d'une modification, transmise après qu'elle a été appliquée.
+	/// Les champs inutilisés par une modification valent -1.
+	typedef struct GraphEdit {
+		GraphEditType type;
+
+		/// @brief Sommet ajouté, supprimé, renommé ou déplacé. Après une suppression,
+		/// les sommets d'indice supérieur ont déjà été décalés d'un cran.
+		int node;
+
+		/// @brief Extrémités de l'arc ajouté, supprimé ou modifié.
+		int from;
+		int to;
 
-	struct nodesList {
-		struct node* node;
+		/// @brief Indice de l'arc ajouté ou modifié, ancien indice de l'arc supprimé.
+		int arc;
+
+		/// @brief Poids de l'arc avant et après la modification.
+		int oldWeight;
 		int weight;
-		struct nodesList* next;
-	};
 
+		/// @brief Nouvel indice de chaque sommet (GRAPH_EDIT_PERMUTE_NODES), NULL sinon.
+		const int* newIndices;
+	} GraphEdit;
+
+	/// @brief Fonction appelée après chaque modification du graphe.
+	typedef void (*GraphEditCallback)(void* context, struct Graph* graph, const GraphEdit* edit);
+
+	typedef struct GraphObserver {
+		GraphEditCallback callback;
+		void* context;
+	} GraphObserver;
+
+	/// @brief Graphe stocké au format CSR (compressed sparse row).
+	/// Les sommets sont identifiés par un indice dense dans [0, nodesCount[.
+	/// Les arcs sortants du sommet i occupent les cases
+	/// [arcOffsets[i], arcOffsets[i + 1][ des tableaux arcTargets et arcWeights.
 	struct Graph {
+		/// @brief Nombre de sommets du graphe.
 		int nodesCount;
+
+		/// @brief Nombre d'arcs du graphe.
+		int arcsCount;
+
 		int oriented;
 		char* fileName;
-		struct nodesList* nodes;
+
+		/// @brief Identifiant (chaîne de caractères) de chaque sommet.
+		/// NULL si le graphe est projeté depuis un fichier binaire.
+		char** ids;
+
+		/// @brief Fichier binaire projeté en mémoire dont proviennent les tableaux
+		/// du graphe (voir Graph_loadBinary()), NULL si les tableaux sont alloués
+		/// sur le tas. Les identifiants sont alors lus dans idStrings, le sommet i
+		/// ayant l'identifiant idStrings + idOffsets[i].
+		struct FileMapping* mapping;
+		const char* idStrings;
+		const int64_t* idOffsets;
+
+		/// @brief true si saveGraph() enregistre le graphe au format binaire.
+		bool binaryFile;
+
+		/// @brief Identifiant du dernier fichier binaire écrit par Graph_saveAs()
+		/// ou lu au chargement, 0 pour un fichier JSON, qui n'en contient pas.
+		/// Chaque enregistrement choisit un nouvel identifiant : deux fichiers de
+		/// contenus différents n'ont jamais le même. Le journal des modifications
+		/// s'en sert pour reconnaître son instantané sans relire le fichier.
+		uint64_t snapshotId;
+
+		/// @brief Index identifiant -> indice, maintenu à jour par les fonctions d'édition.
+		IdIndex idIndex;
+
+		/// @brief Coordonnées de chaque sommet dans la fenêtre.
+		Vector2* positions;
+
+		/// @brief Tableau de taille nodesCount + 1 donnant le premier arc de chaque sommet.
+		int* arcOffsets;
+
+		/// @brief Indice du sommet d'arrivée de chaque arc.
+		int* arcTargets;
+
+		/// @brief Poids de chaque arc.
+		int* arcWeights;
+
+		/// @brief Capacités allouées pour les tableaux de sommets et d'arcs.
+		int nodesCapacity;
+		int arcsCapacity;
+
+		/// @brief Arcs entrants au format CSR, construits à la demande par
+		/// Graph_buildReverse(). Une fois construits, ils sont tenus à jour par
+		/// l'ajout, la suppression et le changement de poids d'un arc, et
+		/// invalidés par les autres fonctions d'édition.
+		/// Les arcs entrants du sommet i occupent les cases
+		/// [reverseOffsets[i], reverseOffsets[i + 1][ de reverseSources et reverseWeights.
+		int* reverseOffsets;
+		int* reverseSources;
+		int* reverseWeights;
+		bool reverseValid;
+
+		/// @brief Observateurs prévenus de chaque modification faite par les
+		/// fonctions d'édition.
+		GraphObserver* observers;
+		int observersCount;
+
+		/// @brief Version du contenu du graphe, changée par le chargement et par
+		/// chaque modification faite par les fonctions d'édition, sauf le
+		/// déplacement d'un sommet : aucun calcul mis en cache ne dépend des coordonnées.
+		/// Les versions sont uniques pour tous les graphes du programme : deux
+		/// états différents (même de deux graphes différents) n'ont jamais la
+		/// même version.
+		uint64_t version;
+
+		/// @brief Résultat de Graph_uniformWeight() et version du graphe pour
+		/// laquelle il a été calculé.
+		int uniformWeight;
+		uint64_t uniformWeightVersion;
+
+		/// @brief Résultat de Graph_maxWeight() et version du graphe pour
+		/// laquelle il a été calculé.
+		int maxWeight;
+		uint64_t maxWeightVersion;
+
+		/// @brief Résultat de Graph_fingerprint() et version du graphe pour
+		/// laquelle il a été calculé.
+		uint64_t fingerprint;
+		uint64_t fingerprintVersion;
+
+		/// @brief Résultat de Graph_astarAdmissibleScale() et version du graphe
+		/// pour laquelle il a été calculé. Comme il dépend des coordonnées, le
+		/// déplacement d'un sommet l'invalide aussi.
+		float astarScale;
+		uint64_t astarScaleVersion;
 	};
 
-	typedef struct node Node;
-	typedef struct nodesList NodesList;
 	typedef struct Graph Graph;
 
+	/// @brief Crée un graphe vide, sans fichier associé.
+	/// @param oriented indique si le graphe est orienté.
+	/// @return Le graphe, à détruire avec Graph_destroy().
+	Graph* Graph_create(bool oriented);
 
-	Graph* createGraph(typed(json_array)* nodesIdArray, const typed(json_element) jsonContent, const char* fileName);
+	/// @brief Charge un graphe au format JSON. Le fichier est lu en flux par
+	/// json_stream_parse() : les sommets et les arcs sont ajoutés au graphe
+	/// au fil de la lecture, sans construire le document en mémoire, si bien que
+	/// la mémoire utilisée ne dépend que de la taille du graphe. Le tableau
+	/// "nodesIds" doit donc précéder les objets des sommets.
+	/// @return Le graphe, NULL si le fichier est absent ou invalide.
 	Graph* jsonCreateGraphFromFile(const char* jsonFile);
-	void createAdjacentList(Graph* graph, NodesList* adj, char* adjacents[], long adjacentsWeight[], int nbElements);
 
-	void graph_destroy();
+	/// @brief Détruit un graphe et libère toute sa mémoire.
+	/// @param graph le graphe.
+	void Graph_destroy(Graph* graph);
 
+	/// @brief Enregistre le graphe dans son fichier : au format JSON, ou au
+	/// format binaire s'il a été chargé avec Graph_loadBinary().
+	/// Voir Graph_saveAs().
 	void saveGraph(Graph* graph);
 
+	/// @brief Enregistre le graphe dans un fichier sans jamais laisser de
+	/// fichier incomplet : le graphe est écrit dans fileName.tmp, forcé sur le
+	/// disque, puis ce fichier remplace fileName d'un seul coup (voir
+	/// Platform_replaceFile()). Un arrêt brutal pendant l'écriture laisse
+	/// l'ancien fichier intact.
+	/// Si le graphe est projeté depuis fileName, ses tableaux sont d'abord
+	/// recopiés sur le tas puisque le fichier est remplacé.
+	/// Un fichier binaire reçoit un nouvel identifiant, rangé dans
+	/// graph->snapshotId en cas de succès (0 pour un fichier JSON). Peut être
+	/// appelée sur plusieurs threads à la fois, pour des graphes différents.
+	/// @param binary true pour le format binaire, false pour le format JSON.
+	/// @param progress si non NULL, reçoit au fur et à mesure le nombre de
+	/// sommets écrits (lecture avec Atomic_load64()), nodesCount en cas de succès.
+	/// @return true en cas de succès.
+	bool Graph_saveAs(Graph* graph, const char* fileName, bool binary, volatile uint64_t* progress);
+
+	/// @brief Comme Graph_saveAs(), mais un fichier binaire reçoit l'identifiant
+	/// donné, qui peut ainsi être connu avant l'écriture (voir
+	/// Graph_newSnapshotId()). Il est ignoré pour un fichier JSON.
+	bool Graph_saveAsSnapshot(Graph* graph, const char* fileName, bool binary, uint64_t snapshotId, volatile uint64_t* progress);
+
+	/// @brief Renvoie un nouvel identifiant de fichier, non nul. Le premier est
+	/// tiré de l'heure et de l'adresse du programme, les suivants en sont
+	/// incrémentés : les identifiants sont uniques dans le programme et, avec une
+	/// très forte probabilité, d'une exécution à l'autre.
+	uint64_t Graph_newSnapshotId(void);
+
+	/// @brief Enregistre le graphe au format binaire (voir Graph_saveAs()).
+	/// Le fichier contient un en-tête versionné suivi des tableaux du graphe
+	/// tels qu'ils sont en mémoire (CSR, poids, coordonnées, table des
+	/// identifiants et table de hachage de l'index), chacun aligné sur 8 octets,
+	/// afin que Graph_loadBinary() puisse les utiliser sans les recopier.
+	/// @return true en cas de succès.
+	bool Graph_saveBinary(Graph* graph, const char* fileName);
+
+	/// @brief Copie le contenu du graphe (identifiants, coordonnées, arcs,
+	/// fichier et format d'enregistrement) afin de l'enregistrer sur un autre
+	/// thread pendant que le graphe continue d'être modifié. La copie ne
+	/// partage aucune mémoire avec le graphe et n'a pas d'observateur.
+	/// Un graphe projeté est d'abord recopié sur le tas, puisque son fichier
+	/// va être remplacé.
+	/// @return La copie, à détruire avec Graph_destroy().
+	Graph* Graph_snapshot(Graph* graph);
+
+	/// @brief Charge un graphe enregistré avec Graph_saveBinary() en projetant
+	/// le fichier en mémoire (voir Platform_mapFile()) : les tableaux du graphe
+	/// pointent directement dans le fichier, sans être recopiés. Le chargement
+	/// lit le fichier une seule fois pour vérifier son contenu (arcs vers des
+	/// sommets du graphe, identifiants et table de hachage), en O(n + m).
+	/// Les fonctions d'édition qui changent la taille des tableaux ou les
+	/// identifiants les recopient d'abord sur le tas, une seule fois.
+	/// @return Le graphe, NULL si le fichier est absent ou invalide.
+	Graph* Graph_loadBinary(const char* fileName);
+
+	/// @brief Convertit un graphe au format JSON en un fichier binaire.
+	/// @return true en cas de succès.
+	bool Graph_convertJsonToBinary(const char* jsonFile, const char* binaryFile);
+
+	/// @brief Charge un graphe au format binaire si le nom du fichier se termine
+	/// par GRAPH_BINARY_EXTENSION, au format JSON sinon.
+	/// @return Le graphe, NULL si le fichier est absent ou invalide.
+	Graph* Graph_loadFile(const char* fileName);
+
 	INLINE int Graph_size(Graph* graph)
 	{
 		assert(graph);
 		return graph->nodesCount;
 	}
-	
-	NodesList* Graph_getArcList(Graph* graph, int nodeIndex);
 
-#endif
\ No newline at end of file
+	INLINE int Graph_arcCount(Graph* graph)
+	{
+		assert(graph);
+		return graph->arcsCount;
+	}
+
+	/// @brief Renvoie la version du contenu du graphe (voir Graph::version).
+	INLINE uint64_t Graph_version(Graph* graph)
+	{
+		assert(graph);
+		return graph->version;
+	}
+
+	/// @brief Renvoie l'identifiant d'un sommet.
+	/// La chaîne appartient au graphe et ne doit pas être libérée.
+	INLINE const char* Graph_getNodeId(Graph* graph, int nodeIndex)
+	{
+		assert(graph && nodeIndex >= 0 && nodeIndex < graph->nodesCount);
+		if (graph->mapping != NULL)
+			return graph->idStrings + graph->idOffsets[nodeIndex];
+		return graph->ids[nodeIndex];
+	}
+
+	INLINE Vector2 Graph_getNodePosition(Graph* graph, int nodeIndex)
+	{
+		assert(graph && nodeIndex >= 0 && nodeIndex < graph->nodesCount);
+		return graph->positions[nodeIndex];
+	}
+
+	INLINE void Graph_setNodePosition(Graph* graph, int nodeIndex, Vector2 position)
+	{
+		assert(graph && nodeIndex >= 0 && nodeIndex < graph->nodesCount);
+		graph->positions[nodeIndex] = position;
+	}
+
+	/// @brief Renvoie l'indice du premier arc sortant d'un sommet.
+	/// Les arcs sortants de nodeIndex sont les arcs a tels que
+	/// Graph_arcBegin(graph, nodeIndex) <= a < Graph_arcEnd(graph, nodeIndex).
+	INLINE int Graph_arcBegin(Graph* graph, int nodeIndex)
+	{
+		assert(graph && nodeIndex >= 0 && nodeIndex < graph->nodesCount);
+		return graph->arcOffsets[nodeIndex];
+	}
+
+	/// @brief Renvoie l'indice suivant le dernier arc sortant d'un sommet.
+	INLINE int Graph_arcEnd(Graph* graph, int nodeIndex)
+	{
+		assert(graph && nodeIndex >= 0 && nodeIndex < graph->nodesCount);
+		return graph->arcOffsets[nodeIndex + 1];
+	}
+
+	INLINE int Graph_arcTarget(Graph* graph, int arc)
+	{
+		assert(graph && arc >= 0 && arc < graph->arcsCount);
+		return graph->arcTargets[arc];
+	}
+
+	INLINE int Graph_arcWeight(Graph* graph, int arc)
+	{
+		assert(graph && arc >= 0 && arc < graph->arcsCount);
+		return graph->arcWeights[arc];
+	}
+
+	/// @brief Construit (si nécessaire) les arcs entrants de chaque sommet.
+	/// Cette fonction doit être appelée avant Graph_inArcBegin() et les suivantes.
+	/// Sa complexité est en O(n + m) après une modification des sommets du
+	/// graphe, O(1) sinon.
+	void Graph_buildReverse(Graph* graph);
+
+	INLINE int Graph_inArcBegin(Graph* graph, int nodeIndex)
+	{
+		assert(graph && graph->reverseValid && nodeIndex >= 0 && nodeIndex < graph->nodesCount);
+		return graph->reverseOffsets[nodeIndex];
+	}
+
+	INLINE int Graph_inArcEnd(Graph* graph, int nodeIndex)
+	{
+		assert(graph && graph->reverseValid && nodeIndex >= 0 && nodeIndex < graph->nodesCount);
+		return graph->reverseOffsets[nodeIndex + 1];
+	}
+
+	INLINE int Graph_inArcSource(Graph* graph, int inArc)
+	{
+		assert(graph && graph->reverseValid && inArc >= 0 && inArc < graph->arcsCount);
+		return graph->reverseSources[inArc];
+	}
+
+	INLINE int Graph_inArcWeight(Graph* graph, int inArc)
+	{
+		assert(graph && graph->reverseValid && inArc >= 0 && inArc < graph->arcsCount);
+		return graph->reverseWeights[inArc];
+	}
+
+	/// @brief Renvoie le poids commun à tous les arcs du graphe, -1 si les arcs
+	/// n'ont pas tous le même poids ou si le graphe n'a pas d'arc.
+	/// Le résultat est conservé jusqu'à la prochaine modification du graphe :
+	/// le calcul en O(m) n'est fait qu'une fois par version.
+	int Graph_uniformWeight(Graph* graph);
+
+	/// @brief Renvoie le plus grand poids des arcs du graphe, 0 s'il n'a pas
+	/// d'arc. Comme Graph_uniformWeight(), le calcul en O(m) n'est fait qu'une
+	/// fois par version.
+	int Graph_maxWeight(Graph* graph);
+
+	/// @brief Renvoie une empreinte (hash FNV-1a) du contenu du graphe : ordre
+	/// des identifiants, orientation et tableaux CSR des arcs, poids compris.
+	/// Les coordonnées n'en font pas partie. Les index enregistrés à côté du
+	/// graphe la conservent pour ne pas être rechargés sur un autre contenu.
+	/// Comme Graph_uniformWeight(), le calcul en O(n + m) n'est fait qu'une
+	/// fois par version.
+	uint64_t Graph_fingerprint(Graph* graph);
+
+	/// @brief Renvoie le sommet de départ d'un arc.
+	/// Cette fonction effectue une recherche dichotomique dans arcOffsets.
+	int Graph_arcSource(Graph* graph, int arc);
+
+	/// @brief Renvoie l'indice d'un sommet à partir de son identifiant.
+	/// La recherche se fait en temps constant (en moyenne) grâce à l'index haché.
+	/// @return L'indice du sommet, -1 s'il n'existe pas.
+	int Graph_getNodeIndex(Graph* graph, const char* nodeId);
+
+	/// @brief Renvoie l'indice de l'arc from -> to, -1 s'il n'existe pas.
+	int Graph_findArc(Graph* graph, int from, int to);
+
+	/// @brief Enregistre une fonction appelée après chaque modification du graphe
+	/// faite par les fonctions d'édition ci-dessous.
+	/// Les observateurs sont appelés dans leur ordre d'enregistrement.
+	void Graph_addObserver(Graph* graph, GraphEditCallback callback, void* context);
+
+	/// @brief Retire un observateur enregistré avec Graph_addObserver().
+	void Graph_removeObserver(Graph* graph, GraphEditCallback callback, void* context);
+
+	///////////////////////////////////////////
+	//
+	//Graph edition functions
+	//Every modification of the graph made by the editor goes through these functions
+	//
+	///////////////////////////////////////////
+
+	/// @brief Ajoute un sommet sans arc au graphe.
+	/// @return L'indice du nouveau sommet.
+	int Graph_addNode(Graph* graph, const char* nodeId, Vector2 position);
+
+	/// @brief Déplace un sommet à la demande de l'utilisateur. Contrairement à
+	/// Graph_setNodePosition(), les observateurs sont prévenus si la position change.
+	void Graph_moveNode(Graph* graph, int nodeIndex, Vector2 position);
+
+	/// @brief Supprime un sommet et tous les arcs qui lui sont incidents.
+	/// Les sommets d'indice supérieur à nodeIndex sont décalés d'un cran.
+	void Graph_removeNode(Graph* graph, int nodeIndex);
+
+	/// @brief Change l'identifiant d'un sommet.
+	/// @return false si l'identifiant est déjà utilisé par un autre sommet.
+	bool Graph_renameNode(Graph* graph, int nodeIndex, const char* nodeId);
+
+	/// @brief Ajoute l'arc from -> to à la fin des arcs sortants de from.
+	/// @return L'indice du nouvel arc.
+	int Graph_addArc(Graph* graph, int from, int to, int weight);
+
+	/// @brief Supprime un arc. Les indices des arcs suivants sont décalés d'un cran.
+	void Graph_removeArc(Graph* graph, int arc);
+
+	void Graph_setArcWeight(Graph* graph, int arc, int weight);
+
+	/// @brief Renumérote les sommets : le sommet d'indice i prend l'indice
+	/// newIndices[i]. Les identifiants ne changent pas ; les tableaux des sommets
+	/// et des arcs sont réécrits dans le nouvel ordre.
+	/// Les données indexées par sommet conservées hors du graphe (index ALT ou
+	/// hiérarchie de contraction enregistrés dans un fichier, par exemple)
+	/// doivent être recalculées ; les observateurs reçoivent newIndices.
+	/// @param newIndices une permutation de [0, nodesCount[.
+	void Graph_permuteNodes(Graph* graph, const int* newIndices);
+
+#endif
@@ -0,0 +1,196 @@
+#include "AllPairs.h"
+#include "Platform.h"
+
+#ifdef PLATFORM_AVX2
+#  include <immintrin.h>
+#endif
+
+typedef struct AllPairsTask {
+    AllPairs* allPairs;
+    int blocksCount;
+    int block;
+} AllPairsTask;
+
+#ifdef PLATFORM_AVX2
+/// @brief Version AVX2 de AllPairs_relaxTile(), par blocs de 8 colonnes.
+PLATFORM_AVX2_TARGET static void AllPairs_relaxTileAvx2(AllPairs* allPairs, int row, int column, int k) {
+    size_t stride = allPairs->stride;
+    float* distances = allPairs->distances;
+    int* nextHops = allPairs->nextHops;
+
+    size_t rowBegin = (size_t)row * ALL_PAIRS_BLOCK;
+    size_t columnBegin = (size_t)column * ALL_PAIRS_BLOCK;
+    size_t kBegin = (size_t)k * ALL_PAIRS_BLOCK;
+
+    for (size_t kk = kBegin; kk < kBegin + ALL_PAIRS_BLOCK; kk++) {
+        const float* kRow = distances + kk * stride + columnBegin;
+
+        for (size_t i = rowBegin; i < rowBegin + ALL_PAIRS_BLOCK; i++) {
+            float throughK = distances[i * stride + kk];
+            if (isinf(throughK)) continue;
+
+            float* iRow = distances + i * stride + columnBegin;
+            int* iHops = nextHops + i * stride + columnBegin;
+            __m256 base = _mm256_set1_ps(throughK);
+            __m256i hops = _mm256_set1_epi32(nextHops[i * stride + kk]);
+            for (int j = 0; j < ALL_PAIRS_BLOCK; j += 8) {
+                __m256 current = _mm256_loadu_ps(iRow + j);
+                __m256 candidate = _mm256_add_ps(base, _mm256_loadu_ps(kRow + j));
+                __m256 better = _mm256_cmp_ps(candidate, current, _CMP_LT_OQ);
+                if (_mm256_movemask_ps(better) == 0) continue;
+
+                _mm256_storeu_ps(iRow + j, _mm256_blendv_ps(current, candidate, better));
+                __m256i currentHops = _mm256_loadu_si256((const __m256i*)(iHops + j));
+                __m256i newHops = _mm256_blendv_epi8(currentHops, hops, _mm256_castps_si256(better));
+                _mm256_storeu_si256((__m256i*)(iHops + j), newHops);
+            }
+        }
+    }
+}
+#endif
+
+/// @brief Relâche la tuile (row, column) par les sommets du bloc k :
+/// d[i][j] = min(d[i][j], d[i][kk] + d[kk][j]) pour kk dans le bloc k.
+/// La tuile peut être la tuile (row, k) ou (k, column) elle-même : kk étant
+/// la boucle extérieure, c'est l'ordre de l'algorithme de Floyd-Warshall.
+static void AllPairs_relaxTile(AllPairs* allPairs, int row, int column, int k) {
+#ifdef PLATFORM_AVX2
+    if (Platform_hasAvx2()) {
+        AllPairs_relaxTileAvx2(allPairs, row, column, k);
+        return;
+    }
+#endif
+
+    size_t stride = allPairs->stride;
+    float* distances = allPairs->distances;
+    int* nextHops = allPairs->nextHops;
+
+    size_t rowBegin = (size_t)row * ALL_PAIRS_BLOCK;
+    size_t columnBegin = (size_t)column * ALL_PAIRS_BLOCK;
+    size_t kBegin = (size_t)k * ALL_PAIRS_BLOCK;
+
+    for (size_t kk = kBegin; kk < kBegin + ALL_PAIRS_BLOCK; kk++) {
+        const float* kRow = distances + kk * stride + columnBegin;
+
+        for (size_t i = rowBegin; i < rowBegin + ALL_PAIRS_BLOCK; i++) {
+            float throughK = distances[i * stride + kk];
+            if (isinf(throughK)) continue;
+
+            int hop = nextHops[i * stride + kk];
+            float* iRow = distances + i * stride + columnBegin;
+            int* iHops = nextHops + i * stride + columnBegin;
+            for (int j = 0; j < ALL_PAIRS_BLOCK; j++) {
+                float candidate = throughK + kRow[j];
+                if (candidate < iRow[j]) {
+                    iRow[j] = candidate;
+                    iHops[j] = hop;
+                }
+            }
+        }
+    }
+}
+
+/// @brief Etape 2 : tuiles de la ligne et de la colonne du bloc courant.
+static void AllPairs_crossTask(void* context, int index, int worker) {
+    (void)worker;
+    AllPairsTask* task = (AllPairsTask*)context;
+    int k = task->block;
+
+    // Indices [0, blocksCount - 1[ are the row tiles, the next ones the column tiles
+    int other = index % (task->blocksCount - 1);
+    if (other >= k) other++;
+
+    if (index < task->blocksCount - 1) {
+        AllPairs_relaxTile(task->allPairs, k, other, k);
+    } else {
+        AllPairs_relaxTile(task->allPairs, other, k, k);
+    }
+}
+
+/// @brief Etape 3 : toutes les tuiles hors de la ligne et de la colonne du bloc courant.
+static void AllPairs_restTask(void* context, int index, int worker) {
+    (void)worker;
+    AllPairsTask* task = (AllPairsTask*)context;
+    int k = task->block;
+    int others = task->blocksCount - 1;
+
+    int row = index / others;
+    int column = index % others;
+    if (row >= k) row++;
+    if (column >= k) column++;
+
+    AllPairs_relaxTile(task->allPairs, row, column, k);
+}
+
+AllPairs* Graph_allPairs(Graph* graph) {
+    assert(graph);
+
+    int size = Graph_size(graph);
+    int blocksCount = maxInt((size + ALL_PAIRS_BLOCK - 1) / ALL_PAIRS_BLOCK, 1);
+
+    AllPairs* allPairs = (AllPairs*)calloc(1, sizeof(AllPairs));
+    AssertNew(allPairs);
+    allPairs->nodesCount = size;
+    allPairs->stride = blocksCount * ALL_PAIRS_BLOCK;
+
+    size_t cells = (size_t)allPairs->stride * allPairs->stride;
+    allPairs->distances = (float*)malloc(cells * sizeof(float));
+    AssertNew(allPairs->distances);
+    allPairs->nextHops = (int*)malloc(cells * sizeof(int));
+    AssertNew(allPairs->nextHops);
+
+    // Padding nodes are isolated, they change nothing
+    for (size_t cell = 0; cell < cells; cell++) {
+        allPairs->distances[cell] = INFINITY;
+        allPairs->nextHops[cell] = -1;
+    }
+    for (int u = 0; u < size; u++) {
+        size_t rowOffset = (size_t)u * allPairs->stride;
+        allPairs->distances[rowOffset + u] = 0.0f;
+        allPairs->nextHops[rowOffset + u] = u;
+
+        int arcEnd = Graph_arcEnd(graph, u);
+        for (int arc = Graph_arcBegin(graph, u); arc < arcEnd; arc++) {
+            int v = Graph_arcTarget(graph, arc);
+            float weight = (float)Graph_arcWeight(graph, arc);
+            if (weight < allPairs->distances[rowOffset + v]) {
+                allPairs->distances[rowOffset + v] = weight;
+                allPairs->nextHops[rowOffset + v] = v;
+            }
+        }
+    }
+
+    AllPairsTask task = { allPairs, blocksCount, 0 };
+    for (int k = 0; k < blocksCount; k++) {
+        task.block = k;
+
+        AllPairs_relaxTile(allPairs, k, k, k);
+        if (blocksCount > 1) {
+            Platform_parallelFor(2 * (blocksCount - 1), AllPairs_crossTask, &task);
+            Platform_parallelFor((blocksCount - 1) * (blocksCount - 1), AllPairs_restTask, &task);
+        }
+    }
+
+    return allPairs;
+}
+
+void AllPairs_destroy(AllPairs* allPairs) {
+    if (allPairs == NULL) return;
+
+    free(allPairs->distances);
+    free(allPairs->nextHops);
+    free(allPairs);
+}
+
+Path* AllPairs_getPath(const AllPairs* allPairs, int from, int to) {
+    if (AllPairs_nextHop(allPairs, from, to) < 0) {
+        return NULL;
+    }
+
+    Path* path = Path_create(from);
+    for (int node = from; node != to; node = AllPairs_nextHop(allPairs, node, to)) {
+        Path_append(path, AllPairs_nextHop(allPairs, node, to));
+    }
+    path->distance = AllPairs_distance(allPairs, from, to);
+    return path;
+}
@@ -0,0 +1,386 @@
+#include "AltIndex.h"
+#include "PriorityQueue.h"
+#include "Platform.h"
+
+#include <limits.h>
+
+#define ALT_FILE_MAGIC 0x4C414756u // "GVAL"
+#define ALT_FILE_VERSION 2
+
+/// @brief Dijkstra complet depuis source, sur les arcs sortants ou entrants.
+/// Si order n'est pas NULL, il reçoit les sommets dans l'ordre où ils sont traités.
+/// @return Le nombre de sommets traités.
+static int AltIndex_dijkstra(Graph* graph, int source, bool backward, float* distances, int* predecessors, int* order) {
+    int size = Graph_size(graph);
+    for (int i = 0; i < size; i++) {
+        distances[i] = INFINITY;
+        if (predecessors != NULL) {
+            predecessors[i] = -1;
+        }
+    }
+    distances[source] = 0.0f;
+
+    IndexedHeap* heap = IndexedHeap_create(size, 4);
+    IndexedHeap_push(heap, source, 0.0f);
+
+    int settled = 0;
+    while (!IndexedHeap_isEmpty(heap)) {
+        int currID = IndexedHeap_pop(heap);
+        if (order != NULL) {
+            order[settled] = currID;
+        }
+        settled++;
+
+        int arcBegin = backward ? Graph_inArcBegin(graph, currID) : Graph_arcBegin(graph, currID);
+        int arcEnd = backward ? Graph_inArcEnd(graph, currID) : Graph_arcEnd(graph, currID);
+        for (int arc = arcBegin; arc < arcEnd; arc++) {
+            int nextID = backward ? Graph_inArcSource(graph, arc) : Graph_arcTarget(graph, arc);
+            int weight = backward ? Graph_inArcWeight(graph, arc) : Graph_arcWeight(graph, arc);
+
+            float dist = distances[currID] + weight;
+            if (distances[nextID] > dist) {
+                distances[nextID] = dist;
+                if (predecessors != NULL) {
+                    predecessors[nextID] = currID;
+                }
+                IndexedHeap_push(heap, nextID, dist);
+            }
+        }
+    }
+    IndexedHeap_destroy(heap);
+    return settled;
+}
+
+/// @brief Travail partagé par les deux recherches d'un nouveau repère.
+typedef struct AltTableTask {
+    Graph* graph;
+    int landmark;
+
+    /// @brief Distances depuis le repère (indice 0) et vers le repère (indice 1).
+    float* distances[2];
+} AltTableTask;
+
+static void AltIndex_tableTask(void* context, int index, int worker) {
+    (void)worker;
+    AltTableTask* task = (AltTableTask*)context;
+    AltIndex_dijkstra(task->graph, task->landmark, index == 1, task->distances[index], NULL, NULL);
+}
+
+/// @brief Ajoute un repère : calcule en parallèle ses deux tables puis les
+/// recopie dans les lignes de chaque sommet.
+static void AltIndex_addLandmark(AltIndex* alt, Graph* graph, int landmark, int capacity, float* scratch[2]) {
+    AltTableTask task = { graph, landmark, { scratch[0], scratch[1] } };
+    Platform_parallelFor(2, AltIndex_tableTask, &task);
+
+    int i = alt->landmarksCount++;
+    alt->landmarks[i] = landmark;
+    for (int v = 0; v < alt->nodesCount; v++) {
+        alt->fromLandmark[(size_t)v * capacity + i] = scratch[0][v];
+        alt->toLandmark[(size_t)v * capacity + i] = scratch[1][v];
+    }
+}
+
+/// @brief Distance (dans un sens ou dans l'autre) du sommet v au repère le plus proche.
+static float AltIndex_landmarkDistance(AltIndex* alt, int v, int capacity) {
+    float distance = INFINITY;
+    for (int i = 0; i < alt->landmarksCount; i++) {
+        distance = fminf(distance, alt->fromLandmark[(size_t)v * capacity + i]);
+        distance = fminf(distance, alt->toLandmark[(size_t)v * capacity + i]);
+    }
+    return distance;
+}
+
+static int AltIndex_farthest(AltIndex* alt, bool* isLandmark, int capacity) {
+    // Unreachable nodes come first, so that every component gets a landmark
+    int best = -1;
+    float bestDistance = -1.0f;
+    for (int v = 0; v < alt->nodesCount; v++) {
+        if (isLandmark[v]) continue;
+
+        float distance = AltIndex_landmarkDistance(alt, v, capacity);
+        if (distance > bestDistance) {
+            bestDistance = distance;
+            best = v;
+        }
+    }
+    return best;
+}
+
+/// @brief Tableaux de travail de la stratégie "avoid".
+typedef struct AltAvoidState {
+    float* distances;
+    int* predecessors;
+    int* order;
+    double* sizes;
+    bool* holdsLandmark;
+} AltAvoidState;
+
+/// @brief Stratégie "avoid" : voir ALT_LANDMARKS_AVOID.
+/// @return Le nouveau repère, -1 si aucun sous-arbre ne convient.
+static int AltIndex_avoid(AltIndex* alt, Graph* graph, bool* isLandmark, int capacity, int root, AltAvoidState* state) {
+    int settled = AltIndex_dijkstra(graph, root, false, state->distances, state->predecessors, state->order);
+
+    // The weight of a node is the error of the current bound on d(root, v),
+    // the size of a subtree is the sum of its weights, or zero when the
+    // subtree already holds a landmark. Children are settled after their
+    // parent, so the reverse order visits every subtree bottom-up
+    int k = alt->landmarksCount;
+    for (int i = settled - 1; i >= 0; i--) {
+        int v = state->order[i];
+
+        float bound = 0.0f;
+        for (int j = 0; j < k; j++) {
+            float fromRoot = alt->fromLandmark[(size_t)root * capacity + j];
+            float fromV = alt->fromLandmark[(size_t)v * capacity + j];
+            float toRoot = alt->toLandmark[(size_t)root * capacity + j];
+            float toV = alt->toLandmark[(size_t)v * capacity + j];
+            if (!isinf(fromRoot) && !isinf(fromV)) bound = fmaxf(bound, fromV - fromRoot);
+            if (!isinf(toRoot) && !isinf(toV)) bound = fmaxf(bound, toRoot - toV);
+        }
+
+        state->holdsLandmark[v] = state->holdsLandmark[v] || isLandmark[v];
+        state->sizes[v] = state->holdsLandmark[v] ? 0.0 : state->sizes[v] + fmax(0.0, state->distances[v] - bound);
+
+        if (i > 0) {
+            int parent = state->predecessors[v];
+            state->holdsLandmark[parent] = state->holdsLandmark[parent] || state->holdsLandmark[v];
+            state->sizes[parent] += state->sizes[v];
+        }
+    }
+
+    // Walk down from the root, following the largest subtree
+    int landmark = -1;
+    if (state->sizes[root] > 0.0) {
+        int v = root;
+        while (true) {
+            int next = -1;
+            int arcEnd = Graph_arcEnd(graph, v);
+            for (int arc = Graph_arcBegin(graph, v); arc < arcEnd; arc++) {
+                int child = Graph_arcTarget(graph, arc);
+                if (state->predecessors[child] == v && state->sizes[child] > 0.0
+                    && (next < 0 || state->sizes[child] > state->sizes[next])) {
+                    next = child;
+                }
+            }
+            if (next < 0) break;
+            v = next;
+        }
+        landmark = v;
+    }
+
+    for (int i = 0; i < settled; i++) {
+        state->sizes[state->order[i]] = 0.0;
+        state->holdsLandmark[state->order[i]] = false;
+    }
+    return landmark;
+}
+
+AltIndex* AltIndex_build(Graph* graph, int landmarksCount, AltLandmarkStrategy strategy) {
+    assert(landmarksCount >= 0);
+
+    int n = Graph_size(graph);
+    int capacity = minInt(landmarksCount, n);
+    int allocated = n > 0 ? n : 1;
+
+    AltIndex* alt = (AltIndex*)calloc(1, sizeof(AltIndex));
+    AssertNew(alt);
+    alt->nodesCount = n;
+    alt->graphArcsCount = Graph_arcCount(graph);
+    alt->graphFingerprint = Graph_fingerprint(graph);
+    alt->landmarks = (int*)malloc((capacity > 0 ? capacity : 1) * sizeof(int));
+    AssertNew(alt->landmarks);
+    alt->fromLandmark = (float*)malloc(((size_t)allocated * capacity + 1) * sizeof(float));
+    AssertNew(alt->fromLandmark);
+    alt->toLandmark = (float*)malloc(((size_t)allocated * capacity + 1) * sizeof(float));
+    AssertNew(alt->toLandmark);
+
+    // The backward searches read the incoming arcs from several threads,
+    // they must be built beforehand
+    Graph_buildReverse(graph);
+
+    float* scratch[2];
+    scratch[0] = (float*)malloc(allocated * sizeof(float));
+    AssertNew(scratch[0]);
+    scratch[1] = (float*)malloc(allocated * sizeof(float));
+    AssertNew(scratch[1]);
+    bool* isLandmark = (bool*)calloc(allocated, sizeof(bool));
+    AssertNew(isLandmark);
+
+    AltAvoidState avoid = { 0 };
+    if (strategy == ALT_LANDMARKS_AVOID) {
+        avoid.distances = scratch[0];
+        avoid.predecessors = (int*)malloc(allocated * sizeof(int));
+        AssertNew(avoid.predecessors);
+        avoid.order = (int*)malloc(allocated * sizeof(int));
+        AssertNew(avoid.order);
+        avoid.sizes = (double*)calloc(allocated, sizeof(double));
+        AssertNew(avoid.sizes);
+        avoid.holdsLandmark = (bool*)calloc(allocated, sizeof(bool));
+        AssertNew(avoid.holdsLandmark);
+    }
+
+    // Fixed seed, so that the same graph always gives the same index
+    uint32_t seed = 2463534242u;
+
+    while (alt->landmarksCount < capacity) {
+        int landmark = -1;
+        if (alt->landmarksCount == 0) {
+            // Farthest node from the first one
+            AltIndex_dijkstra(graph, 0, false, scratch[0], NULL, NULL);
+            float bestDistance = -1.0f;
+            for (int v = 0; v < n; v++) {
+                if (!isinf(scratch[0][v]) && scratch[0][v] > bestDistance) {
+                    bestDistance = scratch[0][v];
+                    landmark = v;
+                }
+            }
+        } else if (strategy == ALT_LANDMARKS_AVOID) {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            int root = (int)(seed % (uint32_t)n);
+            landmark = AltIndex_avoid(alt, graph, isLandmark, capacity, root, &avoid);
+        }
+        if (landmark < 0) {
+            landmark = AltIndex_farthest(alt, isLandmark, capacity);
+        }
+
+        isLandmark[landmark] = true;
+        AltIndex_addLandmark(alt, graph, landmark, capacity, scratch);
+    }
+
+    free(scratch[0]);
+    free(scratch[1]);
+    free(isLandmark);
+    free(avoid.predecessors);
+    free(avoid.order);
+    free(avoid.sizes);
+    free(avoid.holdsLandmark);
+
+    return alt;
+}
+
+void AltIndex_destroy(AltIndex* alt) {
+    if (alt == NULL) return;
+
+    free(alt->landmarks);
+    free(alt->fromLandmark);
+    free(alt->toLandmark);
+    free(alt);
+}
+
+bool AltIndex_matches(AltIndex* alt, Graph* graph) {
+    return alt->nodesCount == Graph_size(graph) && alt->graphArcsCount == Graph_arcCount(graph)
+        && alt->graphFingerprint == Graph_fingerprint(graph);
+}
+
+bool AltIndex_save(AltIndex* alt, const char* fileName) {
+    FILE* file = fopen(fileName, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening file %s\n", fileName);
+        return false;
+    }
+
+    size_t tableSize = (size_t)alt->nodesCount * alt->landmarksCount;
+    uint32_t header[5] = {
+        ALT_FILE_MAGIC, ALT_FILE_VERSION,
+        (uint32_t)alt->nodesCount, (uint32_t)alt->graphArcsCount, (uint32_t)alt->landmarksCount
+    };
+    bool ok = fwrite(header, sizeof(header), 1, file) == 1;
+    ok = ok && fwrite(&alt->graphFingerprint, sizeof(uint64_t), 1, file) == 1;
+    ok = ok && fwrite(alt->landmarks, sizeof(int), alt->landmarksCount, file) == (size_t)alt->landmarksCount;
+    ok = ok && fwrite(alt->fromLandmark, sizeof(float), tableSize, file) == tableSize;
+    ok = ok && fwrite(alt->toLandmark, sizeof(float), tableSize, file) == tableSize;
+
+    fclose(file);
+    if (!ok) {
+        fprintf(stderr, "Error writing file %s\n", fileName);
+    }
+    return ok;
+}
+
+AltIndex* AltIndex_load(const char* fileName) {
+    FILE* file = fopen(fileName, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    uint32_t header[5];
+    uint64_t fingerprint;
+    if (fread(header, sizeof(header), 1, file) != 1 || fread(&fingerprint, sizeof(fingerprint), 1, file) != 1
+        || header[0] != ALT_FILE_MAGIC || header[1] != ALT_FILE_VERSION
+        || header[2] > INT_MAX || header[3] > INT_MAX || header[4] > header[2]) {
+        fprintf(stderr, "Invalid landmark file %s\n", fileName);
+        fclose(file);
+        return NULL;
+    }
+
+    // The sizes of the header are checked against the file before the tables are allocated
+    uint64_t remaining = Platform_remainingBytes(file);
+    uint64_t landmarksSize = (uint64_t)header[4] * sizeof(int);
+    uint64_t tablesSize = (uint64_t)header[2] * header[4];
+    if (remaining < landmarksSize || (remaining - landmarksSize) / (2 * sizeof(float)) < tablesSize) {
+        fprintf(stderr, "Truncated landmark file %s\n", fileName);
+        fclose(file);
+        return NULL;
+    }
+
+    AltIndex* alt = (AltIndex*)calloc(1, sizeof(AltIndex));
+    AssertNew(alt);
+    alt->nodesCount = (int)header[2];
+    alt->graphArcsCount = (int)header[3];
+    alt->landmarksCount = (int)header[4];
+    alt->graphFingerprint = fingerprint;
+
+    size_t tableSize = (size_t)alt->nodesCount * alt->landmarksCount;
+    alt->landmarks = (int*)malloc((alt->landmarksCount > 0 ? alt->landmarksCount : 1) * sizeof(int));
+    AssertNew(alt->landmarks);
+    alt->fromLandmark = (float*)malloc((tableSize + 1) * sizeof(float));
+    AssertNew(alt->fromLandmark);
+    alt->toLandmark = (float*)malloc((tableSize + 1) * sizeof(float));
+    AssertNew(alt->toLandmark);
+
+    bool ok = fread(alt->landmarks, sizeof(int), alt->landmarksCount, file) == (size_t)alt->landmarksCount;
+    ok = ok && fread(alt->fromLandmark, sizeof(float), tableSize, file) == tableSize;
+    ok = ok && fread(alt->toLandmark, sizeof(float), tableSize, file) == tableSize;
+    fclose(file);
+
+    if (!ok) {
+        fprintf(stderr, "Truncated landmark file %s\n", fileName);
+        AltIndex_destroy(alt);
+        return NULL;
+    }
+
+    // The landmarks index the tables of the graph
+    for (int i = 0; i < alt->landmarksCount; i++) {
+        if (alt->landmarks[i] < 0 || alt->landmarks[i] >= alt->nodesCount) {
+            fprintf(stderr, "Invalid landmark file %s\n", fileName);
+            AltIndex_destroy(alt);
+            return NULL;
+        }
+    }
+    return alt;
+}
+
+AltIndex* AltIndex_loadOrBuild(Graph* graph, const char* fileName, int landmarksCount, AltLandmarkStrategy strategy) {
+    // By default, the tables are kept next to the graph file
+    char* defaultName = NULL;
+    if (fileName == NULL) {
+        assert(graph->fileName);
+        size_t length = strlen(graph->fileName);
+        defaultName = (char*)malloc(length + sizeof(ALT_FILE_EXTENSION));
+        AssertNew(defaultName);
+        memcpy(defaultName, graph->fileName, length);
+        memcpy(defaultName + length, ALT_FILE_EXTENSION, sizeof(ALT_FILE_EXTENSION));
+        fileName = defaultName;
+    }
+
+    AltIndex* alt = AltIndex_load(fileName);
+    if (alt == NULL || !AltIndex_matches(alt, graph) || alt->landmarksCount != minInt(landmarksCount, Graph_size(graph))) {
+        AltIndex_destroy(alt);
+        alt = AltIndex_build(graph, landmarksCount, strategy);
+        AltIndex_save(alt, fileName);
+    }
+    free(defaultName);
+    return alt;
+}
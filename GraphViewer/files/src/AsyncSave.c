@@ -0,0 +1,52 @@
+#include "AsyncSave.h"
+#include "Platform.h"
+
+static void AsyncSave_run(void* context) {
+    AsyncSave* save = (AsyncSave*)context;
+    Graph* snapshot = save->snapshot;
+
+    save->ok = Graph_saveAs(snapshot, snapshot->fileName, snapshot->binaryFile, &save->progress);
+    Atomic_store64(&save->done, 1);
+}
+
+AsyncSave* Graph_saveAsync(Graph* graph) {
+    assert(graph);
+
+    AsyncSave* save = (AsyncSave*)calloc(1, sizeof(AsyncSave));
+    AssertNew(save);
+    save->snapshot = Graph_snapshot(graph);
+
+    save->thread = Platform_startThread(AsyncSave_run, save);
+    if (save->thread == NULL) {
+        // Without a thread, the save still happens, on the calling thread
+        AsyncSave_run(save);
+    }
+    return save;
+}
+
+bool AsyncSave_isDone(AsyncSave* save) {
+    assert(save);
+    return Atomic_load64(&save->done) != 0;
+}
+
+float AsyncSave_progress(AsyncSave* save) {
+    assert(save);
+
+    int nodesCount = Graph_size(save->snapshot);
+    if (nodesCount == 0) return AsyncSave_isDone(save) ? 1.0f : 0.0f;
+
+    float progress = (float)Atomic_load64(&save->progress) / (float)nodesCount;
+    return progress < 1.0f ? progress : 1.0f;
+}
+
+bool AsyncSave_finish(AsyncSave* save) {
+    if (save == NULL) return false;
+
+    // Joining the thread makes its writes, ok included, visible here
+    Platform_joinThread(save->thread);
+    bool ok = save->ok;
+
+    Graph_destroy(save->snapshot);
+    free(save);
+    return ok;
+}
@@ -0,0 +1,139 @@
+#include "BreadthFirstSearch.h"
+
+#ifdef _MSC_VER
+#  include <intrin.h>
+#endif
+
+/// @brief Renvoie l'indice du bit de poids faible de x, qui doit être non nul.
+static int lowestBit(uint64_t x) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return (int)index;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+INLINE bool Bitmap_get(const uint64_t* bitmap, int index) {
+    return (bitmap[index >> 6] >> (index & 63)) & 1;
+}
+
+INLINE void Bitmap_set(uint64_t* bitmap, int index) {
+    bitmap[index >> 6] |= (uint64_t)1 << (index & 63);
+}
+
+static long long Bfs_outArcs(Graph* graph, const int* nodes, int count) {
+    long long arcs = 0;
+    for (int i = 0; i < count; i++) {
+        arcs += Graph_arcEnd(graph, nodes[i]) - Graph_arcBegin(graph, nodes[i]);
+    }
+    return arcs;
+}
+
+void Graph_bfs(Graph* graph, int start, int end, int* predecessors, float* distances, int weight, ShortestPathStats* stats) {
+    int size = Graph_size(graph);
+    assert(start >= 0 && start < size && weight >= 0);
+
+    for (int i = 0; i < size; i++) {
+        predecessors[i] = -1;
+        distances[i] = INFINITY;
+    }
+
+    int words = (size + 63) / 64;
+    uint64_t* visited = (uint64_t*)calloc(words, sizeof(uint64_t));
+    AssertNew(visited);
+    uint64_t* frontierBits = (uint64_t*)calloc(words, sizeof(uint64_t));
+    AssertNew(frontierBits);
+    int* frontier = (int*)malloc(size * sizeof(int));
+    AssertNew(frontier);
+    int* next = (int*)malloc(size * sizeof(int));
+    AssertNew(next);
+
+    distances[start] = 0.0f;
+    Bitmap_set(visited, start);
+    frontier[0] = start;
+    int frontierCount = 1;
+    int visitedCount = 1;
+
+    long long unexploredArcs = Graph_arcCount(graph) - Bfs_outArcs(graph, frontier, 1);
+    bool bottomUp = false;
+
+    for (int level = 1; frontierCount > 0; level++) {
+        if (end >= 0 && Bitmap_get(visited, end)) break;
+
+        if (!bottomUp) {
+            bottomUp = Bfs_outArcs(graph, frontier, frontierCount) > unexploredArcs / BFS_ALPHA;
+        } else {
+            bottomUp = frontierCount >= size / BFS_BETA;
+        }
+
+        float distance = (float)level * weight;
+        int nextCount = 0;
+
+        if (bottomUp) {
+            Graph_buildReverse(graph);
+            memset(frontierBits, 0, words * sizeof(uint64_t));
+            for (int i = 0; i < frontierCount; i++) {
+                Bitmap_set(frontierBits, frontier[i]);
+            }
+
+            // Nodes found during this level are marked afterwards so that they
+            // are not mistaken for frontier nodes
+            for (int word = 0; word < words; word++) {
+                uint64_t unvisited = ~visited[word];
+                while (unvisited != 0) {
+                    int node = word * 64 + lowestBit(unvisited);
+                    unvisited &= unvisited - 1;
+
+                    if (node >= size) break;
+
+                    int inArcEnd = Graph_inArcEnd(graph, node);
+                    for (int inArc = Graph_inArcBegin(graph, node); inArc < inArcEnd; inArc++) {
+                        int parent = Graph_inArcSource(graph, inArc);
+                        if (Bitmap_get(frontierBits, parent)) {
+                            predecessors[node] = parent;
+                            distances[node] = distance;
+                            next[nextCount++] = node;
+                            break;
+                        }
+                    }
+                }
+            }
+            for (int i = 0; i < nextCount; i++) {
+                Bitmap_set(visited, next[i]);
+            }
+        } else {
+            for (int i = 0; i < frontierCount; i++) {
+                int currID = frontier[i];
+                int arcEnd = Graph_arcEnd(graph, currID);
+                for (int arc = Graph_arcBegin(graph, currID); arc < arcEnd; arc++) {
+                    int nextID = Graph_arcTarget(graph, arc);
+                    if (!Bitmap_get(visited, nextID)) {
+                        Bitmap_set(visited, nextID);
+                        predecessors[nextID] = currID;
+                        distances[nextID] = distance;
+                        next[nextCount++] = nextID;
+                    }
+                }
+            }
+        }
+
+        unexploredArcs -= Bfs_outArcs(graph, next, nextCount);
+        visitedCount += nextCount;
+
+        int* swap = frontier;
+        frontier = next;
+        next = swap;
+        frontierCount = nextCount;
+    }
+
+    if (stats != NULL) {
+        stats->settledCount = visitedCount;
+    }
+
+    free(visited);
+    free(frontierBits);
+    free(frontier);
+    free(next);
+}
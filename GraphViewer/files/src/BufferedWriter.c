@@ -0,0 +1,86 @@
+#include "BufferedWriter.h"
+
+void BufferedWriter_init(BufferedWriter* writer, FILE* file, size_t capacity) {
+    assert(writer && file);
+
+    writer->file = file;
+    writer->capacity = capacity > 0 ? capacity : BUFFERED_WRITER_CAPACITY;
+    writer->buffer = (char*)malloc(writer->capacity);
+    AssertNew(writer->buffer);
+    writer->length = 0;
+    writer->written = 0;
+    writer->failed = false;
+}
+
+void BufferedWriter_flush(BufferedWriter* writer) {
+    if (writer->length == 0) return;
+
+    if (!writer->failed && fwrite(writer->buffer, 1, writer->length, writer->file) != writer->length) {
+        writer->failed = true;
+    }
+    writer->written += writer->length;
+    writer->length = 0;
+}
+
+bool BufferedWriter_finish(BufferedWriter* writer) {
+    BufferedWriter_flush(writer);
+    free(writer->buffer);
+    writer->buffer = NULL;
+    writer->capacity = 0;
+    return !writer->failed;
+}
+
+void BufferedWriter_write(BufferedWriter* writer, const void* data, size_t size) {
+    const char* bytes = (const char*)data;
+    while (size > 0) {
+        if (writer->length == writer->capacity) {
+            BufferedWriter_flush(writer);
+        }
+        size_t chunk = writer->capacity - writer->length;
+        chunk = chunk < size ? chunk : size;
+        memcpy(writer->buffer + writer->length, bytes, chunk);
+        writer->length += chunk;
+        bytes += chunk;
+        size -= chunk;
+    }
+}
+
+/// @brief Ajoute les chiffres d'un entier non signé.
+static void BufferedWriter_writeDigits(BufferedWriter* writer, uint64_t value) {
+    char digits[20];
+    int count = 0;
+    do {
+        digits[sizeof(digits) - 1 - count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    BufferedWriter_write(writer, digits + sizeof(digits) - count, count);
+}
+
+void BufferedWriter_writeInt(BufferedWriter* writer, int value) {
+    if (value < 0) {
+        BufferedWriter_writeChar(writer, '-');
+    }
+    // Through int64_t, INT_MIN has a positive opposite
+    BufferedWriter_writeDigits(writer, (uint64_t)(value < 0 ? -(int64_t)value : value));
+}
+
+void BufferedWriter_writeFloat1(BufferedWriter* writer, float value) {
+    // A float has 24 significant bits : 10 * value is exact in a double, and
+    // rint() rounds it to nearest-even like printf does with the exact value
+    double tenths = rint(fabs((double)value) * 10.0);
+    if (!(tenths < 1e18)) {
+        // Infinity, NaN and huge values are left to printf
+        char text[64];
+        int length = snprintf(text, sizeof(text), "%.1f", value);
+        BufferedWriter_write(writer, text, length > 0 ? (size_t)length : 0);
+        return;
+    }
+
+    if (signbit(value)) {
+        BufferedWriter_writeChar(writer, '-');
+    }
+    uint64_t digits = (uint64_t)tenths;
+    BufferedWriter_writeDigits(writer, digits / 10);
+    BufferedWriter_writeChar(writer, '.');
+    BufferedWriter_writeChar(writer, (char)('0' + digits % 10));
+}
@@ -0,0 +1,625 @@
+#include "ContractionHierarchy.h"
+#include "Platform.h"
+
+#include <limits.h>
+
+/// @brief Nombre maximal de sommets traités par une recherche de témoin.
+/// Au-delà, le raccourci est ajouté même s'il est peut-être inutile.
+#define CH_WITNESS_SETTLE_LIMIT 500
+
+#define CH_FILE_MAGIC 0x48435647u // "GVCH"
+#define CH_FILE_VERSION 2
+
+/// @brief Liste dynamique d'indices d'arcs, utilisée pendant la contraction.
+typedef struct ChAdjacency {
+    int* arcs;
+    int count;
+    int capacity;
+} ChAdjacency;
+
+/// @brief Etat du prétraitement.
+typedef struct ChBuilder {
+    int nodesCount;
+
+    ChArc* arcs;
+    int arcsCount;
+    int arcsCapacity;
+
+    ChAdjacency* out;
+    ChAdjacency* in;
+    bool* contracted;
+    int* contractedNeighbors;
+
+    // Witness search
+    float* distances;
+    int* touched;
+    int touchedCount;
+    IndexedHeap* heap;
+} ChBuilder;
+
+static void ChAdjacency_push(ChAdjacency* adjacency, int arc) {
+    if (adjacency->count == adjacency->capacity) {
+        adjacency->capacity = adjacency->capacity > 0 ? 2 * adjacency->capacity : 4;
+        adjacency->arcs = (int*)realloc(adjacency->arcs, adjacency->capacity * sizeof(int));
+        AssertNew(adjacency->arcs);
+    }
+    adjacency->arcs[adjacency->count++] = arc;
+}
+
+static int ChBuilder_addArc(ChBuilder* builder, int from, int to, float weight, int firstChild, int secondChild) {
+    if (builder->arcsCount == builder->arcsCapacity) {
+        builder->arcsCapacity = builder->arcsCapacity > 0 ? 2 * builder->arcsCapacity : 16;
+        builder->arcs = (ChArc*)realloc(builder->arcs, builder->arcsCapacity * sizeof(ChArc));
+        AssertNew(builder->arcs);
+    }
+
+    int arc = builder->arcsCount++;
+    ChArc* chArc = &builder->arcs[arc];
+    chArc->from = from;
+    chArc->to = to;
+    chArc->weight = weight;
+    chArc->firstChild = firstChild;
+    chArc->secondChild = secondChild;
+
+    ChAdjacency_push(&builder->out[from], arc);
+    ChAdjacency_push(&builder->in[to], arc);
+    return arc;
+}
+
+/// @brief Dijkstra limité depuis source dans le graphe des sommets non
+/// contractés privé de avoid. Les distances obtenues sont des majorants.
+static void ChBuilder_witnessSearch(ChBuilder* builder, int source, int avoid, float maxDistance) {
+    for (int i = 0; i < builder->touchedCount; i++) {
+        builder->distances[builder->touched[i]] = INFINITY;
+    }
+    builder->touchedCount = 0;
+    IndexedHeap_clear(builder->heap);
+
+    builder->distances[source] = 0.0f;
+    builder->touched[builder->touchedCount++] = source;
+    IndexedHeap_push(builder->heap, source, 0.0f);
+
+    int settled = 0;
+    while (!IndexedHeap_isEmpty(builder->heap) && settled < CH_WITNESS_SETTLE_LIMIT) {
+        if (IndexedHeap_minKey(builder->heap) > maxDistance) {
+            break;
+        }
+        int currID = IndexedHeap_pop(builder->heap);
+        settled++;
+
+        ChAdjacency* out = &builder->out[currID];
+        for (int i = 0; i < out->count; i++) {
+            ChArc* arc = &builder->arcs[out->arcs[i]];
+            int nextID = arc->to;
+            if (nextID == avoid || builder->contracted[nextID]) {
+                continue;
+            }
+
+            float dist = builder->distances[currID] + arc->weight;
+            if (dist < builder->distances[nextID]) {
+                if (isinf(builder->distances[nextID])) {
+                    builder->touched[builder->touchedCount++] = nextID;
+                }
+                builder->distances[nextID] = dist;
+                IndexedHeap_push(builder->heap, nextID, dist);
+            }
+        }
+    }
+}
+
+/// @brief Compte (et ajoute si apply est vrai) les raccourcis nécessaires à la
+/// contraction du sommet node.
+static int ChBuilder_contract(ChBuilder* builder, int node, bool apply) {
+    ChAdjacency* in = &builder->in[node];
+    ChAdjacency* out = &builder->out[node];
+
+    float maxOut = 0.0f;
+    for (int j = 0; j < out->count; j++) {
+        ChArc* arc = &builder->arcs[out->arcs[j]];
+        if (!builder->contracted[arc->to] && arc->to != node) {
+            maxOut = fmaxf(maxOut, arc->weight);
+        }
+    }
+
+    int shortcuts = 0;
+    for (int i = 0; i < in->count; i++) {
+        int inArc = in->arcs[i];
+        int from = builder->arcs[inArc].from;
+        float inWeight = builder->arcs[inArc].weight;
+        if (builder->contracted[from] || from == node) {
+            continue;
+        }
+
+        ChBuilder_witnessSearch(builder, from, node, inWeight + maxOut);
+
+        for (int j = 0; j < out->count; j++) {
+            int outArc = out->arcs[j];
+            int to = builder->arcs[outArc].to;
+            if (builder->contracted[to] || to == node || to == from) {
+                continue;
+            }
+
+            float length = inWeight + builder->arcs[outArc].weight;
+            if (builder->distances[to] > length) {
+                shortcuts++;
+                if (apply) {
+                    ChBuilder_addArc(builder, from, to, length, inArc, outArc);
+                    // The shortcut is a witness for the next pairs
+                    if (isinf(builder->distances[to])) {
+                        builder->touched[builder->touchedCount++] = to;
+                    }
+                    builder->distances[to] = length;
+                }
+            }
+        }
+    }
+    return shortcuts;
+}
+
+static float ChBuilder_priority(ChBuilder* builder, int node) {
+    int degree = 0;
+    for (int i = 0; i < builder->in[node].count; i++) {
+        degree += !builder->contracted[builder->arcs[builder->in[node].arcs[i]].from];
+    }
+    for (int i = 0; i < builder->out[node].count; i++) {
+        degree += !builder->contracted[builder->arcs[builder->out[node].arcs[i]].to];
+    }
+
+    // Edge difference plus the number of already contracted neighbors,
+    // which spreads the contraction uniformly over the graph
+    int edgeDifference = ChBuilder_contract(builder, node, false) - degree;
+    return (float)(edgeDifference + builder->contractedNeighbors[node]);
+}
+
+/// @brief Range les arcs en CSR montant / descendant et alloue l'état des requêtes.
+static void ContractionHierarchy_finalize(ContractionHierarchy* ch) {
+    int n = ch->nodesCount;
+
+    ch->upOffsets = (int*)calloc(n + 1, sizeof(int));
+    AssertNew(ch->upOffsets);
+    ch->downOffsets = (int*)calloc(n + 1, sizeof(int));
+    AssertNew(ch->downOffsets);
+    ch->upArcs = (int*)malloc((ch->arcsCount > 0 ? ch->arcsCount : 1) * sizeof(int));
+    AssertNew(ch->upArcs);
+    ch->downArcs = (int*)malloc((ch->arcsCount > 0 ? ch->arcsCount : 1) * sizeof(int));
+    AssertNew(ch->downArcs);
+
+    for (int a = 0; a < ch->arcsCount; a++) {
+        ChArc* arc = &ch->arcs[a];
+        if (ch->rank[arc->to] > ch->rank[arc->from]) {
+            ch->upOffsets[arc->from + 1]++;
+        } else {
+            ch->downOffsets[arc->to + 1]++;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        ch->upOffsets[i + 1] += ch->upOffsets[i];
+        ch->downOffsets[i + 1] += ch->downOffsets[i];
+    }
+
+    int* upNext = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    AssertNew(upNext);
+    int* downNext = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    AssertNew(downNext);
+    memcpy(upNext, ch->upOffsets, n * sizeof(int));
+    memcpy(downNext, ch->downOffsets, n * sizeof(int));
+
+    for (int a = 0; a < ch->arcsCount; a++) {
+        ChArc* arc = &ch->arcs[a];
+        if (ch->rank[arc->to] > ch->rank[arc->from]) {
+            ch->upArcs[upNext[arc->from]++] = a;
+        } else {
+            ch->downArcs[downNext[arc->to]++] = a;
+        }
+    }
+    free(upNext);
+    free(downNext);
+
+    int allocated = n > 0 ? n : 1;
+    ch->forwardDistances = (float*)malloc(allocated * sizeof(float));
+    AssertNew(ch->forwardDistances);
+    ch->backwardDistances = (float*)malloc(allocated * sizeof(float));
+    AssertNew(ch->backwardDistances);
+    ch->forwardParents = (int*)malloc(allocated * sizeof(int));
+    AssertNew(ch->forwardParents);
+    ch->backwardParents = (int*)malloc(allocated * sizeof(int));
+    AssertNew(ch->backwardParents);
+    ch->touched = (int*)malloc(allocated * sizeof(int));
+    AssertNew(ch->touched);
+
+    for (int i = 0; i < n; i++) {
+        ch->forwardDistances[i] = INFINITY;
+        ch->backwardDistances[i] = INFINITY;
+        ch->forwardParents[i] = -1;
+        ch->backwardParents[i] = -1;
+    }
+    ch->touchedCount = 0;
+    ch->forwardHeap = IndexedHeap_create(n, 4);
+    ch->backwardHeap = IndexedHeap_create(n, 4);
+}
+
+ContractionHierarchy* ContractionHierarchy_build(Graph* graph) {
+    int n = Graph_size(graph);
+    int allocated = n > 0 ? n : 1;
+
+    ChBuilder builder = { 0 };
+    builder.nodesCount = n;
+    builder.out = (ChAdjacency*)calloc(allocated, sizeof(ChAdjacency));
+    AssertNew(builder.out);
+    builder.in = (ChAdjacency*)calloc(allocated, sizeof(ChAdjacency));
+    AssertNew(builder.in);
+    builder.contracted = (bool*)calloc(allocated, sizeof(bool));
+    AssertNew(builder.contracted);
+    builder.contractedNeighbors = (int*)calloc(allocated, sizeof(int));
+    AssertNew(builder.contractedNeighbors);
+    builder.distances = (float*)malloc(allocated * sizeof(float));
+    AssertNew(builder.distances);
+    builder.touched = (int*)malloc(allocated * sizeof(int));
+    AssertNew(builder.touched);
+    builder.heap = IndexedHeap_create(n, 4);
+
+    for (int i = 0; i < n; i++) {
+        builder.distances[i] = INFINITY;
+    }
+
+    for (int u = 0; u < n; u++) {
+        int arcEnd = Graph_arcEnd(graph, u);
+        for (int arc = Graph_arcBegin(graph, u); arc < arcEnd; arc++) {
+            int v = Graph_arcTarget(graph, arc);
+            if (v != u) {
+                ChBuilder_addArc(&builder, u, v, (float)Graph_arcWeight(graph, arc), -1, -1);
+            }
+        }
+    }
+
+    ContractionHierarchy* ch = (ContractionHierarchy*)calloc(1, sizeof(ContractionHierarchy));
+    AssertNew(ch);
+    ch->nodesCount = n;
+    ch->graphArcsCount = Graph_arcCount(graph);
+    ch->graphFingerprint = Graph_fingerprint(graph);
+    ch->rank = (int*)malloc(allocated * sizeof(int));
+    AssertNew(ch->rank);
+
+    // Node ordering with lazy updates : a popped node whose recomputed
+    // priority is no longer the smallest goes back into the queue
+    IndexedHeap* order = IndexedHeap_create(n, 4);
+    for (int i = 0; i < n; i++) {
+        IndexedHeap_push(order, i, ChBuilder_priority(&builder, i));
+    }
+
+    int nextRank = 0;
+    while (!IndexedHeap_isEmpty(order)) {
+        int node = IndexedHeap_pop(order);
+        float priority = ChBuilder_priority(&builder, node);
+        if (!IndexedHeap_isEmpty(order) && priority > IndexedHeap_minKey(order)) {
+            IndexedHeap_push(order, node, priority);
+            continue;
+        }
+
+        ChBuilder_contract(&builder, node, true);
+        builder.contracted[node] = true;
+        ch->rank[node] = nextRank++;
+
+        for (int i = 0; i < builder.in[node].count; i++) {
+            builder.contractedNeighbors[builder.arcs[builder.in[node].arcs[i]].from]++;
+        }
+        for (int i = 0; i < builder.out[node].count; i++) {
+            builder.contractedNeighbors[builder.arcs[builder.out[node].arcs[i]].to]++;
+        }
+    }
+    IndexedHeap_destroy(order);
+
+    ch->arcs = builder.arcs;
+    ch->arcsCount = builder.arcsCount;
+
+    for (int i = 0; i < n; i++) {
+        free(builder.out[i].arcs);
+        free(builder.in[i].arcs);
+    }
+    free(builder.out);
+    free(builder.in);
+    free(builder.contracted);
+    free(builder.contractedNeighbors);
+    free(builder.distances);
+    free(builder.touched);
+    IndexedHeap_destroy(builder.heap);
+
+    ContractionHierarchy_finalize(ch);
+    return ch;
+}
+
+void ContractionHierarchy_destroy(ContractionHierarchy* ch) {
+    if (ch == NULL) return;
+
+    free(ch->rank);
+    free(ch->arcs);
+    free(ch->upOffsets);
+    free(ch->upArcs);
+    free(ch->downOffsets);
+    free(ch->downArcs);
+    free(ch->forwardDistances);
+    free(ch->backwardDistances);
+    free(ch->forwardParents);
+    free(ch->backwardParents);
+    free(ch->touched);
+    IndexedHeap_destroy(ch->forwardHeap);
+    IndexedHeap_destroy(ch->backwardHeap);
+    free(ch);
+}
+
+bool ContractionHierarchy_matches(ContractionHierarchy* ch, Graph* graph) {
+    return ch->nodesCount == Graph_size(graph) && ch->graphArcsCount == Graph_arcCount(graph)
+        && ch->graphFingerprint == Graph_fingerprint(graph);
+}
+
+bool ContractionHierarchy_save(ContractionHierarchy* ch, const char* fileName) {
+    FILE* file = fopen(fileName, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening file %s\n", fileName);
+        return false;
+    }
+
+    uint32_t header[5] = {
+        CH_FILE_MAGIC, CH_FILE_VERSION,
+        (uint32_t)ch->nodesCount, (uint32_t)ch->graphArcsCount, (uint32_t)ch->arcsCount
+    };
+    bool ok = fwrite(header, sizeof(header), 1, file) == 1;
+    ok = ok && fwrite(&ch->graphFingerprint, sizeof(uint64_t), 1, file) == 1;
+    ok = ok && fwrite(ch->rank, sizeof(int), ch->nodesCount, file) == (size_t)ch->nodesCount;
+    ok = ok && fwrite(ch->arcs, sizeof(ChArc), ch->arcsCount, file) == (size_t)ch->arcsCount;
+
+    fclose(file);
+    if (!ok) {
+        fprintf(stderr, "Error writing file %s\n", fileName);
+    }
+    return ok;
+}
+
+/// @brief Vérifie qu'une hiérarchie lue dans un fichier ne fait référence qu'à
+/// des sommets et des arcs existants : rangs et extrémités dans [0, n[, et
+/// enfants d'un raccourci créés avant lui, ce qui borne aussi leur dépliage.
+static bool ContractionHierarchy_isValid(ContractionHierarchy* ch) {
+    int n = ch->nodesCount;
+    for (int i = 0; i < n; i++) {
+        if (ch->rank[i] < 0 || ch->rank[i] >= n) return false;
+    }
+    for (int i = 0; i < ch->arcsCount; i++) {
+        const ChArc* arc = &ch->arcs[i];
+        if (arc->from < 0 || arc->from >= n || arc->to < 0 || arc->to >= n) return false;
+
+        bool original = arc->firstChild == -1 && arc->secondChild == -1;
+        bool shortcut = arc->firstChild >= 0 && arc->firstChild < i && arc->secondChild >= 0 && arc->secondChild < i;
+        if (!original && !shortcut) return false;
+    }
+    return true;
+}
+
+ContractionHierarchy* ContractionHierarchy_load(const char* fileName) {
+    FILE* file = fopen(fileName, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    uint32_t header[5];
+    uint64_t fingerprint;
+    if (fread(header, sizeof(header), 1, file) != 1 || fread(&fingerprint, sizeof(fingerprint), 1, file) != 1
+        || header[0] != CH_FILE_MAGIC || header[1] != CH_FILE_VERSION
+        || header[2] > INT_MAX || header[3] > INT_MAX || header[4] > INT_MAX) {
+        fprintf(stderr, "Invalid contraction hierarchy file %s\n", fileName);
+        fclose(file);
+        return NULL;
+    }
+
+    // The sizes of the header are checked against the file before the arrays are allocated
+    uint64_t remaining = Platform_remainingBytes(file);
+    if (remaining < (uint64_t)header[2] * sizeof(int) + (uint64_t)header[4] * sizeof(ChArc)) {
+        fprintf(stderr, "Truncated contraction hierarchy file %s\n", fileName);
+        fclose(file);
+        return NULL;
+    }
+
+    ContractionHierarchy* ch = (ContractionHierarchy*)calloc(1, sizeof(ContractionHierarchy));
+    AssertNew(ch);
+    ch->nodesCount = (int)header[2];
+    ch->graphArcsCount = (int)header[3];
+    ch->arcsCount = (int)header[4];
+    ch->graphFingerprint = fingerprint;
+
+    ch->rank = (int*)malloc((ch->nodesCount > 0 ? ch->nodesCount : 1) * sizeof(int));
+    AssertNew(ch->rank);
+    ch->arcs = (ChArc*)malloc((ch->arcsCount > 0 ? ch->arcsCount : 1) * sizeof(ChArc));
+    AssertNew(ch->arcs);
+
+    bool ok = fread(ch->rank, sizeof(int), ch->nodesCount, file) == (size_t)ch->nodesCount;
+    ok = ok && fread(ch->arcs, sizeof(ChArc), ch->arcsCount, file) == (size_t)ch->arcsCount;
+    fclose(file);
+
+    if (!ok) {
+        fprintf(stderr, "Truncated contraction hierarchy file %s\n", fileName);
+    } else if (!ContractionHierarchy_isValid(ch)) {
+        fprintf(stderr, "Invalid contraction hierarchy file %s\n", fileName);
+        ok = false;
+    }
+    if (!ok) {
+        free(ch->rank);
+        free(ch->arcs);
+        free(ch);
+        return NULL;
+    }
+
+    ContractionHierarchy_finalize(ch);
+    return ch;
+}
+
+ContractionHierarchy* ContractionHierarchy_loadOrBuild(Graph* graph, const char* fileName) {
+    ContractionHierarchy* ch = ContractionHierarchy_load(fileName);
+    if (ch != NULL && ContractionHierarchy_matches(ch, graph)) {
+        return ch;
+    }
+    ContractionHierarchy_destroy(ch);
+
+    ch = ContractionHierarchy_build(graph);
+    ContractionHierarchy_save(ch, fileName);
+    return ch;
+}
+
+static void ContractionHierarchy_reset(ContractionHierarchy* ch) {
+    for (int i = 0; i < ch->touchedCount; i++) {
+        int node = ch->touched[i];
+        ch->forwardDistances[node] = INFINITY;
+        ch->backwardDistances[node] = INFINITY;
+        ch->forwardParents[node] = -1;
+        ch->backwardParents[node] = -1;
+    }
+    ch->touchedCount = 0;
+    IndexedHeap_clear(ch->forwardHeap);
+    IndexedHeap_clear(ch->backwardHeap);
+}
+
+static void ContractionHierarchy_touch(ContractionHierarchy* ch, int node) {
+    if (isinf(ch->forwardDistances[node]) && isinf(ch->backwardDistances[node])) {
+        ch->touched[ch->touchedCount++] = node;
+    }
+}
+
+/// @brief Recherche bidirectionnelle montante.
+/// @return Le sommet de rencontre du plus court chemin, -1 s'il n'existe pas.
+static int ContractionHierarchy_search(ContractionHierarchy* ch, int start, int end, float* distance, ShortestPathStats* stats) {
+    assert(start >= 0 && start < ch->nodesCount && end >= 0 && end < ch->nodesCount);
+
+    ContractionHierarchy_reset(ch);
+
+    ContractionHierarchy_touch(ch, start);
+    ch->forwardDistances[start] = 0.0f;
+    IndexedHeap_push(ch->forwardHeap, start, 0.0f);
+
+    ContractionHierarchy_touch(ch, end);
+    ch->backwardDistances[end] = 0.0f;
+    IndexedHeap_push(ch->backwardHeap, end, 0.0f);
+
+    float best = start == end ? 0.0f : INFINITY;
+    int meeting = start == end ? start : -1;
+    int settled = 0;
+
+    // Both searches only go up, so neither can stop at the first meeting :
+    // each one runs until its smallest key exceeds the best distance
+    while (true) {
+        float forwardMin = IndexedHeap_isEmpty(ch->forwardHeap) ? INFINITY : IndexedHeap_minKey(ch->forwardHeap);
+        float backwardMin = IndexedHeap_isEmpty(ch->backwardHeap) ? INFINITY : IndexedHeap_minKey(ch->backwardHeap);
+        if (forwardMin >= best && backwardMin >= best) {
+            break;
+        }
+        settled++;
+
+        if (forwardMin <= backwardMin) {
+            int currID = IndexedHeap_pop(ch->forwardHeap);
+            for (int i = ch->upOffsets[currID]; i < ch->upOffsets[currID + 1]; i++) {
+                ChArc* arc = &ch->arcs[ch->upArcs[i]];
+                float dist = ch->forwardDistances[currID] + arc->weight;
+                if (dist < ch->forwardDistances[arc->to]) {
+                    ContractionHierarchy_touch(ch, arc->to);
+                    ch->forwardDistances[arc->to] = dist;
+                    ch->forwardParents[arc->to] = ch->upArcs[i];
+                    IndexedHeap_push(ch->forwardHeap, arc->to, dist);
+
+                    if (dist + ch->backwardDistances[arc->to] < best) {
+                        best = dist + ch->backwardDistances[arc->to];
+                        meeting = arc->to;
+                    }
+                }
+            }
+        } else {
+            int currID = IndexedHeap_pop(ch->backwardHeap);
+            for (int i = ch->downOffsets[currID]; i < ch->downOffsets[currID + 1]; i++) {
+                ChArc* arc = &ch->arcs[ch->downArcs[i]];
+                float dist = ch->backwardDistances[currID] + arc->weight;
+                if (dist < ch->backwardDistances[arc->from]) {
+                    ContractionHierarchy_touch(ch, arc->from);
+                    ch->backwardDistances[arc->from] = dist;
+                    ch->backwardParents[arc->from] = ch->downArcs[i];
+                    IndexedHeap_push(ch->backwardHeap, arc->from, dist);
+
+                    if (dist + ch->forwardDistances[arc->from] < best) {
+                        best = dist + ch->forwardDistances[arc->from];
+                        meeting = arc->from;
+                    }
+                }
+            }
+        }
+    }
+
+    if (stats != NULL) {
+        stats->settledCount = settled;
+    }
+    *distance = best;
+    return meeting;
+}
+
+float ContractionHierarchy_distance(ContractionHierarchy* ch, int start, int end, ShortestPathStats* stats) {
+    float distance;
+    ContractionHierarchy_search(ch, start, end, &distance, stats);
+    return distance;
+}
+
+/// @brief Ajoute au chemin les sommets d'arrivée des arcs d'origine qui
+/// composent l'arc arc.
+static void ContractionHierarchy_unpack(ContractionHierarchy* ch, int arc, Path* path, int** stack, int* stackCapacity) {
+    int stackSize = 0;
+    (*stack)[stackSize++] = arc;
+
+    while (stackSize > 0) {
+        ChArc* current = &ch->arcs[(*stack)[--stackSize]];
+        if (current->firstChild < 0) {
+            Path_append(path, current->to);
+            continue;
+        }
+
+        if (stackSize + 2 > *stackCapacity) {
+            *stackCapacity *= 2;
+            *stack = (int*)realloc(*stack, *stackCapacity * sizeof(int));
+            AssertNew(*stack);
+        }
+        // The first half is popped first
+        (*stack)[stackSize++] = current->secondChild;
+        (*stack)[stackSize++] = current->firstChild;
+    }
+}
+
+Path* ContractionHierarchy_shortestPath(ContractionHierarchy* ch, Graph* graph, int start, int end, ShortestPathStats* stats) {
+    assert(ContractionHierarchy_matches(ch, graph));
+
+    float distance;
+    int meeting = ContractionHierarchy_search(ch, start, end, &distance, stats);
+    if (meeting < 0) {
+        return NULL;
+    }
+
+    // Arcs of the forward half, from meeting back to start
+    int forwardCount = 0;
+    for (int node = meeting; ch->forwardParents[node] >= 0; node = ch->arcs[ch->forwardParents[node]].from) {
+        forwardCount++;
+    }
+    int* forwardArcs = (int*)malloc((forwardCount > 0 ? forwardCount : 1) * sizeof(int));
+    AssertNew(forwardArcs);
+    int i = forwardCount;
+    for (int node = meeting; ch->forwardParents[node] >= 0; node = ch->arcs[ch->forwardParents[node]].from) {
+        forwardArcs[--i] = ch->forwardParents[node];
+    }
+
+    int stackCapacity = 64;
+    int* stack = (int*)malloc(stackCapacity * sizeof(int));
+    AssertNew(stack);
+
+    Path* path = Path_create(start);
+    path->distance = distance;
+    for (i = 0; i < forwardCount; i++) {
+        ContractionHierarchy_unpack(ch, forwardArcs[i], path, &stack, &stackCapacity);
+    }
+    for (int node = meeting; ch->backwardParents[node] >= 0; node = ch->arcs[ch->backwardParents[node]].to) {
+        ContractionHierarchy_unpack(ch, ch->backwardParents[node], path, &stack, &stackCapacity);
+    }
+
+    free(forwardArcs);
+    free(stack);
+    return path;
+}
@@ -0,0 +1,283 @@
+#include "DeltaStepping.h"
+#include "Platform.h"
+
+/// @brief Liste dynamique de sommets.
+typedef struct NodeList {
+    int* items;
+    int count;
+    int capacity;
+} NodeList;
+
+static void NodeList_push(NodeList* list, int node) {
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity > 0 ? 2 * list->capacity : 16;
+        list->items = (int*)realloc(list->items, list->capacity * sizeof(int));
+        AssertNew(list->items);
+    }
+    list->items[list->count++] = node;
+}
+
+/// @brief Etiquette d'un sommet : les bits de sa distance (float positif, dont
+/// l'ordre est celui des entiers non signés) dans les 32 bits de poids fort et
+/// son prédécesseur dans les 32 bits de poids faible. Distance et prédécesseur
+/// sont ainsi mis à jour ensemble par un seul compare-and-swap.
+static uint64_t DeltaStepping_pack(float distance, int predecessor) {
+    uint32_t bits;
+    memcpy(&bits, &distance, sizeof(bits));
+    return ((uint64_t)bits << 32) | (uint32_t)predecessor;
+}
+
+static float DeltaStepping_distance(uint64_t label) {
+    uint32_t bits = (uint32_t)(label >> 32);
+    float distance;
+    memcpy(&distance, &bits, sizeof(distance));
+    return distance;
+}
+
+static int DeltaStepping_predecessor(uint64_t label) {
+    return (int)(uint32_t)label;
+}
+
+typedef struct DeltaStepping {
+    Graph* graph;
+    float delta;
+    volatile uint64_t* labels;
+
+    /// @brief Seaux de sommets, indexés par floor(distance / delta).
+    /// Une entrée dont la distance a changé de seau depuis son ajout est ignorée.
+    NodeList* buckets;
+    int bucketsCount;
+
+    /// @brief Sommets améliorés pendant la phase courante, un tableau par thread.
+    NodeList* outputs;
+    int workers;
+
+    /// @brief Threads démarrés une seule fois pour toutes les phases, NULL
+    /// s'il n'y en a qu'un.
+    PlatformPool* pool;
+
+    /// @brief Phase de relâchement en cours, partagée par les threads.
+    const int* phaseNodes;
+    int phaseCount;
+    int chunkSize;
+    bool heavy;
+
+    /// @brief Tampons évitant d'ajouter deux fois un sommet à la même frontière
+    /// ou à la même liste de sommets traités.
+    uint32_t* frontierStamps;
+    uint32_t frontierStamp;
+    uint32_t* settledStamps;
+    uint32_t settledStamp;
+} DeltaStepping;
+
+static int DeltaStepping_bucket(DeltaStepping* ds, float distance) {
+    // Very far nodes share the last bucket, which is then processed again
+    // until it is stable
+    double bucket = floor((double)distance / ds->delta);
+    return bucket < INT32_MAX / 2 ? (int)bucket : INT32_MAX / 2;
+}
+
+static void DeltaStepping_relax(DeltaStepping* ds, int node, NodeList* output) {
+    Graph* graph = ds->graph;
+    float distance = DeltaStepping_distance(Atomic_load64(&ds->labels[node]));
+
+    int arcEnd = Graph_arcEnd(graph, node);
+    for (int arc = Graph_arcBegin(graph, node); arc < arcEnd; arc++) {
+        int weight = Graph_arcWeight(graph, arc);
+        if ((weight > ds->delta) != ds->heavy) {
+            continue;
+        }
+
+        int nextID = Graph_arcTarget(graph, arc);
+        float dist = distance + weight;
+        uint64_t desired = DeltaStepping_pack(dist, node);
+
+        uint64_t current = Atomic_load64(&ds->labels[nextID]);
+        while (DeltaStepping_distance(current) > dist) {
+            if (Atomic_compareExchange64(&ds->labels[nextID], &current, desired)) {
+                NodeList_push(output, nextID);
+                break;
+            }
+        }
+    }
+}
+
+static void DeltaStepping_relaxTask(void* context, int chunk, int worker) {
+    DeltaStepping* ds = (DeltaStepping*)context;
+
+    int first = chunk * ds->chunkSize;
+    int last = minInt(first + ds->chunkSize, ds->phaseCount);
+    for (int i = first; i < last; i++) {
+        DeltaStepping_relax(ds, ds->phaseNodes[i], &ds->outputs[worker]);
+    }
+}
+
+/// @brief Relâche les arcs légers ou lourds d'une liste de sommets.
+static void DeltaStepping_relaxAll(DeltaStepping* ds, const int* nodes, int count, bool heavy) {
+    ds->heavy = heavy;
+
+    // Waking the threads costs more than relaxing a small frontier
+    if (count < DELTA_STEPPING_PARALLEL_THRESHOLD || ds->pool == NULL) {
+        for (int i = 0; i < count; i++) {
+            DeltaStepping_relax(ds, nodes[i], &ds->outputs[0]);
+        }
+        return;
+    }
+
+    int chunks = minInt(count, 8 * ds->workers);
+    ds->phaseNodes = nodes;
+    ds->phaseCount = count;
+    ds->chunkSize = (count + chunks - 1) / chunks;
+    Platform_runPool(ds->pool, (count + ds->chunkSize - 1) / ds->chunkSize, DeltaStepping_relaxTask, ds);
+}
+
+/// @brief Range les sommets améliorés par la dernière phase : ceux qui restent
+/// dans le seau current vont dans frontier, les autres dans leur seau.
+static void DeltaStepping_collect(DeltaStepping* ds, int current, NodeList* frontier) {
+    ds->frontierStamp++;
+
+    for (int w = 0; w < ds->workers; w++) {
+        NodeList* output = &ds->outputs[w];
+        for (int i = 0; i < output->count; i++) {
+            int node = output->items[i];
+            int bucket = DeltaStepping_bucket(ds, DeltaStepping_distance(ds->labels[node]));
+
+            if (bucket <= current) {
+                if (ds->frontierStamps[node] != ds->frontierStamp) {
+                    ds->frontierStamps[node] = ds->frontierStamp;
+                    NodeList_push(frontier, node);
+                }
+                continue;
+            }
+
+            if (bucket >= ds->bucketsCount) {
+                int count = maxInt(bucket + 1, 2 * ds->bucketsCount);
+                ds->buckets = (NodeList*)realloc(ds->buckets, count * sizeof(NodeList));
+                AssertNew(ds->buckets);
+                memset(ds->buckets + ds->bucketsCount, 0, (count - ds->bucketsCount) * sizeof(NodeList));
+                ds->bucketsCount = count;
+            }
+            NodeList_push(&ds->buckets[bucket], node);
+        }
+        output->count = 0;
+    }
+}
+
+void Graph_deltaStepping(Graph* graph, int start, int* predecessors, float* distances, float delta, ShortestPathStats* stats) {
+    int size = Graph_size(graph);
+    assert(start >= 0 && start < size);
+
+    if (delta <= 0.0f) {
+        // Mean arc weight
+        double total = 0.0;
+        for (int arc = 0; arc < graph->arcsCount; arc++) {
+            total += graph->arcWeights[arc];
+        }
+        delta = graph->arcsCount > 0 ? (float)(total / graph->arcsCount) : 1.0f;
+        delta = fmaxf(delta, 1.0f);
+    }
+
+    DeltaStepping ds = { 0 };
+    ds.graph = graph;
+    ds.delta = delta;
+    ds.workers = Platform_workerCount(INT32_MAX);
+    ds.outputs = (NodeList*)calloc(ds.workers, sizeof(NodeList));
+    AssertNew(ds.outputs);
+    // Without a pool, every phase runs on the calling thread
+    ds.pool = ds.workers > 1 ? Platform_startPool(ds.workers) : NULL;
+    ds.labels = (volatile uint64_t*)malloc(size * sizeof(uint64_t));
+    AssertNew(ds.labels);
+    ds.frontierStamps = (uint32_t*)calloc(size, sizeof(uint32_t));
+    AssertNew(ds.frontierStamps);
+    ds.settledStamps = (uint32_t*)calloc(size, sizeof(uint32_t));
+    AssertNew(ds.settledStamps);
+    ds.bucketsCount = 1;
+    ds.buckets = (NodeList*)calloc(1, sizeof(NodeList));
+    AssertNew(ds.buckets);
+
+    for (int i = 0; i < size; i++) {
+        ds.labels[i] = DeltaStepping_pack(INFINITY, -1);
+    }
+    ds.labels[start] = DeltaStepping_pack(0.0f, -1);
+    NodeList_push(&ds.buckets[0], start);
+
+    NodeList frontier = { 0 };
+    NodeList next = { 0 };
+    NodeList settled = { 0 };
+    int settledCount = 0;
+
+    for (int current = 0; current < ds.bucketsCount; current++) {
+        // Heavy relaxations may refill the current bucket (only when the last
+        // bucket is shared by very far nodes), hence the loop
+        while (ds.buckets[current].count > 0) {
+            ds.frontierStamp++;
+            frontier.count = 0;
+            NodeList* bucket = &ds.buckets[current];
+            for (int i = 0; i < bucket->count; i++) {
+                int node = bucket->items[i];
+                float distance = DeltaStepping_distance(ds.labels[node]);
+                if (DeltaStepping_bucket(&ds, distance) == current && ds.frontierStamps[node] != ds.frontierStamp) {
+                    ds.frontierStamps[node] = ds.frontierStamp;
+                    NodeList_push(&frontier, node);
+                }
+            }
+            bucket->count = 0;
+
+            // Light arcs, until no node of the bucket improves
+            ds.settledStamp++;
+            settled.count = 0;
+            while (frontier.count > 0) {
+                for (int i = 0; i < frontier.count; i++) {
+                    int node = frontier.items[i];
+                    if (ds.settledStamps[node] != ds.settledStamp) {
+                        ds.settledStamps[node] = ds.settledStamp;
+                        NodeList_push(&settled, node);
+                    }
+                }
+                settledCount += frontier.count;
+
+                DeltaStepping_relaxAll(&ds, frontier.items, frontier.count, false);
+
+                next.count = 0;
+                DeltaStepping_collect(&ds, current, &next);
+                NodeList swap = frontier;
+                frontier = next;
+                next = swap;
+            }
+
+            // Heavy arcs, once per node of the bucket
+            DeltaStepping_relaxAll(&ds, settled.items, settled.count, true);
+            next.count = 0;
+            DeltaStepping_collect(&ds, current, &next);
+            for (int i = 0; i < next.count; i++) {
+                NodeList_push(&ds.buckets[current], next.items[i]);
+            }
+        }
+    }
+
+    for (int i = 0; i < size; i++) {
+        uint64_t label = ds.labels[i];
+        distances[i] = DeltaStepping_distance(label);
+        predecessors[i] = DeltaStepping_predecessor(label);
+    }
+
+    if (stats != NULL) {
+        stats->settledCount = settledCount;
+    }
+
+    Platform_stopPool(ds.pool);
+    for (int i = 0; i < ds.bucketsCount; i++) {
+        free(ds.buckets[i].items);
+    }
+    for (int i = 0; i < ds.workers; i++) {
+        free(ds.outputs[i].items);
+    }
+    free(ds.buckets);
+    free(ds.outputs);
+    free((void*)ds.labels);
+    free(ds.frontierStamps);
+    free(ds.settledStamps);
+    free(frontier.items);
+    free(next.items);
+    free(settled.items);
+}
@@ -0,0 +1,248 @@
+#include "DynamicShortestPath.h"
+
+#define DYNAMIC_SHORTEST_PATH_ARITY 4
+
+static void DynamicShortestPath_reserve(DynamicShortestPath* tree, int size) {
+    if (size <= tree->capacity) return;
+
+    int capacity = maxInt(size, 2 * tree->capacity);
+    tree->distances = (float*)realloc(tree->distances, capacity * sizeof(float));
+    AssertNew(tree->distances);
+    tree->predecessors = (int*)realloc(tree->predecessors, capacity * sizeof(int));
+    AssertNew(tree->predecessors);
+    tree->subtree = (int*)realloc(tree->subtree, capacity * sizeof(int));
+    AssertNew(tree->subtree);
+    tree->stamps = (uint32_t*)realloc(tree->stamps, capacity * sizeof(uint32_t));
+    AssertNew(tree->stamps);
+    memset(tree->stamps + tree->capacity, 0, (capacity - tree->capacity) * sizeof(uint32_t));
+
+    // The heap cannot grow, it is replaced (it is always empty between updates)
+    IndexedHeap_destroy(tree->heap);
+    tree->heap = IndexedHeap_create(capacity, DYNAMIC_SHORTEST_PATH_ARITY);
+
+    tree->capacity = capacity;
+}
+
+/// @brief Algorithme de Dijkstra à partir des sommets déjà présents dans le tas.
+static void DynamicShortestPath_propagate(DynamicShortestPath* tree) {
+    Graph* graph = tree->graph;
+
+    while (!IndexedHeap_isEmpty(tree->heap)) {
+        int currID = IndexedHeap_pop(tree->heap);
+        float currDist = tree->distances[currID];
+        tree->updatedCount++;
+
+        int arcEnd = Graph_arcEnd(graph, currID);
+        for (int arc = Graph_arcBegin(graph, currID); arc < arcEnd; arc++) {
+            int nextID = Graph_arcTarget(graph, arc);
+            float dist = currDist + Graph_arcWeight(graph, arc);
+            if (dist < tree->distances[nextID]) {
+                tree->distances[nextID] = dist;
+                tree->predecessors[nextID] = currID;
+                IndexedHeap_push(tree->heap, nextID, dist);
+            }
+        }
+    }
+}
+
+static void DynamicShortestPath_rebuild(DynamicShortestPath* tree) {
+    int size = Graph_size(tree->graph);
+    for (int i = 0; i < size; i++) {
+        tree->distances[i] = INFINITY;
+        tree->predecessors[i] = -1;
+    }
+
+    tree->updatedCount = 0;
+    if (tree->source >= 0) {
+        tree->distances[tree->source] = 0.0f;
+        IndexedHeap_push(tree->heap, tree->source, 0.0f);
+        DynamicShortestPath_propagate(tree);
+    }
+}
+
+/// @brief L'arc from -> to a été ajouté ou son poids a diminué.
+static void DynamicShortestPath_decrease(DynamicShortestPath* tree, int from, int to, int weight) {
+    float dist = tree->distances[from] + weight;
+    if (dist < tree->distances[to]) {
+        tree->distances[to] = dist;
+        tree->predecessors[to] = from;
+        IndexedHeap_push(tree->heap, to, dist);
+        DynamicShortestPath_propagate(tree);
+    }
+}
+
+/// @brief L'arc from -> to a été supprimé ou son poids a augmenté.
+static void DynamicShortestPath_increase(DynamicShortestPath* tree, int from, int to) {
+    // Only the distances below a tree arc depend on it. When parallel arcs
+    // join from and to, the subtree is repaired even if the tree used another one
+    if (tree->predecessors[to] != from) return;
+
+    Graph* graph = tree->graph;
+
+    // Subtree hanging from to, walked through the out-arcs of its nodes
+    tree->stamp++;
+    if (tree->stamp == 0) {
+        memset(tree->stamps, 0, tree->capacity * sizeof(uint32_t));
+        tree->stamp = 1;
+    }
+    int count = 0;
+    tree->subtree[count++] = to;
+    tree->stamps[to] = tree->stamp;
+    for (int i = 0; i < count; i++) {
+        int currID = tree->subtree[i];
+        int arcEnd = Graph_arcEnd(graph, currID);
+        for (int arc = Graph_arcBegin(graph, currID); arc < arcEnd; arc++) {
+            int nextID = Graph_arcTarget(graph, arc);
+            if (tree->predecessors[nextID] == currID && tree->stamps[nextID] != tree->stamp) {
+                tree->stamps[nextID] = tree->stamp;
+                tree->subtree[count++] = nextID;
+            }
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        tree->distances[tree->subtree[i]] = INFINITY;
+        tree->predecessors[tree->subtree[i]] = -1;
+    }
+
+    // The distances outside the subtree are still exact: each subtree node
+    // starts from its best in-arc coming from outside. The in-arcs are only
+    // built once, the arc edits keep them up to date
+    Graph_buildReverse(graph);
+    for (int i = 0; i < count; i++) {
+        int currID = tree->subtree[i];
+        int arcEnd = Graph_inArcEnd(graph, currID);
+        for (int inArc = Graph_inArcBegin(graph, currID); inArc < arcEnd; inArc++) {
+            int prevID = Graph_inArcSource(graph, inArc);
+            if (tree->stamps[prevID] == tree->stamp) continue;
+
+            float dist = tree->distances[prevID] + Graph_inArcWeight(graph, inArc);
+            if (dist < tree->distances[currID]) {
+                tree->distances[currID] = dist;
+                tree->predecessors[currID] = prevID;
+            }
+        }
+        if (!isinf(tree->distances[currID])) {
+            IndexedHeap_push(tree->heap, currID, tree->distances[currID]);
+        }
+    }
+
+    tree->updatedCount = count;
+    DynamicShortestPath_propagate(tree);
+}
+
+static int DynamicShortestPath_shiftIndex(int index, int removed) {
+    if (index == removed) return -1;
+    return index > removed ? index - 1 : index;
+}
+
+/// @brief Déplace les étiquettes des sommets après une renumérotation.
+static void DynamicShortestPath_permute(DynamicShortestPath* tree, const int* newIndices) {
+    int size = Graph_size(tree->graph);
+
+    // The subtree array is free between updates and holds the old predecessors
+    memcpy(tree->subtree, tree->predecessors, size * sizeof(int));
+    float* distances = (float*)malloc(tree->capacity * sizeof(float));
+    AssertNew(distances);
+    for (int i = 0; i < size; i++) {
+        int predecessor = tree->subtree[i];
+        distances[newIndices[i]] = tree->distances[i];
+        tree->predecessors[newIndices[i]] = predecessor >= 0 ? newIndices[predecessor] : -1;
+    }
+    free(tree->distances);
+    tree->distances = distances;
+
+    if (tree->source >= 0) tree->source = newIndices[tree->source];
+    if (tree->target >= 0) tree->target = newIndices[tree->target];
+}
+
+static void DynamicShortestPath_onEdit(void* context, Graph* graph, const GraphEdit* edit) {
+    DynamicShortestPath* tree = (DynamicShortestPath*)context;
+    assert(tree->graph == graph);
+
+    tree->updatedCount = 0;
+    switch (edit->type) {
+    case GRAPH_EDIT_ADD_NODE:
+        DynamicShortestPath_reserve(tree, Graph_size(graph));
+        tree->distances[edit->node] = INFINITY;
+        tree->predecessors[edit->node] = -1;
+        break;
+
+    case GRAPH_EDIT_REMOVE_NODE:
+        tree->source = DynamicShortestPath_shiftIndex(tree->source, edit->node);
+        tree->target = DynamicShortestPath_shiftIndex(tree->target, edit->node);
+        DynamicShortestPath_rebuild(tree);
+        break;
+
+    case GRAPH_EDIT_PERMUTE_NODES:
+        DynamicShortestPath_permute(tree, edit->newIndices);
+        break;
+
+    case GRAPH_EDIT_ADD_ARC:
+        DynamicShortestPath_decrease(tree, edit->from, edit->to, edit->weight);
+        break;
+
+    case GRAPH_EDIT_REMOVE_ARC:
+        DynamicShortestPath_increase(tree, edit->from, edit->to);
+        break;
+
+    case GRAPH_EDIT_SET_WEIGHT:
+        if (edit->weight < edit->oldWeight) {
+            DynamicShortestPath_decrease(tree, edit->from, edit->to, edit->weight);
+        } else if (edit->weight > edit->oldWeight) {
+            DynamicShortestPath_increase(tree, edit->from, edit->to);
+        }
+        break;
+
+    default:
+        // Renaming a node does not change the tree
+        return;
+    }
+    tree->version++;
+}
+
+DynamicShortestPath* DynamicShortestPath_create(Graph* graph, int source) {
+    assert(graph && source >= 0 && source < Graph_size(graph));
+
+    DynamicShortestPath* tree = (DynamicShortestPath*)calloc(1, sizeof(DynamicShortestPath));
+    AssertNew(tree);
+    tree->graph = graph;
+    tree->source = source;
+    tree->target = -1;
+
+    DynamicShortestPath_reserve(tree, maxInt(Graph_size(graph), 1));
+    DynamicShortestPath_rebuild(tree);
+
+    Graph_addObserver(graph, DynamicShortestPath_onEdit, tree);
+    return tree;
+}
+
+void DynamicShortestPath_destroy(DynamicShortestPath* tree) {
+    if (tree == NULL) return;
+
+    Graph_removeObserver(tree->graph, DynamicShortestPath_onEdit, tree);
+    IndexedHeap_destroy(tree->heap);
+    free(tree->distances);
+    free(tree->predecessors);
+    free(tree->subtree);
+    free(tree->stamps);
+    free(tree);
+}
+
+void DynamicShortestPath_setTarget(DynamicShortestPath* tree, int target) {
+    assert(tree && target < Graph_size(tree->graph));
+    tree->target = target;
+}
+
+Path* DynamicShortestPath_getPath(DynamicShortestPath* tree) {
+    assert(tree);
+
+    int target = tree->target;
+    if (tree->source < 0 || target < 0 || isinf(tree->distances[target])) {
+        return NULL;
+    }
+    if (target == tree->source) {
+        return Path_create(target);
+    }
+    return Graph_dijkstraGetPath(tree->graph, tree->predecessors, tree->distances, target);
+}
@@ -0,0 +1,675 @@
+#include "EditJournal.h"
+#include "Platform.h"
+
+#define EDIT_JOURNAL_MAGIC 0x4C4A5647u // "GVJL"
+#define EDIT_JOURNAL_VERSION 3
+
+/// @brief Extension du fichier écrit avant de remplacer le journal.
+#define EDIT_JOURNAL_TEMP_EXTENSION ".tmp"
+
+/// @brief Taille des blocs lus pour copier un fichier.
+#define EDIT_JOURNAL_CHUNK (1 << 16)
+
+#define FNV_OFFSET 14695981039346656037ull
+#define FNV_PRIME 1099511628211ull
+
+/// @brief Type d'un enregistrement. Les valeurs sont écrites dans les
+/// fichiers et ne doivent pas changer.
+typedef enum EditJournalRecordType {
+    EDIT_RECORD_ADD_NODE = 1,
+    EDIT_RECORD_REMOVE_NODE = 2,
+    EDIT_RECORD_RENAME_NODE = 3,
+    EDIT_RECORD_MOVE_NODE = 4,
+    EDIT_RECORD_ADD_ARC = 5,
+    EDIT_RECORD_REMOVE_ARC = 6,
+    EDIT_RECORD_SET_WEIGHT = 7,
+    EDIT_RECORD_PERMUTE_NODES = 8,
+    EDIT_RECORD_CHECKPOINT = 9
+} EditJournalRecordType;
+
+/// @brief En-tête du fichier du journal.
+typedef struct EditJournalHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t snapshotSize;
+    uint64_t snapshotId;
+} EditJournalHeader;
+
+/// @brief En-tête d'un enregistrement, suivi de size octets : le type de
+/// l'enregistrement puis ses champs (entiers et réels sur 4 octets,
+/// identifiants d'instantané sur 8, chaînes précédées de leur taille, '\0'
+/// compris).
+typedef struct EditJournalRecordHeader {
+    uint32_t size;
+    uint32_t checksum;
+} EditJournalRecordHeader;
+
+typedef struct EditJournalCompaction {
+    /// @brief Copie du graphe écrite dans le nouvel instantané.
+    Graph* snapshot;
+    PlatformThread* thread;
+    volatile uint64_t done;
+
+    /// @brief Identifiant du nouvel instantané, choisi avant son écriture et
+    /// rangé dans le point de contrôle.
+    uint64_t checkpointId;
+
+    /// @brief Résultat de l'écriture, taille et identifiant du nouvel instantané.
+    bool ok;
+    uint64_t snapshotSize;
+    uint64_t snapshotId;
+} EditJournalCompaction;
+
+/// @brief Lecture des champs d'un enregistrement.
+typedef struct EditJournalReader {
+    const char* data;
+    size_t size;
+    size_t offset;
+    bool ok;
+} EditJournalReader;
+
+static uint64_t EditJournal_hash(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/// @brief Calcule la taille et l'identifiant de l'instantané dont le graphe
+/// vient d'être chargé ou enregistré : graph->snapshotId, écrit dans les
+/// fichiers binaires, ou à défaut l'empreinte du graphe (Graph_fingerprint()).
+/// Le fichier n'est pas lu.
+static bool EditJournal_identify(Graph* graph, uint64_t* size, uint64_t* id) {
+    FILE* file = fopen(graph->fileName, "rb");
+    if (file == NULL) return false;
+
+    *size = Platform_remainingBytes(file);
+    *id = graph->snapshotId != 0 ? graph->snapshotId : Graph_fingerprint(graph);
+    fclose(file);
+    return true;
+}
+
+static char* EditJournal_concat(const char* str, const char* suffix) {
+    size_t length = strlen(str);
+    size_t suffixLength = strlen(suffix);
+    char* result = (char*)malloc(length + suffixLength + 1);
+    AssertNew(result);
+    memcpy(result, str, length);
+    memcpy(result + length, suffix, suffixLength + 1);
+    return result;
+}
+
+/// @brief Remplace le journal par un en-tête pour l'instantané actuel suivi
+/// des octets [begin, end[ du journal actuel. En cas d'échec, le journal
+/// actuel est conservé, ainsi que journal->base et journal->size.
+static bool EditJournal_rewrite(EditJournal* journal, uint64_t begin, uint64_t end) {
+    bool wasOpen = journal->file != NULL;
+    if (wasOpen) {
+        fclose(journal->file);
+        journal->file = NULL;
+    }
+
+    char* tempName = EditJournal_concat(journal->fileName, EDIT_JOURNAL_TEMP_EXTENSION);
+    FILE* file = fopen(tempName, "wb");
+    bool ok = file != NULL;
+
+    EditJournalHeader header = { EDIT_JOURNAL_MAGIC, EDIT_JOURNAL_VERSION, journal->snapshotSize, journal->snapshotId };
+    ok = ok && fwrite(&header, sizeof(header), 1, file) == 1;
+    if (ok && end > begin) {
+        FILE* source = fopen(journal->fileName, "rb");
+        char* buffer = (char*)malloc(EDIT_JOURNAL_CHUNK);
+        AssertNew(buffer);
+        ok = source != NULL && fseek(source, (long)begin, SEEK_SET) == 0;
+        for (uint64_t remaining = end - begin; ok && remaining > 0;) {
+            size_t count = remaining < EDIT_JOURNAL_CHUNK ? (size_t)remaining : EDIT_JOURNAL_CHUNK;
+            ok = fread(buffer, 1, count, source) == count && fwrite(buffer, 1, count, file) == count;
+            remaining -= count;
+        }
+        free(buffer);
+        // The journal cannot be replaced while it is open on every platform
+        if (source != NULL) fclose(source);
+    }
+    ok = ok && Platform_syncFile(file);
+    if (file != NULL) ok = fclose(file) == 0 && ok;
+    ok = ok && Platform_replaceFile(tempName, journal->fileName);
+
+    if (ok) {
+        journal->size = sizeof(header) + (end > begin ? end - begin : 0);
+        journal->base = sizeof(header);
+    } else {
+        fprintf(stderr, "Error writing file %s\n", journal->fileName);
+        remove(tempName);
+    }
+    if (ok || wasOpen) {
+        journal->file = fopen(journal->fileName, "ab");
+        ok = ok && journal->file != NULL;
+    }
+    free(tempName);
+    return ok;
+}
+
+static void EditJournal_put(EditJournal* journal, const void* data, size_t size) {
+    if (journal->pendingSize + size > journal->pendingCapacity) {
+        size_t capacity = journal->pendingCapacity > 0 ? 2 * journal->pendingCapacity : 256;
+        while (capacity < journal->pendingSize + size) capacity *= 2;
+        journal->pending = (char*)realloc(journal->pending, capacity);
+        AssertNew(journal->pending);
+        journal->pendingCapacity = capacity;
+    }
+    memcpy(journal->pending + journal->pendingSize, data, size);
+    journal->pendingSize += size;
+}
+
+static void EditJournal_putInt(EditJournal* journal, int32_t value) {
+    EditJournal_put(journal, &value, sizeof(value));
+}
+
+static void EditJournal_putFloat(EditJournal* journal, float value) {
+    EditJournal_put(journal, &value, sizeof(value));
+}
+
+static void EditJournal_putId(EditJournal* journal, uint64_t value) {
+    EditJournal_put(journal, &value, sizeof(value));
+}
+
+static void EditJournal_putString(EditJournal* journal, const char* str) {
+    int32_t size = (int32_t)strlen(str) + 1;
+    EditJournal_putInt(journal, size);
+    EditJournal_put(journal, str, size);
+}
+
+/// @brief Commence un enregistrement dans le tampon des modifications.
+/// @return La position de l'enregistrement, à passer à EditJournal_endRecord().
+static size_t EditJournal_beginRecord(EditJournal* journal, EditJournalRecordType type) {
+    size_t record = journal->pendingSize;
+    journal->lastRecord = record;
+    EditJournalRecordHeader header = { 0, 0 };
+    EditJournal_put(journal, &header, sizeof(header));
+    EditJournal_putInt(journal, type);
+    return record;
+}
+
+static void EditJournal_endRecord(EditJournal* journal, size_t record) {
+    EditJournalRecordHeader header;
+    header.size = (uint32_t)(journal->pendingSize - record - sizeof(header));
+    header.checksum = (uint32_t)EditJournal_hash(FNV_OFFSET, journal->pending + record + sizeof(header), header.size);
+    memcpy(journal->pending + record, &header, sizeof(header));
+}
+
+/// @brief Indique si le dernier enregistrement en attente déplace le nœud donné.
+static bool EditJournal_lastMoves(EditJournal* journal, int node) {
+    if (journal->pendingSize == 0) return false;
+
+    int32_t fields[2];
+    const char* data = journal->pending + journal->lastRecord + sizeof(EditJournalRecordHeader);
+    memcpy(fields, data, sizeof(fields));
+    return fields[0] == EDIT_RECORD_MOVE_NODE && fields[1] == node;
+}
+
+static void EditJournal_onEdit(void* context, Graph* graph, const GraphEdit* edit) {
+    EditJournal* journal = (EditJournal*)context;
+
+    size_t record;
+    switch (edit->type) {
+    case GRAPH_EDIT_ADD_NODE:
+    {
+        Vector2 position = Graph_getNodePosition(graph, edit->node);
+        record = EditJournal_beginRecord(journal, EDIT_RECORD_ADD_NODE);
+        EditJournal_putString(journal, Graph_getNodeId(graph, edit->node));
+        EditJournal_putFloat(journal, position.x);
+        EditJournal_putFloat(journal, position.y);
+        break;
+    }
+    case GRAPH_EDIT_REMOVE_NODE:
+        record = EditJournal_beginRecord(journal, EDIT_RECORD_REMOVE_NODE);
+        EditJournal_putInt(journal, edit->node);
+        break;
+
+    case GRAPH_EDIT_RENAME_NODE:
+        record = EditJournal_beginRecord(journal, EDIT_RECORD_RENAME_NODE);
+        EditJournal_putInt(journal, edit->node);
+        EditJournal_putString(journal, Graph_getNodeId(graph, edit->node));
+        break;
+
+    case GRAPH_EDIT_MOVE_NODE:
+    {
+        Vector2 position = Graph_getNodePosition(graph, edit->node);
+        // A drag moves the node at each frame : only its last position is kept
+        if (EditJournal_lastMoves(journal, edit->node)) {
+            journal->pendingSize = journal->lastRecord;
+        }
+        record = EditJournal_beginRecord(journal, EDIT_RECORD_MOVE_NODE);
+        EditJournal_putInt(journal, edit->node);
+        EditJournal_putFloat(journal, position.x);
+        EditJournal_putFloat(journal, position.y);
+        break;
+    }
+    case GRAPH_EDIT_ADD_ARC:
+        record = EditJournal_beginRecord(journal, EDIT_RECORD_ADD_ARC);
+        EditJournal_putInt(journal, edit->from);
+        EditJournal_putInt(journal, edit->to);
+        EditJournal_putInt(journal, edit->weight);
+        break;
+
+    case GRAPH_EDIT_REMOVE_ARC:
+        record = EditJournal_beginRecord(journal, EDIT_RECORD_REMOVE_ARC);
+        EditJournal_putInt(journal, edit->arc);
+        break;
+
+    case GRAPH_EDIT_SET_WEIGHT:
+        record = EditJournal_beginRecord(journal, EDIT_RECORD_SET_WEIGHT);
+        EditJournal_putInt(journal, edit->arc);
+        EditJournal_putInt(journal, edit->weight);
+        break;
+
+    case GRAPH_EDIT_PERMUTE_NODES:
+    {
+        int count = Graph_size(graph);
+        record = EditJournal_beginRecord(journal, EDIT_RECORD_PERMUTE_NODES);
+        EditJournal_putInt(journal, count);
+        EditJournal_put(journal, edit->newIndices, count * sizeof(int32_t));
+        break;
+    }
+    default:
+        return;
+    }
+    EditJournal_endRecord(journal, record);
+}
+
+static int32_t EditJournalReader_int(EditJournalReader* reader) {
+    int32_t value = 0;
+    if (reader->size - reader->offset < sizeof(value)) {
+        reader->ok = false;
+        return 0;
+    }
+    memcpy(&value, reader->data + reader->offset, sizeof(value));
+    reader->offset += sizeof(value);
+    return value;
+}
+
+static float EditJournalReader_float(EditJournalReader* reader) {
+    float value = 0.0f;
+    if (reader->size - reader->offset < sizeof(value)) {
+        reader->ok = false;
+        return 0.0f;
+    }
+    memcpy(&value, reader->data + reader->offset, sizeof(value));
+    reader->offset += sizeof(value);
+    return value;
+}
+
+static uint64_t EditJournalReader_id(EditJournalReader* reader) {
+    uint64_t value = 0;
+    if (reader->size - reader->offset < sizeof(value)) {
+        reader->ok = false;
+        return 0;
+    }
+    memcpy(&value, reader->data + reader->offset, sizeof(value));
+    reader->offset += sizeof(value);
+    return value;
+}
+
+static const char* EditJournalReader_string(EditJournalReader* reader) {
+    int32_t size = EditJournalReader_int(reader);
+    if (!reader->ok || size <= 0 || (size_t)size > reader->size - reader->offset
+        || reader->data[reader->offset + size - 1] != '\0') {
+        reader->ok = false;
+        return "";
+    }
+    const char* str = reader->data + reader->offset;
+    reader->offset += size;
+    return str;
+}
+
+/// @brief Indique si tous les champs ont été lus, sans dépasser la fin de l'enregistrement.
+static bool EditJournalReader_end(EditJournalReader* reader) {
+    return reader->ok && reader->offset == reader->size;
+}
+
+/// @brief Applique un enregistrement au graphe.
+/// @return false si l'enregistrement ne peut pas s'appliquer au graphe.
+static bool EditJournal_apply(Graph* graph, const char* data, size_t size) {
+    EditJournalReader reader = { data, size, 0, true };
+    int type = EditJournalReader_int(&reader);
+    int nodesCount = Graph_size(graph);
+    int arcsCount = Graph_arcCount(graph);
+
+    switch (type) {
+    case EDIT_RECORD_ADD_NODE:
+    {
+        const char* id = EditJournalReader_string(&reader);
+        Vector2 position;
+        position.x = EditJournalReader_float(&reader);
+        position.y = EditJournalReader_float(&reader);
+        if (!EditJournalReader_end(&reader) || Graph_getNodeIndex(graph, id) >= 0) return false;
+        Graph_addNode(graph, id, position);
+        return true;
+    }
+    case EDIT_RECORD_REMOVE_NODE:
+    {
+        int node = EditJournalReader_int(&reader);
+        if (!EditJournalReader_end(&reader) || node < 0 || node >= nodesCount) return false;
+        Graph_removeNode(graph, node);
+        return true;
+    }
+    case EDIT_RECORD_RENAME_NODE:
+    {
+        int node = EditJournalReader_int(&reader);
+        const char* id = EditJournalReader_string(&reader);
+        if (!EditJournalReader_end(&reader) || node < 0 || node >= nodesCount) return false;
+        return Graph_renameNode(graph, node, id);
+    }
+    case EDIT_RECORD_MOVE_NODE:
+    {
+        int node = EditJournalReader_int(&reader);
+        Vector2 position;
+        position.x = EditJournalReader_float(&reader);
+        position.y = EditJournalReader_float(&reader);
+        if (!EditJournalReader_end(&reader) || node < 0 || node >= nodesCount) return false;
+        Graph_moveNode(graph, node, position);
+        return true;
+    }
+    case EDIT_RECORD_ADD_ARC:
+    {
+        int from = EditJournalReader_int(&reader);
+        int to = EditJournalReader_int(&reader);
+        int weight = EditJournalReader_int(&reader);
+        if (!EditJournalReader_end(&reader) || from < 0 || from >= nodesCount || to < 0 || to >= nodesCount) return false;
+        Graph_addArc(graph, from, to, weight);
+        return true;
+    }
+    case EDIT_RECORD_REMOVE_ARC:
+    {
+        int arc = EditJournalReader_int(&reader);
+        if (!EditJournalReader_end(&reader) || arc < 0 || arc >= arcsCount) return false;
+        Graph_removeArc(graph, arc);
+        return true;
+    }
+    case EDIT_RECORD_SET_WEIGHT:
+    {
+        int arc = EditJournalReader_int(&reader);
+        int weight = EditJournalReader_int(&reader);
+        if (!EditJournalReader_end(&reader) || arc < 0 || arc >= arcsCount) return false;
+        Graph_setArcWeight(graph, arc, weight);
+        return true;
+    }
+    case EDIT_RECORD_PERMUTE_NODES:
+    {
+        if (EditJournalReader_int(&reader) != nodesCount || reader.size - reader.offset != nodesCount * sizeof(int32_t)) return false;
+
+        // Only a permutation of the current nodes can be applied
+        int* newIndices = (int*)malloc(maxInt(nodesCount, 1) * sizeof(int));
+        AssertNew(newIndices);
+        bool* used = (bool*)calloc(maxInt(nodesCount, 1), sizeof(bool));
+        AssertNew(used);
+        bool ok = true;
+        for (int i = 0; ok && i < nodesCount; i++) {
+            newIndices[i] = EditJournalReader_int(&reader);
+            ok = newIndices[i] >= 0 && newIndices[i] < nodesCount && !used[newIndices[i]];
+            if (ok) used[newIndices[i]] = true;
+        }
+        if (ok) Graph_permuteNodes(graph, newIndices);
+        free(newIndices);
+        free(used);
+        return ok;
+    }
+    case EDIT_RECORD_CHECKPOINT:
+        EditJournalReader_id(&reader);
+        return EditJournalReader_end(&reader);
+
+    default:
+        return false;
+    }
+}
+
+/// @brief Lit l'enregistrement suivant du journal dans *buffer.
+/// Le tampon grandit au fil de la lecture : une taille corrompue ne provoque
+/// pas d'allocation plus grande que la fin du fichier.
+/// @return false à la fin du journal, ou si l'enregistrement est incomplet ou corrompu.
+static bool EditJournal_readRecord(FILE* file, char** buffer, size_t* capacity, uint32_t* size) {
+    EditJournalRecordHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.size < sizeof(int32_t)) return false;
+
+    for (size_t read = 0; read < header.size;) {
+        if (read == *capacity) {
+            size_t grown = *capacity > 0 ? 2 * *capacity : 256;
+            *capacity = grown < header.size ? grown : header.size;
+            *buffer = (char*)realloc(*buffer, *capacity);
+            AssertNew(*buffer);
+        }
+        size_t count = (*capacity < header.size ? *capacity : header.size) - read;
+        if (fread(*buffer + read, 1, count, file) != count) return false;
+        read += count;
+    }
+    *size = header.size;
+    return (uint32_t)EditJournal_hash(FNV_OFFSET, *buffer, header.size) == header.checksum;
+}
+
+/// @brief Réapplique au graphe les enregistrements du journal existant.
+/// Le journal est réécrit s'il contient des enregistrements qui ne doivent
+/// plus être rejoués (fin incomplète, enregistrements déjà compris dans
+/// l'instantané).
+static void EditJournal_replay(EditJournal* journal) {
+    FILE* file = fopen(journal->fileName, "rb");
+    if (file == NULL) return;
+
+    EditJournalHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1
+        || header.magic != EDIT_JOURNAL_MAGIC || header.version != EDIT_JOURNAL_VERSION) {
+        fprintf(stderr, "Invalid journal %s, ignored\n", journal->fileName);
+        fclose(file);
+        return;
+    }
+
+    char* buffer = NULL;
+    size_t capacity = 0;
+    uint32_t size;
+
+    // First pass : finds the end of the valid records and the last checkpoint
+    // of a compaction that wrote the current snapshot
+    uint64_t end = sizeof(header);
+    uint64_t checkpoint = 0;
+    while (EditJournal_readRecord(file, &buffer, &capacity, &size)) {
+        end += sizeof(EditJournalRecordHeader) + size;
+        EditJournalReader reader = { buffer, size, 0, true };
+        if (EditJournalReader_int(&reader) == EDIT_RECORD_CHECKPOINT
+            && EditJournalReader_id(&reader) == journal->snapshotId && EditJournalReader_end(&reader)) {
+            checkpoint = end;
+        }
+    }
+    bool complete = fseek(file, 0, SEEK_END) == 0 && (uint64_t)ftell(file) == end;
+
+    uint64_t begin = sizeof(header);
+    bool matches = header.snapshotSize == journal->snapshotSize && header.snapshotId == journal->snapshotId;
+    if (!matches) {
+        if (checkpoint == 0) {
+            fprintf(stderr, "Journal %s does not match %s, ignored\n", journal->fileName, journal->graph->fileName);
+            fclose(file);
+            free(buffer);
+            return;
+        }
+        // The compaction of this checkpoint has replaced the snapshot, but not
+        // the journal yet
+        begin = checkpoint;
+    }
+
+    // Second pass : applies the records
+    uint64_t applied = begin;
+    fseek(file, (long)begin, SEEK_SET);
+    while (applied < end && EditJournal_readRecord(file, &buffer, &capacity, &size)) {
+        if (!EditJournal_apply(journal->graph, buffer, size)) {
+            fprintf(stderr, "Invalid record in journal %s, the next edits are ignored\n", journal->fileName);
+            complete = false;
+            break;
+        }
+        applied += sizeof(EditJournalRecordHeader) + size;
+    }
+    fclose(file);
+    free(buffer);
+
+    if (matches && complete) {
+        journal->file = fopen(journal->fileName, "ab");
+        journal->size = end;
+        journal->base = sizeof(header);
+    } else if (applied > begin) {
+        // If the rewrite fails, it is tried again before the next records are written
+        journal->base = begin;
+        journal->size = applied;
+        EditJournal_rewrite(journal, begin, applied);
+    }
+    // Otherwise nothing is kept, the journal is replaced by the first commit
+}
+
+EditJournal* EditJournal_open(Graph* graph) {
+    assert(graph && graph->fileName);
+
+    uint64_t snapshotSize, snapshotId;
+    if (!EditJournal_identify(graph, &snapshotSize, &snapshotId)) {
+        fprintf(stderr, "Error reading file %s\n", graph->fileName);
+        return NULL;
+    }
+
+    EditJournal* journal = (EditJournal*)calloc(1, sizeof(EditJournal));
+    AssertNew(journal);
+    journal->graph = graph;
+    journal->fileName = EditJournal_concat(graph->fileName, EDIT_JOURNAL_EXTENSION);
+    journal->snapshotSize = snapshotSize;
+    journal->snapshotId = snapshotId;
+
+    // The replayed edits are not recorded again
+    EditJournal_replay(journal);
+    Graph_addObserver(graph, EditJournal_onEdit, journal);
+    return journal;
+}
+
+/// @brief Réécrit le journal si son en-tête ne décrit pas l'instantané actuel
+/// (journal pas encore créé, ou réécriture précédente qui a échoué).
+/// @return true si l'en-tête du journal décrit l'instantané actuel.
+static bool EditJournal_settle(EditJournal* journal) {
+    if (journal->file != NULL && journal->base == sizeof(EditJournalHeader)) return true;
+    return EditJournal_rewrite(journal, journal->base, journal->size);
+}
+
+/// @brief Ajoute au journal les enregistrements en attente et le force sur le disque.
+static bool EditJournal_appendPending(EditJournal* journal) {
+    // While a rewrite fails, the records are added to the old journal, which
+    // stays valid as long as no other checkpoint is added to it
+    if (!EditJournal_settle(journal) && journal->file == NULL) return false;
+
+    size_t pendingSize = journal->pendingSize;
+    bool ok = pendingSize == 0 || fwrite(journal->pending, 1, pendingSize, journal->file) == pendingSize;
+    ok = ok && Platform_syncFile(journal->file);
+    if (!ok) {
+        fprintf(stderr, "Error writing file %s\n", journal->fileName);
+        // Drops what may have been written, the records stay pending
+        EditJournal_rewrite(journal, journal->base, journal->size);
+        return false;
+    }
+    journal->size += pendingSize;
+    journal->pendingSize = 0;
+    return true;
+}
+
+static void EditJournal_writeSnapshot(void* context) {
+    EditJournalCompaction* compaction = (EditJournalCompaction*)context;
+    Graph* snapshot = compaction->snapshot;
+
+    // The new snapshot is identified without being read again
+    compaction->ok = Graph_saveAsSnapshot(snapshot, snapshot->fileName, snapshot->binaryFile, compaction->checkpointId, NULL)
+        && EditJournal_identify(snapshot, &compaction->snapshotSize, &compaction->snapshotId);
+    assert(!compaction->ok || compaction->snapshotId == compaction->checkpointId);
+    Atomic_store64(&compaction->done, 1);
+}
+
+static void EditJournal_finishCompaction(EditJournal* journal) {
+    EditJournalCompaction* compaction = journal->compaction;
+    // Joining the thread makes its results visible here
+    Platform_joinThread(compaction->thread);
+
+    if (compaction->ok) {
+        // The records before the checkpoint are now in the snapshot. If the
+        // rewrite fails, the old journal stays valid since its last checkpoint
+        // is found when it is replayed : the rewrite is tried again before the
+        // next records are written, and no compaction starts until it succeeds
+        journal->snapshotSize = compaction->snapshotSize;
+        journal->snapshotId = compaction->snapshotId;
+        journal->base = journal->checkpoint;
+        EditJournal_rewrite(journal, journal->checkpoint, journal->size);
+    }
+
+    Graph_destroy(compaction->snapshot);
+    free(compaction);
+    journal->compaction = NULL;
+}
+
+bool EditJournal_compact(EditJournal* journal) {
+    assert(journal);
+    if (journal->compaction != NULL || journal->pendingSize > 0) return false;
+    if (!EditJournal_settle(journal)) return false;
+
+    // The checkpoint marks the state written into the new snapshot, and holds
+    // the id the snapshot will have : only this snapshot resumes from it
+    Graph* graph = journal->graph;
+    uint64_t checkpointId = graph->binaryFile ? Graph_newSnapshotId() : Graph_fingerprint(graph);
+    size_t record = EditJournal_beginRecord(journal, EDIT_RECORD_CHECKPOINT);
+    EditJournal_putId(journal, checkpointId);
+    EditJournal_endRecord(journal, record);
+    if (!EditJournal_appendPending(journal)) {
+        journal->pendingSize = 0;
+        return false;
+    }
+    journal->checkpoint = journal->size;
+
+    EditJournalCompaction* compaction = (EditJournalCompaction*)calloc(1, sizeof(EditJournalCompaction));
+    AssertNew(compaction);
+    compaction->snapshot = Graph_snapshot(graph);
+    compaction->checkpointId = checkpointId;
+    journal->compaction = compaction;
+
+    compaction->thread = Platform_startThread(EditJournal_writeSnapshot, compaction);
+    if (compaction->thread == NULL) {
+        // Without a thread, the snapshot is written on the calling thread
+        EditJournal_writeSnapshot(compaction);
+    }
+    return true;
+}
+
+bool EditJournal_commit(EditJournal* journal) {
+    assert(journal);
+    if (!EditJournal_appendPending(journal)) return false;
+
+    uint64_t recordsSize = journal->size - sizeof(EditJournalHeader);
+    if (journal->compaction == NULL && recordsSize > EDIT_JOURNAL_MIN_COMPACT_SIZE && recordsSize > journal->snapshotSize / 2) {
+        EditJournal_compact(journal);
+    }
+    return true;
+}
+
+void EditJournal_update(EditJournal* journal) {
+    assert(journal);
+    if (journal->compaction != NULL && Atomic_load64(&journal->compaction->done) != 0) {
+        EditJournal_finishCompaction(journal);
+    }
+}
+
+bool EditJournal_isCompacting(EditJournal* journal) {
+    assert(journal);
+    return journal->compaction != NULL;
+}
+
+void EditJournal_close(EditJournal* journal) {
+    if (journal == NULL) return;
+
+    if (journal->compaction != NULL) {
+        EditJournal_finishCompaction(journal);
+    }
+    Graph_removeObserver(journal->graph, EditJournal_onEdit, journal);
+    if (journal->file != NULL) {
+        fclose(journal->file);
+    }
+    free(journal->pending);
+    free(journal->fileName);
+    free(journal);
+}
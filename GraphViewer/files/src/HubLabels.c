@@ -0,0 +1,576 @@
+#include "HubLabels.h"
+#include "PriorityQueue.h"
+#include "Platform.h"
+
+#include <limits.h>
+
+#ifdef PLATFORM_AVX2
+#  include <immintrin.h>
+#endif
+
+#define HUB_FILE_MAGIC 0x4C485647u // "GVHL"
+#define HUB_FILE_VERSION 2
+
+/// @brief Etiquette en cours de construction, triée par rang de hub.
+typedef struct HubLabel {
+    int* hubs;
+    float* distances;
+    int count;
+    int capacity;
+} HubLabel;
+
+static void HubLabel_append(HubLabel* label, int hub, float distance) {
+    if (label->count == label->capacity) {
+        label->capacity = maxInt(4, 2 * label->capacity);
+        label->hubs = (int*)realloc(label->hubs, label->capacity * sizeof(int));
+        AssertNew(label->hubs);
+        label->distances = (float*)realloc(label->distances, label->capacity * sizeof(float));
+        AssertNew(label->distances);
+    }
+    label->hubs[label->count] = hub;
+    label->distances[label->count] = distance;
+    label->count++;
+}
+
+/// @brief Etat d'une recherche élaguée, propre à chaque thread.
+typedef struct HubSearch {
+    float* distances;
+    int* touched;
+    IndexedHeap* heap;
+
+    /// @brief Distances entre le hub de la recherche et les hubs de sa propre
+    /// étiquette, indexées par rang (INFINITY ailleurs).
+    float* hubDistances;
+} HubSearch;
+
+/// @brief Sommets atteints par une recherche et leurs distances.
+typedef HubLabel HubResult;
+
+/// @brief Données partagées par les recherches d'un groupe de hubs.
+typedef struct HubBuilder {
+    Graph* graph;
+
+    /// @brief Sommet de chaque rang.
+    int* order;
+
+    /// @brief Etiquettes sortantes (indice 0) et entrantes (indice 1) de chaque sommet.
+    HubLabel* labels[2];
+
+    HubSearch* searches;
+
+    /// @brief Résultats des deux recherches de chaque hub du groupe.
+    HubResult* results;
+
+    /// @brief Rang du premier hub du groupe.
+    int batchFirst;
+} HubBuilder;
+
+/// @brief Recherche vers l'avant (index pair) ou vers l'arrière (index impair)
+/// depuis un hub du groupe. Les étiquettes ne sont que lues.
+static void HubLabels_searchTask(void* context, int index, int worker) {
+    HubBuilder* builder = (HubBuilder*)context;
+    HubSearch* search = &builder->searches[worker];
+    HubResult* result = &builder->results[index];
+    Graph* graph = builder->graph;
+
+    // Forward searches compute d(hub, u) and fill the in-labels,
+    // backward searches compute d(u, hub) and fill the out-labels
+    bool backward = index % 2 == 1;
+    const HubLabel* sourceLabels = builder->labels[backward ? 1 : 0];
+    const HubLabel* targetLabels = builder->labels[backward ? 0 : 1];
+    int hub = builder->order[builder->batchFirst + index / 2];
+
+    const HubLabel* own = &sourceLabels[hub];
+    for (int i = 0; i < own->count; i++) {
+        search->hubDistances[own->hubs[i]] = own->distances[i];
+    }
+
+    int touchedCount = 0;
+    result->count = 0;
+    search->distances[hub] = 0.0f;
+    search->touched[touchedCount++] = hub;
+    IndexedHeap_push(search->heap, hub, 0.0f);
+
+    while (!IndexedHeap_isEmpty(search->heap)) {
+        int currID = IndexedHeap_pop(search->heap);
+        float currDist = search->distances[currID];
+
+        // Pruned when an earlier hub already gives this distance
+        const HubLabel* label = &targetLabels[currID];
+        bool covered = false;
+        for (int i = 0; i < label->count && !covered; i++) {
+            covered = search->hubDistances[label->hubs[i]] + label->distances[i] <= currDist;
+        }
+        if (covered) continue;
+
+        HubLabel_append(result, currID, currDist);
+
+        int arcBegin = backward ? Graph_inArcBegin(graph, currID) : Graph_arcBegin(graph, currID);
+        int arcEnd = backward ? Graph_inArcEnd(graph, currID) : Graph_arcEnd(graph, currID);
+        for (int arc = arcBegin; arc < arcEnd; arc++) {
+            int nextID = backward ? Graph_inArcSource(graph, arc) : Graph_arcTarget(graph, arc);
+            int weight = backward ? Graph_inArcWeight(graph, arc) : Graph_arcWeight(graph, arc);
+
+            float dist = currDist + weight;
+            if (dist < search->distances[nextID]) {
+                if (isinf(search->distances[nextID])) {
+                    search->touched[touchedCount++] = nextID;
+                }
+                search->distances[nextID] = dist;
+                IndexedHeap_push(search->heap, nextID, dist);
+            }
+        }
+    }
+
+    for (int i = 0; i < touchedCount; i++) {
+        search->distances[search->touched[i]] = INFINITY;
+    }
+    for (int i = 0; i < own->count; i++) {
+        search->hubDistances[own->hubs[i]] = INFINITY;
+    }
+}
+
+static int UInt64_compare(const void* a, const void* b) {
+    uint64_t first = *(const uint64_t*)a;
+    uint64_t second = *(const uint64_t*)b;
+    return first < second ? -1 : (first > second);
+}
+
+/// @brief Classe les sommets par produit décroissant de leurs degrés.
+static int* HubLabels_order(Graph* graph) {
+    int size = Graph_size(graph);
+
+    uint64_t* keys = (uint64_t*)malloc(maxInt(size, 1) * sizeof(uint64_t));
+    AssertNew(keys);
+    for (int u = 0; u < size; u++) {
+        uint64_t outDegree = Graph_arcEnd(graph, u) - Graph_arcBegin(graph, u);
+        uint64_t inDegree = Graph_inArcEnd(graph, u) - Graph_inArcBegin(graph, u);
+        uint64_t score = (outDegree + 1) * (inDegree + 1);
+        score = score < UINT32_MAX ? score : UINT32_MAX;
+        keys[u] = ((UINT32_MAX - score) << 32) | (uint32_t)u;
+    }
+    qsort(keys, size, sizeof(uint64_t), UInt64_compare);
+
+    int* order = (int*)malloc(maxInt(size, 1) * sizeof(int));
+    AssertNew(order);
+    for (int i = 0; i < size; i++) {
+        order[i] = (int)(uint32_t)keys[i];
+    }
+    free(keys);
+    return order;
+}
+
+/// @brief Recopie les étiquettes construites dans les tableaux de l'index.
+static void HubLabels_flatten(const HubLabel* source, int size, int64_t** offsets, int** hubs, float** distances) {
+    *offsets = (int64_t*)malloc((size + 1) * sizeof(int64_t));
+    AssertNew(*offsets);
+    (*offsets)[0] = 0;
+    for (int v = 0; v < size; v++) {
+        (*offsets)[v + 1] = (*offsets)[v] + source[v].count;
+    }
+
+    size_t total = (size_t)(*offsets)[size];
+    *hubs = (int*)malloc((total + 1) * sizeof(int));
+    AssertNew(*hubs);
+    *distances = (float*)malloc((total + 1) * sizeof(float));
+    AssertNew(*distances);
+    for (int v = 0; v < size; v++) {
+        memcpy(*hubs + (*offsets)[v], source[v].hubs, source[v].count * sizeof(int));
+        memcpy(*distances + (*offsets)[v], source[v].distances, source[v].count * sizeof(float));
+    }
+}
+
+HubLabels* HubLabels_build(Graph* graph) {
+    assert(graph);
+
+    int size = Graph_size(graph);
+    Graph_buildReverse(graph);
+
+    HubBuilder builder = { 0 };
+    builder.graph = graph;
+    builder.order = HubLabels_order(graph);
+    for (int side = 0; side < 2; side++) {
+        builder.labels[side] = (HubLabel*)calloc(maxInt(size, 1), sizeof(HubLabel));
+        AssertNew(builder.labels[side]);
+    }
+    builder.results = (HubResult*)calloc(2 * HUB_LABELS_MAX_BATCH, sizeof(HubResult));
+    AssertNew(builder.results);
+
+    int workers = Platform_workerCount(2 * HUB_LABELS_MAX_BATCH);
+    builder.searches = (HubSearch*)calloc(workers, sizeof(HubSearch));
+    AssertNew(builder.searches);
+    for (int w = 0; w < workers; w++) {
+        HubSearch* search = &builder.searches[w];
+        search->distances = (float*)malloc(maxInt(size, 1) * sizeof(float));
+        AssertNew(search->distances);
+        search->hubDistances = (float*)malloc(maxInt(size, 1) * sizeof(float));
+        AssertNew(search->hubDistances);
+        search->touched = (int*)malloc(maxInt(size, 1) * sizeof(int));
+        AssertNew(search->touched);
+        search->heap = IndexedHeap_create(maxInt(size, 1), 4);
+        for (int i = 0; i < size; i++) {
+            search->distances[i] = INFINITY;
+            search->hubDistances[i] = INFINITY;
+        }
+    }
+
+    while (builder.batchFirst < size) {
+        // The first hubs prune most of the later searches : they are added one
+        // by one, the batches then grow with the number of hubs already added
+        int batchSize = workers > 1 ? builder.batchFirst / 32 : 1;
+        batchSize = minInt(maxInt(batchSize, 1), HUB_LABELS_MAX_BATCH);
+        batchSize = minInt(batchSize, size - builder.batchFirst);
+
+        Platform_parallelFor(2 * batchSize, HubLabels_searchTask, &builder);
+
+        // Hubs are appended by increasing rank : the labels stay sorted
+        for (int index = 0; index < 2 * batchSize; index++) {
+            HubResult* result = &builder.results[index];
+            HubLabel* labels = builder.labels[index % 2 == 1 ? 0 : 1];
+            int rank = builder.batchFirst + index / 2;
+            for (int i = 0; i < result->count; i++) {
+                HubLabel_append(&labels[result->hubs[i]], rank, result->distances[i]);
+            }
+        }
+        builder.batchFirst += batchSize;
+    }
+
+    HubLabels* labels = (HubLabels*)calloc(1, sizeof(HubLabels));
+    AssertNew(labels);
+    labels->nodesCount = size;
+    labels->graphArcsCount = Graph_arcCount(graph);
+    labels->graphFingerprint = Graph_fingerprint(graph);
+    HubLabels_flatten(builder.labels[0], size, &labels->outOffsets, &labels->outHubs, &labels->outDistances);
+    HubLabels_flatten(builder.labels[1], size, &labels->inOffsets, &labels->inHubs, &labels->inDistances);
+
+    for (int side = 0; side < 2; side++) {
+        for (int v = 0; v < size; v++) {
+            free(builder.labels[side][v].hubs);
+            free(builder.labels[side][v].distances);
+        }
+        free(builder.labels[side]);
+    }
+    for (int index = 0; index < 2 * HUB_LABELS_MAX_BATCH; index++) {
+        free(builder.results[index].hubs);
+        free(builder.results[index].distances);
+    }
+    free(builder.results);
+    for (int w = 0; w < workers; w++) {
+        free(builder.searches[w].distances);
+        free(builder.searches[w].hubDistances);
+        free(builder.searches[w].touched);
+        IndexedHeap_destroy(builder.searches[w].heap);
+    }
+    free(builder.searches);
+    free(builder.order);
+
+    return labels;
+}
+
+void HubLabels_destroy(HubLabels* labels) {
+    if (labels == NULL) return;
+
+    free(labels->outOffsets);
+    free(labels->outHubs);
+    free(labels->outDistances);
+    free(labels->inOffsets);
+    free(labels->inHubs);
+    free(labels->inDistances);
+    free(labels);
+}
+
+bool HubLabels_matches(HubLabels* labels, Graph* graph) {
+    return labels->nodesCount == Graph_size(graph) && labels->graphArcsCount == Graph_arcCount(graph)
+        && labels->graphFingerprint == Graph_fingerprint(graph);
+}
+
+float HubLabels_averageSize(HubLabels* labels) {
+    if (labels->nodesCount == 0) return 0.0f;
+
+    int64_t total = labels->outOffsets[labels->nodesCount] + labels->inOffsets[labels->nodesCount];
+    return (float)total / (2.0f * labels->nodesCount);
+}
+
+bool HubLabels_save(HubLabels* labels, const char* fileName) {
+    FILE* file = fopen(fileName, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening file %s\n", fileName);
+        return false;
+    }
+
+    size_t offsetsCount = (size_t)labels->nodesCount + 1;
+    size_t outCount = (size_t)labels->outOffsets[labels->nodesCount];
+    size_t inCount = (size_t)labels->inOffsets[labels->nodesCount];
+    uint32_t header[4] = {
+        HUB_FILE_MAGIC, HUB_FILE_VERSION,
+        (uint32_t)labels->nodesCount, (uint32_t)labels->graphArcsCount
+    };
+    bool ok = fwrite(header, sizeof(header), 1, file) == 1;
+    ok = ok && fwrite(&labels->graphFingerprint, sizeof(uint64_t), 1, file) == 1;
+    ok = ok && fwrite(labels->outOffsets, sizeof(int64_t), offsetsCount, file) == offsetsCount;
+    ok = ok && fwrite(labels->inOffsets, sizeof(int64_t), offsetsCount, file) == offsetsCount;
+    ok = ok && fwrite(labels->outHubs, sizeof(int), outCount, file) == outCount;
+    ok = ok && fwrite(labels->outDistances, sizeof(float), outCount, file) == outCount;
+    ok = ok && fwrite(labels->inHubs, sizeof(int), inCount, file) == inCount;
+    ok = ok && fwrite(labels->inDistances, sizeof(float), inCount, file) == inCount;
+
+    fclose(file);
+    if (!ok) {
+        fprintf(stderr, "Error writing file %s\n", fileName);
+    }
+    return ok;
+}
+
+/// @brief Vérifie que les bornes d'étiquettes lues dans un fichier sont
+/// croissantes et ne dépassent pas le nombre de couples que le fichier peut contenir.
+static bool HubLabels_validOffsets(const int64_t* offsets, int size, uint64_t maxCount) {
+    if (offsets[0] != 0) return false;
+    for (int v = 0; v < size; v++) {
+        if (offsets[v + 1] < offsets[v]) return false;
+    }
+    return (uint64_t)offsets[size] <= maxCount;
+}
+
+/// @brief Vérifie que chaque étiquette ne contient que des rangs de sommets,
+/// strictement croissants comme l'exige la fusion des requêtes.
+static bool HubLabels_validLabels(const int64_t* offsets, const int* hubs, const float* distances, int size) {
+    for (int v = 0; v < size; v++) {
+        for (int64_t i = offsets[v]; i < offsets[v + 1]; i++) {
+            if (hubs[i] < 0 || hubs[i] >= size || (i > offsets[v] && hubs[i] <= hubs[i - 1])) return false;
+            if (!(distances[i] >= 0.0f)) return false;
+        }
+    }
+    return true;
+}
+
+HubLabels* HubLabels_load(const char* fileName) {
+    FILE* file = fopen(fileName, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    uint32_t header[4];
+    uint64_t fingerprint;
+    if (fread(header, sizeof(header), 1, file) != 1 || fread(&fingerprint, sizeof(fingerprint), 1, file) != 1
+        || header[0] != HUB_FILE_MAGIC || header[1] != HUB_FILE_VERSION
+        || header[2] > INT_MAX || header[3] > INT_MAX) {
+        fprintf(stderr, "Invalid hub label file %s\n", fileName);
+        fclose(file);
+        return NULL;
+    }
+
+    // The sizes of the header are checked against the file before the arrays are allocated
+    size_t offsetsCount = (size_t)header[2] + 1;
+    uint64_t remaining = Platform_remainingBytes(file);
+    if (remaining < 2 * offsetsCount * sizeof(int64_t)) {
+        fprintf(stderr, "Truncated hub label file %s\n", fileName);
+        fclose(file);
+        return NULL;
+    }
+    remaining -= 2 * offsetsCount * sizeof(int64_t);
+
+    HubLabels* labels = (HubLabels*)calloc(1, sizeof(HubLabels));
+    AssertNew(labels);
+    labels->nodesCount = (int)header[2];
+    labels->graphArcsCount = (int)header[3];
+    labels->graphFingerprint = fingerprint;
+
+    labels->outOffsets = (int64_t*)malloc(offsetsCount * sizeof(int64_t));
+    AssertNew(labels->outOffsets);
+    labels->inOffsets = (int64_t*)malloc(offsetsCount * sizeof(int64_t));
+    AssertNew(labels->inOffsets);
+
+    // Each pair takes a hub and a distance
+    uint64_t maxCount = remaining / (sizeof(int) + sizeof(float));
+    bool ok = fread(labels->outOffsets, sizeof(int64_t), offsetsCount, file) == offsetsCount;
+    ok = ok && fread(labels->inOffsets, sizeof(int64_t), offsetsCount, file) == offsetsCount;
+    ok = ok && HubLabels_validOffsets(labels->outOffsets, labels->nodesCount, maxCount);
+    ok = ok && HubLabels_validOffsets(labels->inOffsets, labels->nodesCount, maxCount - (uint64_t)labels->outOffsets[labels->nodesCount]);
+
+    if (ok) {
+        size_t outCount = (size_t)labels->outOffsets[labels->nodesCount];
+        size_t inCount = (size_t)labels->inOffsets[labels->nodesCount];
+        labels->outHubs = (int*)malloc((outCount + 1) * sizeof(int));
+        AssertNew(labels->outHubs);
+        labels->outDistances = (float*)malloc((outCount + 1) * sizeof(float));
+        AssertNew(labels->outDistances);
+        labels->inHubs = (int*)malloc((inCount + 1) * sizeof(int));
+        AssertNew(labels->inHubs);
+        labels->inDistances = (float*)malloc((inCount + 1) * sizeof(float));
+        AssertNew(labels->inDistances);
+
+        ok = fread(labels->outHubs, sizeof(int), outCount, file) == outCount;
+        ok = ok && fread(labels->outDistances, sizeof(float), outCount, file) == outCount;
+        ok = ok && fread(labels->inHubs, sizeof(int), inCount, file) == inCount;
+        ok = ok && fread(labels->inDistances, sizeof(float), inCount, file) == inCount;
+        ok = ok && HubLabels_validLabels(labels->outOffsets, labels->outHubs, labels->outDistances, labels->nodesCount);
+        ok = ok && HubLabels_validLabels(labels->inOffsets, labels->inHubs, labels->inDistances, labels->nodesCount);
+    }
+    fclose(file);
+
+    if (!ok) {
+        fprintf(stderr, "Invalid hub label file %s\n", fileName);
+        HubLabels_destroy(labels);
+        return NULL;
+    }
+    return labels;
+}
+
+HubLabels* HubLabels_loadOrBuild(Graph* graph, const char* fileName) {
+    HubLabels* labels = HubLabels_load(fileName);
+    if (labels != NULL && HubLabels_matches(labels, graph)) {
+        return labels;
+    }
+    HubLabels_destroy(labels);
+
+    labels = HubLabels_build(graph);
+    HubLabels_save(labels, fileName);
+    return labels;
+}
+
+#ifdef PLATFORM_AVX2
+/// @brief Début AVX2 de la fusion de HubLabels_distance() : compare les hubs
+/// par blocs de 8 tant que les deux étiquettes en ont, et avance *i et *j.
+/// @return La plus petite distance trouvée, INFINITY si aucun hub commun.
+PLATFORM_AVX2_TARGET static float HubLabels_mergeAvx2(const int* outHubs, const float* outDistances, int64_t outCount,
+    const int* inHubs, const float* inDistances, int64_t inCount, int64_t* i, int64_t* j) {
+    // Blocks of 8 hubs are compared with the 8 rotations of the other block.
+    // The block whose last hub is smaller cannot match anything further
+    __m256 bestBlock = _mm256_set1_ps(INFINITY);
+    __m256 infinity = _mm256_set1_ps(INFINITY);
+    __m256i rotation = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    while (*i + 8 <= outCount && *j + 8 <= inCount) {
+        __m256i outBlock = _mm256_loadu_si256((const __m256i*)(outHubs + *i));
+        __m256 outDist = _mm256_loadu_ps(outDistances + *i);
+        __m256i inBlock = _mm256_loadu_si256((const __m256i*)(inHubs + *j));
+        __m256 inDist = _mm256_loadu_ps(inDistances + *j);
+
+        for (int r = 0; r < 8; r++) {
+            __m256 equal = _mm256_castsi256_ps(_mm256_cmpeq_epi32(outBlock, inBlock));
+            __m256 sum = _mm256_add_ps(outDist, inDist);
+            bestBlock = _mm256_min_ps(bestBlock, _mm256_blendv_ps(infinity, sum, equal));
+            inBlock = _mm256_permutevar8x32_epi32(inBlock, rotation);
+            inDist = _mm256_permutevar8x32_ps(inDist, rotation);
+        }
+
+        int lastOut = outHubs[*i + 7];
+        int lastIn = inHubs[*j + 7];
+        if (lastOut <= lastIn) *i += 8;
+        if (lastIn <= lastOut) *j += 8;
+    }
+
+    float lanes[8];
+    _mm256_storeu_ps(lanes, bestBlock);
+    float best = INFINITY;
+    for (int k = 0; k < 8; k++) {
+        best = fminf(best, lanes[k]);
+    }
+    return best;
+}
+#endif
+
+float HubLabels_distance(const HubLabels* labels, int start, int end) {
+    assert(labels && start >= 0 && start < labels->nodesCount && end >= 0 && end < labels->nodesCount);
+
+    const int* outHubs = labels->outHubs + labels->outOffsets[start];
+    const float* outDistances = labels->outDistances + labels->outOffsets[start];
+    int64_t outCount = labels->outOffsets[start + 1] - labels->outOffsets[start];
+    const int* inHubs = labels->inHubs + labels->inOffsets[end];
+    const float* inDistances = labels->inDistances + labels->inOffsets[end];
+    int64_t inCount = labels->inOffsets[end + 1] - labels->inOffsets[end];
+
+    float best = INFINITY;
+    int64_t i = 0;
+    int64_t j = 0;
+
+#ifdef PLATFORM_AVX2
+    if (Platform_hasAvx2()) {
+        best = HubLabels_mergeAvx2(outHubs, outDistances, outCount, inHubs, inDistances, inCount, &i, &j);
+    }
+#endif
+
+    while (i < outCount && j < inCount) {
+        if (outHubs[i] < inHubs[j]) {
+            i++;
+        } else if (outHubs[i] > inHubs[j]) {
+            j++;
+        } else {
+            best = fminf(best, outDistances[i] + inDistances[j]);
+            i++;
+            j++;
+        }
+    }
+    return best;
+}
+
+/// @brief Indique si node apparaît parmi les sommets déjà placés sur le chemin.
+static bool HubLabels_pathContains(const Path* path, int node) {
+    for (int i = 0; i < path->length; i++) {
+        if (path->nodes[i] == node) return true;
+    }
+    return false;
+}
+
+Path* HubLabels_shortestPath(const HubLabels* labels, Graph* graph, int start, int end, ShortestPathStats* stats) {
+    assert(labels && graph && labels->nodesCount == Graph_size(graph));
+
+    int queriesCount = 1;
+    float distance = HubLabels_distance(labels, start, end);
+    if (isinf(distance)) {
+        if (stats != NULL) {
+            stats->settledCount = queriesCount;
+        }
+        return NULL;
+    }
+
+    Path* path = Path_create(start);
+    int currID = start;
+    float remaining = distance;
+    while (currID != end) {
+        int next = -1;
+        float nextRemaining = 0.0f;
+
+        int arcEnd = Graph_arcEnd(graph, currID);
+        for (int arc = Graph_arcBegin(graph, currID); arc < arcEnd && next < 0; arc++) {
+            int nextID = Graph_arcTarget(graph, arc);
+            int weight = Graph_arcWeight(graph, arc);
+            if (weight > remaining) continue;
+
+            // A zero-weight arc may lead back to a node of the path
+            if (weight == 0 && HubLabels_pathContains(path, nextID)) continue;
+
+            queriesCount++;
+            float nextDistance = HubLabels_distance(labels, nextID, end);
+            if (weight + nextDistance == remaining) {
+                next = nextID;
+                nextRemaining = nextDistance;
+            }
+        }
+
+        if (next < 0) {
+            // Zero-weight cycles can hide the way out : a plain search decides
+            Path_destroy(path);
+            int* predecessors = (int*)malloc(Graph_size(graph) * sizeof(int));
+            AssertNew(predecessors);
+            float* distances = (float*)malloc(Graph_size(graph) * sizeof(float));
+            AssertNew(distances);
+            Graph_dijkstra(graph, start, end, predecessors, distances, NULL);
+            path = Graph_dijkstraGetPath(graph, predecessors, distances, end);
+            free(predecessors);
+            free(distances);
+            break;
+        }
+
+        Path_append(path, next);
+        currID = next;
+        remaining = nextRemaining;
+    }
+
+    if (path != NULL) {
+        path->distance = distance;
+    }
+    if (stats != NULL) {
+        stats->settledCount = queriesCount;
+    }
+    return path;
+}
@@ -0,0 +1,147 @@
+#include "IdIndex.h"
+
+uint32_t IdIndex_hash(const char* id) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* c = (const unsigned char*)id; *c != '\0'; c++) {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void IdIndex_allocate(IdIndex* index, int capacity) {
+    index->slots = (int*)malloc(capacity * sizeof(int));
+    AssertNew(index->slots);
+    index->hashes = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+    AssertNew(index->hashes);
+
+    for (int i = 0; i < capacity; i++) {
+        index->slots[i] = -1;
+    }
+    index->capacity = capacity;
+    index->count = 0;
+}
+
+static void IdIndex_place(IdIndex* index, uint32_t hash, int nodeIndex) {
+    int mask = index->capacity - 1;
+    int slot = (int)(hash & mask);
+    while (index->slots[slot] >= 0) {
+        slot = (slot + 1) & mask;
+    }
+    index->slots[slot] = nodeIndex;
+    index->hashes[slot] = hash;
+    index->count++;
+}
+
+void IdIndex_rebuild(IdIndex* index, char** ids, int count) {
+    // Load factor kept under 1/2
+    int capacity = 16;
+    while (capacity < 2 * count) {
+        capacity *= 2;
+    }
+
+    if (capacity != index->capacity) {
+        IdIndex_free(index);
+        IdIndex_allocate(index, capacity);
+    } else {
+        for (int i = 0; i < capacity; i++) {
+            index->slots[i] = -1;
+        }
+        index->count = 0;
+    }
+
+    for (int i = 0; i < count; i++) {
+        IdIndex_place(index, IdIndex_hash(ids[i]), i);
+    }
+}
+
+void IdIndex_free(IdIndex* index) {
+    free(index->slots);
+    free(index->hashes);
+    index->slots = NULL;
+    index->hashes = NULL;
+    index->capacity = 0;
+    index->count = 0;
+}
+
+int IdIndex_find(const IdIndex* index, char** ids, const char* id) {
+    if (index->capacity == 0) {
+        return -1;
+    }
+
+    uint32_t hash = IdIndex_hash(id);
+    int mask = index->capacity - 1;
+    for (int slot = (int)(hash & mask); index->slots[slot] >= 0; slot = (slot + 1) & mask) {
+        if (index->hashes[slot] == hash && strcmp(ids[index->slots[slot]], id) == 0) {
+            return index->slots[slot];
+        }
+    }
+    return -1;
+}
+
+int IdIndex_findPacked(const IdIndex* index, const char* strings, const int64_t* offsets, const char* id) {
+    if (index->capacity == 0) {
+        return -1;
+    }
+
+    uint32_t hash = IdIndex_hash(id);
+    int mask = index->capacity - 1;
+    for (int slot = (int)(hash & mask); index->slots[slot] >= 0; slot = (slot + 1) & mask) {
+        if (index->hashes[slot] == hash && strcmp(strings + offsets[index->slots[slot]], id) == 0) {
+            return index->slots[slot];
+        }
+    }
+    return -1;
+}
+
+void IdIndex_insert(IdIndex* index, char** ids, int nodeIndex) {
+    if (2 * (index->count + 1) > index->capacity) {
+        // Grow and re-insert every stored id, nodeIndex included
+        int capacity = index->capacity > 0 ? 2 * index->capacity : 16;
+        int* oldSlots = index->slots;
+        uint32_t* oldHashes = index->hashes;
+        int oldCapacity = index->capacity;
+
+        IdIndex_allocate(index, capacity);
+        for (int i = 0; i < oldCapacity; i++) {
+            if (oldSlots[i] >= 0) {
+                IdIndex_place(index, oldHashes[i], oldSlots[i]);
+            }
+        }
+        free(oldSlots);
+        free(oldHashes);
+    }
+    IdIndex_place(index, IdIndex_hash(ids[nodeIndex]), nodeIndex);
+}
+
+void IdIndex_remove(IdIndex* index, char** ids, int nodeIndex) {
+    if (index->capacity == 0) {
+        return;
+    }
+
+    uint32_t hash = IdIndex_hash(ids[nodeIndex]);
+    int mask = index->capacity - 1;
+    int slot = (int)(hash & mask);
+    while (index->slots[slot] != nodeIndex) {
+        if (index->slots[slot] < 0) {
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    // Backward shift deletion : the entries following the hole are moved
+    // back when their home slot allows it, so no tombstone is needed
+    int hole = slot;
+    for (int next = (hole + 1) & mask; index->slots[next] >= 0; next = (next + 1) & mask) {
+        int home = (int)(index->hashes[next] & mask);
+        int distanceNext = (next - home) & mask;
+        int distanceHole = (hole - home) & mask;
+        if (distanceHole <= distanceNext) {
+            index->slots[hole] = index->slots[next];
+            index->hashes[hole] = index->hashes[next];
+            hole = next;
+        }
+    }
+    index->slots[hole] = -1;
+    index->count--;
+}
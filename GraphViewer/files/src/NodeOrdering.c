@@ -0,0 +1,221 @@
+#include "NodeOrdering.h"
+
+/// @brief Côté de la grille sur laquelle est tracée la courbe de Hilbert.
+#define HILBERT_SIDE 65536
+
+static NodePermutation* NodePermutation_create(int count) {
+    NodePermutation* permutation = (NodePermutation*)calloc(1, sizeof(NodePermutation));
+    AssertNew(permutation);
+    permutation->count = count;
+    permutation->newIndices = (int*)malloc(maxInt(count, 1) * sizeof(int));
+    AssertNew(permutation->newIndices);
+    permutation->oldIndices = (int*)malloc(maxInt(count, 1) * sizeof(int));
+    AssertNew(permutation->oldIndices);
+    return permutation;
+}
+
+static int UInt64_compare(const void* a, const void* b) {
+    uint64_t first = *(const uint64_t*)a;
+    uint64_t second = *(const uint64_t*)b;
+    return first < second ? -1 : (first > second);
+}
+
+static int NodeOrder_degree(Graph* graph, int node) {
+    return Graph_arcEnd(graph, node) - Graph_arcBegin(graph, node)
+        + Graph_inArcEnd(graph, node) - Graph_inArcBegin(graph, node);
+}
+
+/// @brief Parcours en largeur non orienté depuis chaque sommet de starts non
+/// encore visité. Les sommets sont rangés dans oldIndices par ordre de découverte.
+/// @param sortByDegree si true, les voisins de chaque sommet sont visités par
+///     degré croissant (Cuthill–McKee).
+static void NodeOrder_bfs(Graph* graph, const int* starts, bool sortByDegree, int* oldIndices) {
+    int size = Graph_size(graph);
+    Graph_buildReverse(graph);
+
+    bool* visited = (bool*)calloc(maxInt(size, 1), sizeof(bool));
+    AssertNew(visited);
+    uint64_t* keys = NULL;
+    if (sortByDegree) {
+        keys = (uint64_t*)malloc(maxInt(size, 1) * sizeof(uint64_t));
+        AssertNew(keys);
+    }
+
+    // oldIndices is the queue: the nodes before tail have been discovered
+    int tail = 0;
+    for (int s = 0; s < size; s++) {
+        int start = starts ? starts[s] : s;
+        if (visited[start]) continue;
+
+        visited[start] = true;
+        oldIndices[tail++] = start;
+        for (int head = tail - 1; head < tail; head++) {
+            int node = oldIndices[head];
+            int first = tail;
+
+            int arcEnd = Graph_arcEnd(graph, node);
+            for (int arc = Graph_arcBegin(graph, node); arc < arcEnd; arc++) {
+                int next = Graph_arcTarget(graph, arc);
+                if (!visited[next]) {
+                    visited[next] = true;
+                    oldIndices[tail++] = next;
+                }
+            }
+            int inArcEnd = Graph_inArcEnd(graph, node);
+            for (int inArc = Graph_inArcBegin(graph, node); inArc < inArcEnd; inArc++) {
+                int next = Graph_inArcSource(graph, inArc);
+                if (!visited[next]) {
+                    visited[next] = true;
+                    oldIndices[tail++] = next;
+                }
+            }
+
+            if (sortByDegree && tail - first > 1) {
+                int count = tail - first;
+                for (int i = 0; i < count; i++) {
+                    int next = oldIndices[first + i];
+                    keys[i] = ((uint64_t)NodeOrder_degree(graph, next) << 32) | (uint32_t)next;
+                }
+                qsort(keys, count, sizeof(uint64_t), UInt64_compare);
+                for (int i = 0; i < count; i++) {
+                    oldIndices[first + i] = (int)(uint32_t)keys[i];
+                }
+            }
+        }
+    }
+
+    free(visited);
+    free(keys);
+}
+
+/// @brief Renvoie les sommets triés par degré croissant (tri par dénombrement).
+static int* NodeOrder_sortByDegree(Graph* graph) {
+    int size = Graph_size(graph);
+    Graph_buildReverse(graph);
+
+    int maxDegree = 0;
+    for (int u = 0; u < size; u++) {
+        maxDegree = maxInt(maxDegree, NodeOrder_degree(graph, u));
+    }
+    int* offsets = (int*)calloc(maxDegree + 2, sizeof(int));
+    AssertNew(offsets);
+    for (int u = 0; u < size; u++) {
+        offsets[NodeOrder_degree(graph, u) + 1]++;
+    }
+    for (int d = 0; d <= maxDegree; d++) {
+        offsets[d + 1] += offsets[d];
+    }
+
+    int* nodes = (int*)malloc(maxInt(size, 1) * sizeof(int));
+    AssertNew(nodes);
+    for (int u = 0; u < size; u++) {
+        nodes[offsets[NodeOrder_degree(graph, u)]++] = u;
+    }
+    free(offsets);
+    return nodes;
+}
+
+/// @brief Position de (x, y) le long de la courbe de Hilbert d'une grille
+/// HILBERT_SIDE x HILBERT_SIDE.
+static uint32_t Hilbert_index(uint32_t x, uint32_t y) {
+    uint32_t index = 0;
+    for (uint32_t s = HILBERT_SIDE / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        index += s * s * ((3 * rx) ^ ry);
+
+        // Rotates the quadrant so that the curve stays continuous
+        if (ry == 0) {
+            if (rx == 1) {
+                x = HILBERT_SIDE - 1 - x;
+                y = HILBERT_SIDE - 1 - y;
+            }
+            uint32_t swap = x;
+            x = y;
+            y = swap;
+        }
+    }
+    return index;
+}
+
+static void NodeOrder_hilbert(Graph* graph, int* oldIndices) {
+    int size = Graph_size(graph);
+    if (size == 0) return;
+
+    Vector2 min = Graph_getNodePosition(graph, 0);
+    Vector2 max = min;
+    for (int u = 1; u < size; u++) {
+        Vector2 position = Graph_getNodePosition(graph, u);
+        min.x = fminf(min.x, position.x);
+        min.y = fminf(min.y, position.y);
+        max.x = fmaxf(max.x, position.x);
+        max.y = fmaxf(max.y, position.y);
+    }
+    // The same scale on both axes keeps the curve square over the layout
+    float extent = fmaxf(max.x - min.x, max.y - min.y);
+    float scale = extent > 0.0f ? (HILBERT_SIDE - 1) / extent : 0.0f;
+
+    uint64_t* keys = (uint64_t*)malloc(size * sizeof(uint64_t));
+    AssertNew(keys);
+    for (int u = 0; u < size; u++) {
+        Vector2 position = Graph_getNodePosition(graph, u);
+        uint32_t x = (uint32_t)((position.x - min.x) * scale);
+        uint32_t y = (uint32_t)((position.y - min.y) * scale);
+        keys[u] = ((uint64_t)Hilbert_index(x, y) << 32) | (uint32_t)u;
+    }
+    qsort(keys, size, sizeof(uint64_t), UInt64_compare);
+    for (int i = 0; i < size; i++) {
+        oldIndices[i] = (int)(uint32_t)keys[i];
+    }
+    free(keys);
+}
+
+NodePermutation* Graph_computeOrder(Graph* graph, NodeOrder order) {
+    assert(graph);
+
+    int size = Graph_size(graph);
+    NodePermutation* permutation = NodePermutation_create(size);
+
+    switch (order) {
+    case NODE_ORDER_RCM:
+    {
+        int* starts = NodeOrder_sortByDegree(graph);
+        NodeOrder_bfs(graph, starts, true, permutation->oldIndices);
+        free(starts);
+
+        for (int i = 0, j = size - 1; i < j; i++, j--) {
+            int swap = permutation->oldIndices[i];
+            permutation->oldIndices[i] = permutation->oldIndices[j];
+            permutation->oldIndices[j] = swap;
+        }
+        break;
+    }
+    case NODE_ORDER_HILBERT:
+        NodeOrder_hilbert(graph, permutation->oldIndices);
+        break;
+
+    case NODE_ORDER_BFS:
+    default:
+        NodeOrder_bfs(graph, NULL, false, permutation->oldIndices);
+        break;
+    }
+
+    for (int i = 0; i < size; i++) {
+        permutation->newIndices[permutation->oldIndices[i]] = i;
+    }
+    return permutation;
+}
+
+NodePermutation* Graph_renumber(Graph* graph, NodeOrder order) {
+    NodePermutation* permutation = Graph_computeOrder(graph, order);
+    Graph_permuteNodes(graph, permutation->newIndices);
+    return permutation;
+}
+
+void NodePermutation_destroy(NodePermutation* permutation) {
+    if (permutation == NULL) return;
+
+    free(permutation->newIndices);
+    free(permutation->oldIndices);
+    free(permutation);
+}
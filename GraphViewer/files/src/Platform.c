@@ -0,0 +1,511 @@
+#include "Platform.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#  include <io.h>
+#else
+#  include <fcntl.h>
+#  include <libgen.h>
+#  include <pthread.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+#include <string.h>
+
+struct FileMapping {
+    void* data;
+    size_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE section;
+#endif
+};
+
+struct PlatformThread {
+    ThreadMain main;
+    void* context;
+#ifdef _WIN32
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+};
+
+typedef struct ParallelFor {
+    ParallelTask task;
+    void* context;
+    int count;
+
+    /// Next index to run, shared by all the workers
+    volatile long next;
+} ParallelFor;
+
+typedef struct ParallelWorker {
+    ParallelFor* loop;
+    int worker;
+    /// Pool the worker belongs to, NULL for Platform_parallelFor()
+    PlatformPool* pool;
+} ParallelWorker;
+
+struct PlatformPool {
+    PlatformThread** threads;
+    ParallelWorker* workers;
+    int workerCount;
+    /// Number of started threads, the calling thread excluded
+    int started;
+
+    /// Loop of the current run, numbered by generation
+    ParallelFor loop;
+    uint64_t generation;
+    /// Started threads that have not finished the current run yet
+    int running;
+    bool stopping;
+
+#ifdef _WIN32
+    SRWLOCK lock;
+    CONDITION_VARIABLE wake;
+    CONDITION_VARIABLE finished;
+#else
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t finished;
+#endif
+};
+
+static long ParallelFor_nextIndex(ParallelFor* loop) {
+#ifdef _WIN32
+    return InterlockedIncrement(&loop->next) - 1;
+#else
+    return __atomic_fetch_add(&loop->next, 1, __ATOMIC_RELAXED);
+#endif
+}
+
+static void ParallelFor_work(ParallelWorker* worker) {
+    // Indices are handed out one by one, so uneven tasks stay balanced
+    ParallelFor* loop = worker->loop;
+    for (long i = ParallelFor_nextIndex(loop); i < loop->count; i = ParallelFor_nextIndex(loop)) {
+        loop->task(loop->context, (int)i, worker->worker);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI ParallelFor_threadMain(LPVOID argument) {
+    ParallelFor_work((ParallelWorker*)argument);
+    return 0;
+}
+#else
+static void* ParallelFor_threadMain(void* argument) {
+    ParallelFor_work((ParallelWorker*)argument);
+    return NULL;
+}
+#endif
+
+#ifdef _WIN32
+static DWORD WINAPI PlatformThread_main(LPVOID argument) {
+    PlatformThread* thread = (PlatformThread*)argument;
+    thread->main(thread->context);
+    return 0;
+}
+#else
+static void* PlatformThread_main(void* argument) {
+    PlatformThread* thread = (PlatformThread*)argument;
+    thread->main(thread->context);
+    return NULL;
+}
+#endif
+
+bool Platform_hasAvx2(void) {
+    // 0 until the first call, then 1 without AVX2 and 2 with it
+    static volatile uint64_t support = 0;
+    uint64_t known = Atomic_load64(&support);
+    if (known != 0) return known == 2;
+
+    bool present = false;
+#if defined(_MSC_VER) && defined(PLATFORM_AVX2)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] >= 7) {
+        // The system must also save the AVX registers (OSXSAVE, then XCR0)
+        __cpuid(info, 1);
+        bool avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+        __cpuidex(info, 7, 0);
+        present = avx && (info[1] & (1 << 5)) != 0;
+    }
+#elif defined(PLATFORM_AVX2)
+    __builtin_cpu_init();
+    present = __builtin_cpu_supports("avx2") != 0;
+#endif
+    Atomic_store64(&support, present ? 2 : 1);
+    return present;
+}
+
+int Platform_processorCount(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
+
+int Platform_workerCount(int count) {
+    int threadCount = Platform_processorCount();
+    return count < threadCount ? (count > 1 ? count : 1) : threadCount;
+}
+
+void Platform_parallelFor(int count, ParallelTask task, void* context) {
+    assert(task);
+    if (count <= 0) return;
+
+    ParallelFor loop = { task, context, count, 0 };
+
+    int threadCount = Platform_workerCount(count);
+    ParallelWorker* workers = (ParallelWorker*)malloc(threadCount * sizeof(ParallelWorker));
+    if (workers == NULL) {
+        // Run everything on the calling thread
+        ParallelWorker worker = { &loop, 0, NULL };
+        ParallelFor_work(&worker);
+        return;
+    }
+    for (int i = 0; i < threadCount; i++) {
+        workers[i].loop = &loop;
+        workers[i].worker = i;
+        workers[i].pool = NULL;
+    }
+
+    // The calling thread is worker 0
+    int spawned = 0;
+#ifdef _WIN32
+    HANDLE* threads = (HANDLE*)malloc((threadCount > 1 ? threadCount - 1 : 1) * sizeof(HANDLE));
+    for (int i = 0; threads != NULL && i < threadCount - 1; i++) {
+        threads[spawned] = CreateThread(NULL, 0, ParallelFor_threadMain, &workers[spawned + 1], 0, NULL);
+        if (threads[spawned] == NULL) break;
+        spawned++;
+    }
+#else
+    pthread_t* threads = (pthread_t*)malloc((threadCount > 1 ? threadCount - 1 : 1) * sizeof(pthread_t));
+    for (int i = 0; threads != NULL && i < threadCount - 1; i++) {
+        if (pthread_create(&threads[spawned], NULL, ParallelFor_threadMain, &workers[spawned + 1]) != 0) break;
+        spawned++;
+    }
+#endif
+
+    // If a thread cannot be created, the remaining workers take its share
+    ParallelFor_work(&workers[0]);
+
+    for (int i = 0; i < spawned; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#else
+        pthread_join(threads[i], NULL);
+#endif
+    }
+    free(threads);
+    free(workers);
+}
+
+static void PlatformPool_lock(PlatformPool* pool) {
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&pool->lock);
+#else
+    pthread_mutex_lock(&pool->lock);
+#endif
+}
+
+static void PlatformPool_unlock(PlatformPool* pool) {
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&pool->lock);
+#else
+    pthread_mutex_unlock(&pool->lock);
+#endif
+}
+
+/// @brief Attend un signal sur condition, le verrou du groupe étant pris.
+#ifdef _WIN32
+static void PlatformPool_wait(PlatformPool* pool, CONDITION_VARIABLE* condition) {
+    SleepConditionVariableSRW(condition, &pool->lock, INFINITE, 0);
+}
+#else
+static void PlatformPool_wait(PlatformPool* pool, pthread_cond_t* condition) {
+    pthread_cond_wait(condition, &pool->lock);
+}
+#endif
+
+static void PlatformPool_threadMain(void* context) {
+    ParallelWorker* worker = (ParallelWorker*)context;
+    PlatformPool* pool = worker->pool;
+
+    uint64_t seen = 0;
+    PlatformPool_lock(pool);
+    for (;;) {
+        while (pool->generation == seen && !pool->stopping) {
+            PlatformPool_wait(pool, &pool->wake);
+        }
+        if (pool->stopping) break;
+        seen = pool->generation;
+        PlatformPool_unlock(pool);
+
+        ParallelFor_work(worker);
+
+        PlatformPool_lock(pool);
+        if (--pool->running == 0) {
+#ifdef _WIN32
+            WakeConditionVariable(&pool->finished);
+#else
+            pthread_cond_signal(&pool->finished);
+#endif
+        }
+    }
+    PlatformPool_unlock(pool);
+}
+
+PlatformPool* Platform_startPool(int workerCount) {
+    assert(workerCount > 0);
+
+    PlatformPool* pool = (PlatformPool*)calloc(1, sizeof(PlatformPool));
+    if (pool == NULL) return NULL;
+    pool->workerCount = workerCount;
+    pool->threads = (PlatformThread**)calloc(workerCount, sizeof(PlatformThread*));
+    pool->workers = (ParallelWorker*)calloc(workerCount, sizeof(ParallelWorker));
+    if (pool->threads == NULL || pool->workers == NULL) {
+        free(pool->threads);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+
+#ifdef _WIN32
+    InitializeSRWLock(&pool->lock);
+    InitializeConditionVariable(&pool->wake);
+    InitializeConditionVariable(&pool->finished);
+#else
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->finished, NULL);
+#endif
+
+    for (int i = 0; i < workerCount; i++) {
+        pool->workers[i].loop = &pool->loop;
+        pool->workers[i].worker = i;
+        pool->workers[i].pool = pool;
+    }
+    // The calling thread is worker 0. If a thread cannot be created, the
+    // others take its share
+    for (int i = 1; i < workerCount; i++) {
+        pool->threads[pool->started] = Platform_startThread(PlatformPool_threadMain, &pool->workers[pool->started + 1]);
+        if (pool->threads[pool->started] == NULL) break;
+        pool->started++;
+    }
+    return pool;
+}
+
+void Platform_runPool(PlatformPool* pool, int count, ParallelTask task, void* context) {
+    assert(pool && task);
+    if (count <= 0) return;
+
+    PlatformPool_lock(pool);
+    pool->loop.task = task;
+    pool->loop.context = context;
+    pool->loop.count = count;
+    pool->loop.next = 0;
+    pool->running = pool->started;
+    pool->generation++;
+#ifdef _WIN32
+    WakeAllConditionVariable(&pool->wake);
+#else
+    pthread_cond_broadcast(&pool->wake);
+#endif
+    PlatformPool_unlock(pool);
+
+    ParallelFor_work(&pool->workers[0]);
+
+    // Barrier : every thread has left the loop before the next run changes it
+    PlatformPool_lock(pool);
+    while (pool->running > 0) {
+        PlatformPool_wait(pool, &pool->finished);
+    }
+    PlatformPool_unlock(pool);
+}
+
+void Platform_stopPool(PlatformPool* pool) {
+    if (pool == NULL) return;
+
+    PlatformPool_lock(pool);
+    pool->stopping = true;
+#ifdef _WIN32
+    WakeAllConditionVariable(&pool->wake);
+#else
+    pthread_cond_broadcast(&pool->wake);
+#endif
+    PlatformPool_unlock(pool);
+
+    for (int i = 0; i < pool->started; i++) {
+        Platform_joinThread(pool->threads[i]);
+    }
+#ifndef _WIN32
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->wake);
+    pthread_cond_destroy(&pool->finished);
+#endif
+    free(pool->threads);
+    free(pool->workers);
+    free(pool);
+}
+
+FileMapping* Platform_mapFile(const char* fileName) {
+    assert(fileName);
+
+    FileMapping* mapping = (FileMapping*)calloc(1, sizeof(FileMapping));
+    if (mapping == NULL) return NULL;
+
+#ifdef _WIN32
+    mapping->file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    LARGE_INTEGER size;
+    if (mapping->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(mapping->file, &size) || size.QuadPart == 0) {
+        if (mapping->file != INVALID_HANDLE_VALUE) CloseHandle(mapping->file);
+        free(mapping);
+        return NULL;
+    }
+    mapping->size = (size_t)size.QuadPart;
+
+    // PAGE_WRITECOPY gives private pages on the first write
+    mapping->section = CreateFileMappingA(mapping->file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    mapping->data = mapping->section != NULL ? MapViewOfFile(mapping->section, FILE_MAP_COPY, 0, 0, 0) : NULL;
+    if (mapping->data == NULL) {
+        if (mapping->section != NULL) CloseHandle(mapping->section);
+        CloseHandle(mapping->file);
+        free(mapping);
+        return NULL;
+    }
+#else
+    int file = open(fileName, O_RDONLY);
+    struct stat status;
+    if (file < 0 || fstat(file, &status) != 0 || status.st_size == 0) {
+        if (file >= 0) close(file);
+        free(mapping);
+        return NULL;
+    }
+    mapping->size = (size_t)status.st_size;
+
+    // MAP_PRIVATE gives private pages on the first write
+    mapping->data = mmap(NULL, mapping->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+    // The mapping keeps its own reference to the file
+    close(file);
+    if (mapping->data == MAP_FAILED) {
+        free(mapping);
+        return NULL;
+    }
+#endif
+    return mapping;
+}
+
+void Platform_unmapFile(FileMapping* mapping) {
+    if (mapping == NULL) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(mapping->data);
+    CloseHandle(mapping->section);
+    CloseHandle(mapping->file);
+#else
+    munmap(mapping->data, mapping->size);
+#endif
+    free(mapping);
+}
+
+void* FileMapping_data(const FileMapping* mapping) {
+    assert(mapping);
+    return mapping->data;
+}
+
+size_t FileMapping_size(const FileMapping* mapping) {
+    assert(mapping);
+    return mapping->size;
+}
+
+PlatformThread* Platform_startThread(ThreadMain main, void* context) {
+    assert(main);
+
+    PlatformThread* thread = (PlatformThread*)calloc(1, sizeof(PlatformThread));
+    if (thread == NULL) return NULL;
+    thread->main = main;
+    thread->context = context;
+
+#ifdef _WIN32
+    thread->handle = CreateThread(NULL, 0, PlatformThread_main, thread, 0, NULL);
+    if (thread->handle == NULL) {
+#else
+    if (pthread_create(&thread->handle, NULL, PlatformThread_main, thread) != 0) {
+#endif
+        free(thread);
+        return NULL;
+    }
+    return thread;
+}
+
+void Platform_joinThread(PlatformThread* thread) {
+    if (thread == NULL) return;
+
+#ifdef _WIN32
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+#else
+    pthread_join(thread->handle, NULL);
+#endif
+    free(thread);
+}
+
+bool Platform_syncFile(FILE* file) {
+    assert(file);
+    if (fflush(file) != 0) return false;
+
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+uint64_t Platform_remainingBytes(FILE* file) {
+    assert(file);
+
+#ifdef _WIN32
+    __int64 size = _filelengthi64(_fileno(file));
+    __int64 position = _ftelli64(file);
+#else
+    struct stat status;
+    off_t size = fstat(fileno(file), &status) == 0 ? status.st_size : -1;
+    off_t position = ftello(file);
+#endif
+    return size >= 0 && position >= 0 && size > position ? (uint64_t)(size - position) : 0;
+}
+
+bool Platform_replaceFile(const char* source, const char* target) {
+    assert(source && target);
+
+#ifdef _WIN32
+    // MOVEFILE_WRITE_THROUGH only returns once the new name is on the disk
+    return MoveFileExA(source, target, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    if (rename(source, target) != 0) return false;
+
+    // The new name is only durable once the directory itself is synced
+    size_t length = strlen(target);
+    char* path = (char*)malloc(length + 1);
+    if (path == NULL) return true;
+    memcpy(path, target, length + 1);
+    int directory = open(dirname(path), O_RDONLY);
+    free(path);
+    if (directory < 0) return true;
+    fsync(directory);
+    close(directory);
+    return true;
+#endif
+}
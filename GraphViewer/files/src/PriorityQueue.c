@@ -0,0 +1,245 @@
+#include "PriorityQueue.h"
+
+IndexedHeap* IndexedHeap_create(int capacity, int arity) {
+    assert(capacity >= 0 && arity >= 2);
+
+    IndexedHeap* heap = (IndexedHeap*)calloc(1, sizeof(IndexedHeap));
+    AssertNew(heap);
+
+    int allocated = capacity > 0 ? capacity : 1;
+    heap->heap = (int*)malloc(allocated * sizeof(int));
+    AssertNew(heap->heap);
+    heap->positions = (int*)malloc(allocated * sizeof(int));
+    AssertNew(heap->positions);
+    heap->keys = (float*)malloc(allocated * sizeof(float));
+    AssertNew(heap->keys);
+
+    for (int i = 0; i < capacity; i++) {
+        heap->positions[i] = -1;
+    }
+    heap->arity = arity;
+    heap->capacity = capacity;
+    heap->size = 0;
+
+    return heap;
+}
+
+void IndexedHeap_destroy(IndexedHeap* heap) {
+    if (heap == NULL) return;
+
+    free(heap->heap);
+    free(heap->positions);
+    free(heap->keys);
+    free(heap);
+}
+
+void IndexedHeap_clear(IndexedHeap* heap) {
+    for (int i = 0; i < heap->size; i++) {
+        heap->positions[heap->heap[i]] = -1;
+    }
+    heap->size = 0;
+}
+
+static void IndexedHeap_siftUp(IndexedHeap* heap, int position) {
+    int item = heap->heap[position];
+    float key = heap->keys[item];
+
+    while (position > 0) {
+        int parent = (position - 1) / heap->arity;
+        int parentItem = heap->heap[parent];
+        if (heap->keys[parentItem] <= key) {
+            break;
+        }
+        heap->heap[position] = parentItem;
+        heap->positions[parentItem] = position;
+        position = parent;
+    }
+    heap->heap[position] = item;
+    heap->positions[item] = position;
+}
+
+static void IndexedHeap_siftDown(IndexedHeap* heap, int position) {
+    int item = heap->heap[position];
+    float key = heap->keys[item];
+
+    while (true) {
+        int firstChild = position * heap->arity + 1;
+        if (firstChild >= heap->size) {
+            break;
+        }
+        int lastChild = minInt(firstChild + heap->arity, heap->size);
+
+        int best = firstChild;
+        float bestKey = heap->keys[heap->heap[firstChild]];
+        for (int child = firstChild + 1; child < lastChild; child++) {
+            float childKey = heap->keys[heap->heap[child]];
+            if (childKey < bestKey) {
+                best = child;
+                bestKey = childKey;
+            }
+        }
+        if (key <= bestKey) {
+            break;
+        }
+
+        int bestItem = heap->heap[best];
+        heap->heap[position] = bestItem;
+        heap->positions[bestItem] = position;
+        position = best;
+    }
+    heap->heap[position] = item;
+    heap->positions[item] = position;
+}
+
+void IndexedHeap_push(IndexedHeap* heap, int item, float key) {
+    assert(item >= 0 && item < heap->capacity);
+
+    int position = heap->positions[item];
+    if (position < 0) {
+        position = heap->size++;
+        heap->heap[position] = item;
+    } else if (heap->keys[item] <= key) {
+        return;
+    }
+    heap->keys[item] = key;
+    IndexedHeap_siftUp(heap, position);
+}
+
+int IndexedHeap_pop(IndexedHeap* heap) {
+    assert(heap->size > 0);
+
+    int item = heap->heap[0];
+    heap->positions[item] = -1;
+    heap->size--;
+
+    if (heap->size > 0) {
+        heap->heap[0] = heap->heap[heap->size];
+        IndexedHeap_siftDown(heap, 0);
+    }
+    return item;
+}
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static void Bucket_push(Bucket* bucket, int item, uint64_t key) {
+    if (bucket->count == bucket->capacity) {
+        bucket->capacity = bucket->capacity > 0 ? 2 * bucket->capacity : 8;
+        bucket->entries = (BucketEntry*)realloc(bucket->entries, bucket->capacity * sizeof(BucketEntry));
+        AssertNew(bucket->entries);
+    }
+    bucket->entries[bucket->count].key = key;
+    bucket->entries[bucket->count].item = item;
+    bucket->count++;
+}
+
+/// @brief Renvoie l'indice (à partir de 1) du bit de poids fort de x, 0 si x est nul.
+static int highestBit(uint64_t x) {
+    if (x == 0) {
+        return 0;
+    }
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return (int)index + 1;
+#else
+    return 64 - __builtin_clzll(x);
+#endif
+}
+
+RadixHeap* RadixHeap_create() {
+    RadixHeap* heap = (RadixHeap*)calloc(1, sizeof(RadixHeap));
+    AssertNew(heap);
+    return heap;
+}
+
+void RadixHeap_destroy(RadixHeap* heap) {
+    if (heap == NULL) return;
+
+    for (int i = 0; i < 65; i++) {
+        free(heap->buckets[i].entries);
+    }
+    free(heap);
+}
+
+void RadixHeap_push(RadixHeap* heap, int item, uint64_t key) {
+    assert(key >= heap->last);
+
+    Bucket_push(&heap->buckets[highestBit(key ^ heap->last)], item, key);
+    heap->size++;
+}
+
+BucketEntry RadixHeap_pop(RadixHeap* heap) {
+    assert(heap->size > 0);
+
+    if (heap->buckets[0].count == 0) {
+        // Move last to the smallest key of the first non-empty bucket, then
+        // redistribute that bucket : every entry lands in a lower bucket
+        int i = 1;
+        while (heap->buckets[i].count == 0) {
+            i++;
+        }
+
+        Bucket* bucket = &heap->buckets[i];
+        uint64_t minKey = bucket->entries[0].key;
+        for (int j = 1; j < bucket->count; j++) {
+            if (bucket->entries[j].key < minKey) {
+                minKey = bucket->entries[j].key;
+            }
+        }
+        heap->last = minKey;
+
+        for (int j = 0; j < bucket->count; j++) {
+            BucketEntry entry = bucket->entries[j];
+            Bucket_push(&heap->buckets[highestBit(entry.key ^ minKey)], entry.item, entry.key);
+        }
+        bucket->count = 0;
+    }
+
+    heap->size--;
+    return heap->buckets[0].entries[--heap->buckets[0].count];
+}
+
+BucketQueue* BucketQueue_create(int maxWeight) {
+    assert(maxWeight >= 0);
+
+    BucketQueue* queue = (BucketQueue*)calloc(1, sizeof(BucketQueue));
+    AssertNew(queue);
+
+    queue->bucketCount = maxWeight + 1;
+    queue->buckets = (Bucket*)calloc(queue->bucketCount, sizeof(Bucket));
+    AssertNew(queue->buckets);
+
+    return queue;
+}
+
+void BucketQueue_destroy(BucketQueue* queue) {
+    if (queue == NULL) return;
+
+    for (int i = 0; i < queue->bucketCount; i++) {
+        free(queue->buckets[i].entries);
+    }
+    free(queue->buckets);
+    free(queue);
+}
+
+void BucketQueue_push(BucketQueue* queue, int item, uint64_t key) {
+    assert(key >= queue->cursor && key - queue->cursor < (uint64_t)queue->bucketCount);
+
+    Bucket_push(&queue->buckets[key % queue->bucketCount], item, key);
+    queue->size++;
+}
+
+BucketEntry BucketQueue_pop(BucketQueue* queue) {
+    assert(queue->size > 0);
+
+    Bucket* bucket = &queue->buckets[queue->cursor % queue->bucketCount];
+    while (bucket->count == 0) {
+        queue->cursor++;
+        bucket = &queue->buckets[queue->cursor % queue->bucketCount];
+    }
+
+    queue->size--;
+    return bucket->entries[--bucket->count];
+}
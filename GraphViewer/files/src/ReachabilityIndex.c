@@ -0,0 +1,354 @@
+#include "ReachabilityIndex.h"
+#include "UnionFind.h"
+
+static void ReachabilityIndex_reserve(ReachabilityIndex* index, int size) {
+    if (size <= index->capacity) return;
+
+    int capacity = maxInt(size, 2 * index->capacity);
+    index->components = (int*)realloc(index->components, capacity * sizeof(int));
+    AssertNew(index->components);
+    index->capacity = capacity;
+}
+
+static void ReachabilityIndex_buildUnionFind(ReachabilityIndex* index) {
+    Graph* graph = index->graph;
+    int size = Graph_size(graph);
+
+    UnionFind_init(index->components, size);
+    for (int u = 0; u < size; u++) {
+        int arcEnd = Graph_arcEnd(graph, u);
+        for (int arc = Graph_arcBegin(graph, u); arc < arcEnd; arc++) {
+            UnionFind_union(index->components, u, Graph_arcTarget(graph, arc));
+        }
+    }
+}
+
+/// @brief Algorithme de Tarjan sans récursion : la pile d'appels est simulée
+/// par callStack et la position du prochain arc de chaque sommet.
+static void ReachabilityIndex_buildComponents(ReachabilityIndex* index) {
+    Graph* graph = index->graph;
+    int size = Graph_size(graph);
+
+    int* order = (int*)malloc(maxInt(size, 1) * sizeof(int));
+    AssertNew(order);
+    int* lowLinks = (int*)malloc(maxInt(size, 1) * sizeof(int));
+    AssertNew(lowLinks);
+    int* nextArcs = (int*)malloc(maxInt(size, 1) * sizeof(int));
+    AssertNew(nextArcs);
+    int* callStack = (int*)malloc(maxInt(size, 1) * sizeof(int));
+    AssertNew(callStack);
+    int* stack = (int*)malloc(maxInt(size, 1) * sizeof(int));
+    AssertNew(stack);
+    bool* onStack = (bool*)calloc(maxInt(size, 1), sizeof(bool));
+    AssertNew(onStack);
+
+    for (int i = 0; i < size; i++) {
+        order[i] = -1;
+    }
+
+    int counter = 0;
+    int stackSize = 0;
+    int componentsCount = 0;
+    for (int root = 0; root < size; root++) {
+        if (order[root] >= 0) continue;
+
+        int depth = 0;
+        callStack[depth++] = root;
+        order[root] = lowLinks[root] = counter++;
+        nextArcs[root] = Graph_arcBegin(graph, root);
+        stack[stackSize++] = root;
+        onStack[root] = true;
+
+        while (depth > 0) {
+            int node = callStack[depth - 1];
+
+            if (nextArcs[node] < Graph_arcEnd(graph, node)) {
+                int next = Graph_arcTarget(graph, nextArcs[node]++);
+                if (order[next] < 0) {
+                    callStack[depth++] = next;
+                    order[next] = lowLinks[next] = counter++;
+                    nextArcs[next] = Graph_arcBegin(graph, next);
+                    stack[stackSize++] = next;
+                    onStack[next] = true;
+                } else if (onStack[next]) {
+                    lowLinks[node] = minInt(lowLinks[node], order[next]);
+                }
+                continue;
+            }
+
+            // Every arc of node has been explored
+            depth--;
+            if (depth > 0) {
+                int parent = callStack[depth - 1];
+                lowLinks[parent] = minInt(lowLinks[parent], lowLinks[node]);
+            }
+            if (lowLinks[node] == order[node]) {
+                int member;
+                do {
+                    member = stack[--stackSize];
+                    onStack[member] = false;
+                    index->components[member] = componentsCount;
+                } while (member != node);
+                componentsCount++;
+            }
+        }
+    }
+    index->componentsCount = componentsCount;
+
+    free(order);
+    free(lowLinks);
+    free(nextArcs);
+    free(callStack);
+    free(stack);
+    free(onStack);
+}
+
+static unsigned int ReachabilityIndex_random(unsigned int* state) {
+    // xorshift32
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/// @brief Calcule les intervalles GRAIL des composantes.
+static void ReachabilityIndex_buildLabels(ReachabilityIndex* index) {
+    Graph* graph = index->graph;
+    int size = Graph_size(graph);
+    int count = index->componentsCount;
+    int slots = maxInt(count, 1);
+
+    // Arcs of the component DAG (duplicates are harmless)
+    int* offsets = (int*)calloc(slots + 1, sizeof(int));
+    AssertNew(offsets);
+    for (int u = 0; u < size; u++) {
+        int arcEnd = Graph_arcEnd(graph, u);
+        for (int arc = Graph_arcBegin(graph, u); arc < arcEnd; arc++) {
+            if (index->components[u] != index->components[Graph_arcTarget(graph, arc)]) {
+                offsets[index->components[u] + 1]++;
+            }
+        }
+    }
+    for (int c = 0; c < count; c++) {
+        offsets[c + 1] += offsets[c];
+    }
+    int* targets = (int*)malloc(maxInt(offsets[count], 1) * sizeof(int));
+    AssertNew(targets);
+    int* fill = (int*)malloc(slots * sizeof(int));
+    AssertNew(fill);
+    memcpy(fill, offsets, count * sizeof(int));
+    for (int u = 0; u < size; u++) {
+        int arcEnd = Graph_arcEnd(graph, u);
+        for (int arc = Graph_arcBegin(graph, u); arc < arcEnd; arc++) {
+            int from = index->components[u];
+            int to = index->components[Graph_arcTarget(graph, arc)];
+            if (from != to) {
+                targets[fill[from]++] = to;
+            }
+        }
+    }
+
+    free(index->lows);
+    free(index->posts);
+    index->lows = (int*)malloc(slots * REACHABILITY_LABELS * sizeof(int));
+    AssertNew(index->lows);
+    index->posts = (int*)malloc(slots * REACHABILITY_LABELS * sizeof(int));
+    AssertNew(index->posts);
+
+    int* roots = (int*)malloc(slots * sizeof(int));
+    AssertNew(roots);
+    int* callStack = (int*)malloc(slots * sizeof(int));
+    AssertNew(callStack);
+    int* visited = (int*)malloc(slots * sizeof(int));
+    AssertNew(visited);
+    for (int c = 0; c < count; c++) {
+        roots[c] = c;
+        visited[c] = -1;
+    }
+
+    unsigned int seed = 0x9E3779B9u;
+    for (int label = 0; label < REACHABILITY_LABELS; label++) {
+        // Roots are taken in a random order, children in a random rotation,
+        // so that the labels prune different pairs
+        for (int i = count - 1; i > 0; i--) {
+            int j = (int)(ReachabilityIndex_random(&seed) % (unsigned int)(i + 1));
+            int swap = roots[i];
+            roots[i] = roots[j];
+            roots[j] = swap;
+        }
+
+        int post = 0;
+        for (int r = 0; r < count; r++) {
+            int root = roots[r];
+            if (visited[root] == label) continue;
+
+            int depth = 0;
+            callStack[depth++] = root;
+            visited[root] = label;
+            // fill[c] counts the children of c explored during this traversal
+            fill[root] = 0;
+            index->lows[root * REACHABILITY_LABELS + label] = INT32_MAX;
+
+            while (depth > 0) {
+                int c = callStack[depth - 1];
+                int degree = offsets[c + 1] - offsets[c];
+
+                if (fill[c] < degree) {
+                    int child = targets[offsets[c] + (fill[c] + c + label) % degree];
+                    fill[c]++;
+                    if (visited[child] != label) {
+                        visited[child] = label;
+                        fill[child] = 0;
+                        index->lows[child * REACHABILITY_LABELS + label] = INT32_MAX;
+                        callStack[depth++] = child;
+                    } else {
+                        int* low = &index->lows[c * REACHABILITY_LABELS + label];
+                        *low = minInt(*low, index->lows[child * REACHABILITY_LABELS + label]);
+                    }
+                    continue;
+                }
+
+                depth--;
+                int slot = c * REACHABILITY_LABELS + label;
+                index->posts[slot] = post;
+                index->lows[slot] = minInt(index->lows[slot], post);
+                post++;
+                if (depth > 0) {
+                    int* low = &index->lows[callStack[depth - 1] * REACHABILITY_LABELS + label];
+                    *low = minInt(*low, index->lows[slot]);
+                }
+            }
+        }
+    }
+
+    free(offsets);
+    free(targets);
+    free(fill);
+    free(roots);
+    free(callStack);
+    free(visited);
+}
+
+static void ReachabilityIndex_rebuild(ReachabilityIndex* index) {
+    ReachabilityIndex_reserve(index, maxInt(Graph_size(index->graph), 1));
+    if (index->oriented) {
+        ReachabilityIndex_buildComponents(index);
+        ReachabilityIndex_buildLabels(index);
+    } else {
+        ReachabilityIndex_buildUnionFind(index);
+    }
+    index->dirty = false;
+    index->rebuildsCount++;
+}
+
+/// @brief Réponse des étiquettes pour deux sommets de composantes différentes.
+static ReachabilityAnswer ReachabilityIndex_compareLabels(ReachabilityIndex* index, int fromComponent, int toComponent) {
+    // Arcs of the component DAG go from higher to lower indices
+    if (fromComponent < toComponent) {
+        return REACHABILITY_NO;
+    }
+    for (int label = 0; label < REACHABILITY_LABELS; label++) {
+        int from = fromComponent * REACHABILITY_LABELS + label;
+        int to = toComponent * REACHABILITY_LABELS + label;
+        if (index->lows[to] < index->lows[from] || index->posts[to] > index->posts[from]) {
+            return REACHABILITY_NO;
+        }
+    }
+    return REACHABILITY_MAYBE;
+}
+
+static void ReachabilityIndex_onEdit(void* context, Graph* graph, const GraphEdit* edit) {
+    ReachabilityIndex* index = (ReachabilityIndex*)context;
+    if (index->dirty) return;
+
+    switch (edit->type) {
+    case GRAPH_EDIT_ADD_NODE:
+        if (index->oriented) {
+            index->dirty = true;
+        } else {
+            ReachabilityIndex_reserve(index, Graph_size(graph));
+            index->components[edit->node] = edit->node;
+        }
+        break;
+
+    case GRAPH_EDIT_REMOVE_NODE:
+    case GRAPH_EDIT_PERMUTE_NODES:
+        index->dirty = true;
+        break;
+
+    case GRAPH_EDIT_ADD_ARC:
+        if (!index->oriented) {
+            UnionFind_union(index->components, edit->from, edit->to);
+        } else {
+            // The labels stay valid if they already allowed from -> to : every
+            // node reaching from already had a label containing those of the
+            // nodes reached by to, and no cycle can appear
+            int fromComponent = index->components[edit->from];
+            int toComponent = index->components[edit->to];
+            if (fromComponent != toComponent
+                && ReachabilityIndex_compareLabels(index, fromComponent, toComponent) == REACHABILITY_NO) {
+                index->dirty = true;
+            }
+        }
+        break;
+
+    case GRAPH_EDIT_REMOVE_ARC:
+        // A removed arc only removes paths : the answers stay correct, except
+        // inside a strongly connected component, which may split
+        if (index->oriented && index->components[edit->from] == index->components[edit->to]) {
+            index->dirty = true;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+ReachabilityIndex* ReachabilityIndex_create(Graph* graph) {
+    assert(graph);
+
+    ReachabilityIndex* index = (ReachabilityIndex*)calloc(1, sizeof(ReachabilityIndex));
+    AssertNew(index);
+    index->graph = graph;
+    index->oriented = graph->oriented != 0;
+
+    ReachabilityIndex_rebuild(index);
+    Graph_addObserver(graph, ReachabilityIndex_onEdit, index);
+    return index;
+}
+
+void ReachabilityIndex_destroy(ReachabilityIndex* index) {
+    if (index == NULL) return;
+
+    Graph_removeObserver(index->graph, ReachabilityIndex_onEdit, index);
+    free(index->components);
+    free(index->lows);
+    free(index->posts);
+    free(index);
+}
+
+ReachabilityAnswer ReachabilityIndex_query(ReachabilityIndex* index, int from, int to) {
+    assert(index && from >= 0 && from < Graph_size(index->graph) && to >= 0 && to < Graph_size(index->graph));
+
+    if (index->dirty) {
+        ReachabilityIndex_rebuild(index);
+    }
+    if (from == to) {
+        return REACHABILITY_YES;
+    }
+
+    if (!index->oriented) {
+        bool connected = UnionFind_find(index->components, from) == UnionFind_find(index->components, to);
+        return connected ? REACHABILITY_MAYBE : REACHABILITY_NO;
+    }
+
+    int fromComponent = index->components[from];
+    int toComponent = index->components[to];
+    if (fromComponent == toComponent) {
+        return REACHABILITY_YES;
+    }
+    return ReachabilityIndex_compareLabels(index, fromComponent, toComponent);
+}
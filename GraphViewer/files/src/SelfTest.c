@@ -0,0 +1,825 @@
+#include "SelfTest.h"
+#include "ShortestPath.h"
+#include "BreadthFirstSearch.h"
+#include "DeltaStepping.h"
+#include "AllPairs.h"
+#include "AltIndex.h"
+#include "ContractionHierarchy.h"
+#include "HubLabels.h"
+#include "ReachabilityIndex.h"
+#include "SpanningForest.h"
+#include "UnionFind.h"
+#include "EditJournal.h"
+#include "ShortestPathBatch.h"
+#include "DynamicShortestPath.h"
+#include "ShortestPathCache.h"
+#include "NodeOrdering.h"
+
+/// @brief Distances calculées par Graph_dijkstra() depuis les sommets de
+/// départ des vérifications.
+typedef struct SelfTestReference {
+    Graph* graph;
+    int sourcesCount;
+    int* sources;
+
+    /// @brief Distance de sources[i] au sommet v dans la case i * nodesCount + v.
+    float* distances;
+
+    /// @brief Ecart entre deux sommets d'arrivée des requêtes point à point.
+    int targetStep;
+} SelfTestReference;
+
+static uint32_t SelfTest_random(uint32_t* state) {
+    // xorshift32
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/// @brief Crée un graphe orienté aléatoire, toujours le même pour une même graine.
+/// @param maxWeight le poids maximal des arcs, 0 pour des arcs qui pèsent tous 1.
+static Graph* SelfTest_randomGraph(int nodesCount, int arcsCount, int maxWeight, uint32_t seed) {
+    Graph* graph = Graph_create(true);
+    uint32_t state = seed;
+
+    char id[16];
+    for (int i = 0; i < nodesCount; i++) {
+        snprintf(id, sizeof(id), "%d", i);
+        Vector2 position = { (float)(SelfTest_random(&state) % 1000), (float)(SelfTest_random(&state) % 1000) };
+        Graph_addNode(graph, id, position);
+    }
+    for (int i = 0; i < arcsCount; i++) {
+        int from = (int)(SelfTest_random(&state) % nodesCount);
+        int to = (int)(SelfTest_random(&state) % nodesCount);
+        int weight = maxWeight > 0 ? (int)(SelfTest_random(&state) % (maxWeight + 1)) : 1;
+        Graph_addArc(graph, from, to, weight);
+    }
+    return graph;
+}
+
+static void SelfTestReference_init(SelfTestReference* reference, Graph* graph) {
+    int size = Graph_size(graph);
+    reference->graph = graph;
+    reference->sourcesCount = minInt(size, SELF_TEST_SOURCES);
+    reference->targetStep = maxInt(1, size / SELF_TEST_TARGETS);
+
+    reference->sources = (int*)malloc(maxInt(reference->sourcesCount, 1) * sizeof(int));
+    AssertNew(reference->sources);
+    reference->distances = (float*)malloc(maxInt(reference->sourcesCount * size, 1) * sizeof(float));
+    AssertNew(reference->distances);
+    int* predecessors = (int*)malloc(maxInt(size, 1) * sizeof(int));
+    AssertNew(predecessors);
+
+    for (int i = 0; i < reference->sourcesCount; i++) {
+        reference->sources[i] = (int)((int64_t)i * size / reference->sourcesCount);
+        Graph_dijkstra(graph, reference->sources[i], -1, predecessors, reference->distances + (size_t)i * size, NULL);
+    }
+    free(predecessors);
+}
+
+static void SelfTestReference_destroy(SelfTestReference* reference) {
+    free(reference->sources);
+    free(reference->distances);
+}
+
+/// @brief Distances de référence depuis sources[source].
+static const float* SelfTestReference_row(const SelfTestReference* reference, int source) {
+    return reference->distances + (size_t)source * Graph_size(reference->graph);
+}
+
+static float SelfTestReference_distance(const SelfTestReference* reference, int source, int node) {
+    return reference->distances[(size_t)source * Graph_size(reference->graph) + node];
+}
+
+/// @brief Compte les sommets dont la distance depuis sources[source] diffère
+/// de la référence.
+static int SelfTest_compareAll(const SelfTestReference* reference, int source, const float* distances) {
+    int errors = 0;
+    for (int v = 0; v < Graph_size(reference->graph); v++) {
+        if (distances[v] != SelfTestReference_distance(reference, source, v)) {
+            errors++;
+        }
+    }
+    return errors;
+}
+
+/// @brief Indique si le graphe a un arc u -> v qui prolonge un plus court
+/// chemin : expected[u] + poids == expected[v].
+static bool SelfTest_isTightArc(Graph* graph, const float* expected, int u, int v) {
+    int arcEnd = Graph_arcEnd(graph, u);
+    for (int arc = Graph_arcBegin(graph, u); arc < arcEnd; arc++) {
+        if (Graph_arcTarget(graph, arc) == v && expected[u] + Graph_arcWeight(graph, arc) == expected[v]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief Vérifie la chaîne de prédécesseurs de target : elle doit remonter à
+/// source en au plus n arcs, chacun sur un plus court chemin d'après les
+/// distances expected. Un sommet inaccessible ne doit pas avoir de prédécesseur.
+/// @return 1 si la chaîne est incorrecte, 0 sinon.
+static int SelfTest_chainErrors(Graph* graph, const float* expected, int source, int target, const int* predecessors) {
+    if (isinf(expected[target])) {
+        return predecessors[target] != -1;
+    }
+
+    int node = target;
+    for (int steps = 0; node != source; steps++) {
+        int previous = predecessors[node];
+        if (previous < 0 || steps >= Graph_size(graph) || !SelfTest_isTightArc(graph, expected, previous, node)) {
+            return 1;
+        }
+        node = previous;
+    }
+    return 0;
+}
+
+/// @brief Vérifie un chemin explicite de source à target (length sommets,
+/// vide s'il n'existe pas) de la même façon que SelfTest_chainErrors().
+static int SelfTest_pathErrors(Graph* graph, const float* expected, int source, int target, const int* path, int length) {
+    if (isinf(expected[target])) {
+        return length != 0;
+    }
+    if (length == 0 || path[0] != source || path[length - 1] != target) {
+        return 1;
+    }
+    for (int i = 1; i < length; i++) {
+        if (!SelfTest_isTightArc(graph, expected, path[i - 1], path[i])) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/// @brief Vérifie les chaînes de prédécesseurs d'un arbre calculé depuis
+/// sources[source], vers les sommets d'arrivée des requêtes point à point.
+static int SelfTest_treeErrors(const SelfTestReference* reference, int source, const int* predecessors) {
+    int errors = 0;
+    for (int t = 0; t < Graph_size(reference->graph); t += reference->targetStep) {
+        errors += SelfTest_chainErrors(reference->graph, SelfTestReference_row(reference, source), reference->sources[source], t, predecessors);
+    }
+    return errors;
+}
+
+/// @brief Affiche le résultat de la vérification d'un moteur.
+/// @return 1 si le moteur est en échec, 0 sinon.
+static int SelfTest_report(const char* engine, int errors) {
+    if (errors == 0) {
+        printf("  %-28s OK\n", engine);
+        return 0;
+    }
+    printf("  %-28s FAILED (%d errors)\n", engine, errors);
+    return 1;
+}
+
+static int SelfTest_bfs(const SelfTestReference* reference, int* predecessors, float* distances) {
+    Graph* graph = reference->graph;
+    int weight = Graph_uniformWeight(graph);
+    if (weight < 0) {
+        printf("  %-28s skipped, the arcs have different weights\n", "Breadth-first search");
+        return 0;
+    }
+
+    int errors = 0;
+    for (int i = 0; i < reference->sourcesCount; i++) {
+        Graph_bfs(graph, reference->sources[i], -1, predecessors, distances, weight, NULL);
+        errors += SelfTest_compareAll(reference, i, distances);
+        errors += SelfTest_treeErrors(reference, i, predecessors);
+    }
+    return SelfTest_report("Breadth-first search", errors);
+}
+
+static int SelfTest_deltaStepping(const SelfTestReference* reference, int* predecessors, float* distances) {
+    int errors = 0;
+    for (int i = 0; i < reference->sourcesCount; i++) {
+        Graph_deltaStepping(reference->graph, reference->sources[i], predecessors, distances, 0.0f, NULL);
+        errors += SelfTest_compareAll(reference, i, distances);
+        errors += SelfTest_treeErrors(reference, i, predecessors);
+    }
+    return SelfTest_report("Delta-stepping", errors);
+}
+
+/// @brief Vérifie Graph_dijkstra() avec une file de priorité donnée. Les
+/// distances de référence viennent de la file par défaut, dont seuls les
+/// prédécesseurs apportent une vérification.
+static int SelfTest_dijkstra(const SelfTestReference* reference, DijkstraQueue queue, const char* engine, int* predecessors, float* distances) {
+    if (queue == DIJKSTRA_QUEUE_SCAN && Graph_size(reference->graph) > SELF_TEST_ALL_PAIRS_MAX) {
+        printf("  %-28s skipped, the graph is too large\n", engine);
+        return 0;
+    }
+
+    ShortestPathOptions options = ShortestPathOptions_default();
+    options.queue = queue;
+    int errors = 0;
+    for (int i = 0; i < reference->sourcesCount; i++) {
+        Graph_dijkstra(reference->graph, reference->sources[i], -1, predecessors, distances, &options);
+        errors += SelfTest_compareAll(reference, i, distances);
+        errors += SelfTest_treeErrors(reference, i, predecessors);
+    }
+    return SelfTest_report(engine, errors);
+}
+
+static int SelfTest_dijkstraInt(const SelfTestReference* reference, int* predecessors) {
+    Graph* graph = reference->graph;
+    int64_t* distances = (int64_t*)malloc(maxInt(Graph_size(graph), 1) * sizeof(int64_t));
+    AssertNew(distances);
+
+    int errors = 0;
+    for (int i = 0; i < reference->sourcesCount; i++) {
+        Graph_dijkstraInt(graph, reference->sources[i], -1, predecessors, distances);
+        for (int v = 0; v < Graph_size(graph); v++) {
+            float expected = SelfTestReference_distance(reference, i, v);
+            if (isinf(expected) ? distances[v] != INT_DISTANCE_INFINITY : (float)distances[v] != expected) {
+                errors++;
+            }
+        }
+        errors += SelfTest_treeErrors(reference, i, predecessors);
+    }
+    free(distances);
+    return SelfTest_report("Integer Dijkstra", errors);
+}
+
+/// @brief Recherche point à point vérifiée par SelfTest_pointToPoint().
+typedef void (*SelfTestQuery)(Graph* graph, int start, int end, int* predecessors, float* distances, const ShortestPathOptions* options);
+
+/// @brief Vérifie la distance et le chemin de chaque requête point à point.
+static int SelfTest_pointToPoint(const SelfTestReference* reference, const char* engine, SelfTestQuery query,
+    const ShortestPathOptions* options, int* predecessors, float* distances) {
+    Graph* graph = reference->graph;
+    int errors = 0;
+    for (int i = 0; i < reference->sourcesCount; i++) {
+        for (int t = 0; t < Graph_size(graph); t += reference->targetStep) {
+            query(graph, reference->sources[i], t, predecessors, distances, options);
+            if (distances[t] != SelfTestReference_distance(reference, i, t)) {
+                errors++;
+            } else {
+                errors += SelfTest_chainErrors(graph, SelfTestReference_row(reference, i), reference->sources[i], t, predecessors);
+            }
+        }
+    }
+    return SelfTest_report(engine, errors);
+}
+
+static int SelfTest_allPairs(const SelfTestReference* reference) {
+    Graph* graph = reference->graph;
+    if (Graph_size(graph) > SELF_TEST_ALL_PAIRS_MAX) {
+        printf("  %-28s skipped, the graph is too large\n", "Floyd-Warshall");
+        return 0;
+    }
+
+    AllPairs* allPairs = Graph_allPairs(graph);
+    int errors = 0;
+    for (int i = 0; i < reference->sourcesCount; i++) {
+        for (int v = 0; v < Graph_size(graph); v++) {
+            if (AllPairs_distance(allPairs, reference->sources[i], v) != SelfTestReference_distance(reference, i, v)) {
+                errors++;
+            }
+        }
+    }
+    AllPairs_destroy(allPairs);
+    return SelfTest_report("Floyd-Warshall", errors);
+}
+
+static int SelfTest_contractionHierarchy(const SelfTestReference* reference) {
+    ContractionHierarchy* ch = ContractionHierarchy_build(reference->graph);
+    int errors = 0;
+    for (int i = 0; i < reference->sourcesCount; i++) {
+        for (int t = 0; t < Graph_size(reference->graph); t += reference->targetStep) {
+            if (ContractionHierarchy_distance(ch, reference->sources[i], t, NULL) != SelfTestReference_distance(reference, i, t)) {
+                errors++;
+            }
+        }
+    }
+    ContractionHierarchy_destroy(ch);
+    return SelfTest_report("Contraction hierarchy", errors);
+}
+
+static int SelfTest_alt(const SelfTestReference* reference, int* predecessors, float* distances) {
+    AltIndex* landmarks = AltIndex_build(reference->graph, minInt(Graph_size(reference->graph), 4), ALT_LANDMARKS_AVOID);
+    ShortestPathOptions options = ShortestPathOptions_default();
+    options.landmarks = landmarks;
+
+    int failures = SelfTest_pointToPoint(reference, "A* with landmarks (ALT)", Graph_astar, &options, predecessors, distances);
+    AltIndex_destroy(landmarks);
+    return failures;
+}
+
+/// @brief Vérifie les distances et les chemins d'un lot de requêtes dont la
+/// case (row, column) va de sources[row / targetsCount] au sommet
+/// (row % targetsCount + column) * targetStep.
+static int SelfTest_batchErrors(const SelfTestReference* reference, ShortestPathBatch* batch, int targetsCount) {
+    int errors = 0;
+    for (int row = 0; row < batch->rowsCount; row++) {
+        for (int column = 0; column < batch->columnsCount; column++) {
+            int source = row / targetsCount;
+            int target = (row % targetsCount + column) * reference->targetStep;
+            if (ShortestPathBatch_distance(batch, row, column) != SelfTestReference_distance(reference, source, target)) {
+                errors++;
+                continue;
+            }
+            errors += SelfTest_pathErrors(reference->graph, SelfTestReference_row(reference, source), reference->sources[source], target,
+                ShortestPathBatch_path(batch, row, column), ShortestPathBatch_pathLength(batch, row, column));
+        }
+    }
+    return errors;
+}
+
+/// @brief Vérifie les lots de requêtes : les paires avec A* et la matrice
+/// des distances avec Dijkstra, chemins compris.
+static int SelfTest_batch(const SelfTestReference* reference) {
+    Graph* graph = reference->graph;
+    int targetsCount = (Graph_size(graph) + reference->targetStep - 1) / reference->targetStep;
+    int pairsCount = reference->sourcesCount * targetsCount;
+
+    const char** sourceIds = (const char**)malloc(maxInt(reference->sourcesCount, 1) * sizeof(char*));
+    AssertNew(sourceIds);
+    const char** targetIds = (const char**)malloc(maxInt(targetsCount, 1) * sizeof(char*));
+    AssertNew(targetIds);
+    const char** startIds = (const char**)malloc(maxInt(pairsCount, 1) * sizeof(char*));
+    AssertNew(startIds);
+    const char** endIds = (const char**)malloc(maxInt(pairsCount, 1) * sizeof(char*));
+    AssertNew(endIds);
+
+    for (int i = 0; i < reference->sourcesCount; i++) {
+        sourceIds[i] = Graph_getNodeId(graph, reference->sources[i]);
+    }
+    for (int t = 0; t < targetsCount; t++) {
+        targetIds[t] = Graph_getNodeId(graph, t * reference->targetStep);
+    }
+    for (int pair = 0; pair < pairsCount; pair++) {
+        startIds[pair] = sourceIds[pair / targetsCount];
+        endIds[pair] = targetIds[pair % targetsCount];
+    }
+
+    ShortestPathOptions options = ShortestPathOptions_default();
+    options.method = SHORTEST_PATH_ASTAR;
+    ShortestPathBatch* pairs = Graph_shortestPathPairs(graph, startIds, endIds, pairsCount, true, &options);
+    ShortestPathBatch* matrix = Graph_distanceMatrix(graph, sourceIds, reference->sourcesCount, targetIds, targetsCount, true, NULL);
+
+    int errors = 0;
+    errors += pairs != NULL ? SelfTest_batchErrors(reference, pairs, targetsCount) : 1;
+    errors += matrix != NULL ? SelfTest_batchErrors(reference, matrix, 1) : 1;
+
+    ShortestPathBatch_destroy(pairs);
+    ShortestPathBatch_destroy(matrix);
+    free(sourceIds);
+    free(targetIds);
+    free(startIds);
+    free(endIds);
+    return SelfTest_report("Batch queries", errors);
+}
+
+
+static int SelfTest_hubLabels(const SelfTestReference* reference) {
+    HubLabels* labels = HubLabels_build(reference->graph);
+    int errors = 0;
+    for (int i = 0; i < reference->sourcesCount; i++) {
+        for (int t = 0; t < Graph_size(reference->graph); t += reference->targetStep) {
+            if (HubLabels_distance(labels, reference->sources[i], t) != SelfTestReference_distance(reference, i, t)) {
+                errors++;
+            }
+        }
+    }
+    HubLabels_destroy(labels);
+    return SelfTest_report("Hub labels", errors);
+}
+
+static int SelfTest_reachability(const SelfTestReference* reference) {
+    ReachabilityIndex* index = ReachabilityIndex_create(reference->graph);
+    int errors = 0;
+    for (int i = 0; i < reference->sourcesCount; i++) {
+        for (int v = 0; v < Graph_size(reference->graph); v++) {
+            ReachabilityAnswer answer = ReachabilityIndex_query(index, reference->sources[i], v);
+            bool reachable = !isinf(SelfTestReference_distance(reference, i, v));
+            if ((answer == REACHABILITY_YES && !reachable) || (answer == REACHABILITY_NO && reachable)) {
+                errors++;
+            }
+        }
+    }
+    ReachabilityIndex_destroy(index);
+    return SelfTest_report("Reachability index", errors);
+}
+
+/// @brief Compte les défauts d'une forêt couvrante : arête qui relie deux
+/// sommets d'un même arbre, ou nombre d'arbres différent du nombre de
+/// composantes connexes du graphe.
+static int SelfTest_forestErrors(Graph* graph, const SpanningForest* forest, int* parents) {
+    int size = Graph_size(graph);
+    int errors = 0;
+
+    UnionFind_init(parents, size);
+    for (int i = 0; i < forest->edgesCount; i++) {
+        if (!UnionFind_union(parents, forest->edges[i].from, forest->edges[i].to)) {
+            errors++;
+        }
+    }
+    if (forest->edgesCount != size - forest->treesCount) {
+        errors++;
+    }
+
+    UnionFind_init(parents, size);
+    int componentsCount = size;
+    for (int u = 0; u < size; u++) {
+        for (int arc = Graph_arcBegin(graph, u); arc < Graph_arcEnd(graph, u); arc++) {
+            if (UnionFind_union(parents, u, Graph_arcTarget(graph, arc))) {
+                componentsCount--;
+            }
+        }
+    }
+    if (forest->treesCount != componentsCount) {
+        errors++;
+    }
+    return errors;
+}
+
+static int SelfTest_spanningForest(Graph* graph) {
+    int* parents = (int*)malloc(maxInt(Graph_size(graph), 1) * sizeof(int));
+    AssertNew(parents);
+    SpanningForest* kruskal = Graph_kruskal(graph);
+    SpanningForest* boruvka = Graph_boruvka(graph);
+
+    int errors = SelfTest_forestErrors(graph, kruskal, parents) + SelfTest_forestErrors(graph, boruvka, parents);
+    if (kruskal->totalWeight != boruvka->totalWeight) {
+        errors++;
+    }
+
+    SpanningForest_destroy(kruskal);
+    SpanningForest_destroy(boruvka);
+    free(parents);
+    return SelfTest_report("Minimum spanning forest", errors);
+}
+
+/// @brief Modifie une copie du graphe enregistrée dans SELF_TEST_FILE en
+/// suivant son journal, avec une compaction au milieu, puis vérifie que le
+/// graphe rechargé et son journal réappliqué redonnent le graphe modifié.
+static int SelfTest_journal(Graph* graph) {
+    if (!Graph_saveBinary(graph, SELF_TEST_FILE)) {
+        return SelfTest_report("Journal replay", 1);
+    }
+
+    Graph* copy = Graph_loadFile(SELF_TEST_FILE);
+    EditJournal* journal = copy != NULL ? EditJournal_open(copy) : NULL;
+    if (journal == NULL) {
+        Graph_destroy(copy);
+        remove(SELF_TEST_FILE);
+        return SelfTest_report("Journal replay", 1);
+    }
+
+    Vector2 position = { 12.0f, 34.0f };
+    int node = Graph_addNode(copy, "selftest", position);
+    if (node > 0) {
+        Graph_addArc(copy, 0, node, 7);
+    }
+    EditJournal_commit(journal);
+    EditJournal_compact(journal);
+
+    // The records written during the compaction stay in the journal
+    if (Graph_arcCount(copy) > 0) {
+        Graph_setArcWeight(copy, 0, Graph_arcWeight(copy, 0) + 1);
+        Graph_removeArc(copy, Graph_arcCount(copy) - 1);
+    }
+    if (node >= 0) {
+        position.x = 56.0f;
+        Graph_moveNode(copy, node, position);
+    }
+    EditJournal_commit(journal);
+
+    uint64_t fingerprint = Graph_fingerprint(copy);
+    EditJournal_close(journal);
+    Graph_destroy(copy);
+
+    int errors = 0;
+    copy = Graph_loadFile(SELF_TEST_FILE);
+    journal = copy != NULL ? EditJournal_open(copy) : NULL;
+    if (journal == NULL) {
+        errors++;
+    } else {
+        int replayed = Graph_getNodeIndex(copy, "selftest");
+        if (Graph_fingerprint(copy) != fingerprint) {
+            errors++;
+        }
+        if (replayed < 0 || Graph_getNodePosition(copy, replayed).x != position.x) {
+            errors++;
+        }
+    }
+    EditJournal_close(journal);
+    Graph_destroy(copy);
+
+    remove(SELF_TEST_FILE);
+    remove(SELF_TEST_FILE EDIT_JOURNAL_EXTENSION);
+    return SelfTest_report("Journal replay", errors);
+}
+
+/// @brief Interroge le cache et vérifie que la requête a été servie par le
+/// cache (hit) ou calculée, et que le chemin a la distance expected[end].
+/// @return Le nombre d'erreurs.
+static int SelfTest_cacheQuery(ShortestPathCache* cache, Graph* graph, int start, int end, const float* expected,
+    const ShortestPathOptions* options, bool hit) {
+    long long hitsCount = cache->hitsCount;
+    Path* path = ShortestPathCache_shortestPath(cache, graph, Graph_getNodeId(graph, start), Graph_getNodeId(graph, end), options);
+
+    int errors = (cache->hitsCount != hitsCount) != hit;
+    if (path == NULL ? !isinf(expected[end]) : path->distance != expected[end]) {
+        errors++;
+    }
+    Path_destroy(path);
+    return errors;
+}
+
+/// @brief Vérifie le cache des plus courts chemins sur une copie du graphe :
+/// une requête répétée est servie par le cache, la première requête après
+/// chaque modification qui change la version du graphe est recalculée, et
+/// une entrée est remplacée quand le cache est plein.
+static int SelfTest_cache(const SelfTestReference* reference) {
+    if (Graph_size(reference->graph) <= SELF_TEST_CACHE_CAPACITY) {
+        printf("  %-28s skipped, the graph is too small\n", "Shortest path cache");
+        return 0;
+    }
+
+    Graph* copy = Graph_snapshot(reference->graph);
+    int size = Graph_size(copy);
+    int start = reference->sources[0];
+    int end = size - 1;
+    int* predecessors = (int*)malloc(size * sizeof(int));
+    AssertNew(predecessors);
+    float* expected = (float*)malloc(size * sizeof(float));
+    AssertNew(expected);
+
+    // With a workspace, the queries without a path stay silent
+    ShortestPathCache* cache = ShortestPathCache_create(SELF_TEST_CACHE_CAPACITY);
+    ShortestPathOptions options = ShortestPathOptions_default();
+    options.workspace = DijkstraWorkspace_create(copy);
+
+    int errors = 0;
+    Graph_dijkstra(copy, start, -1, predecessors, expected, NULL);
+    errors += SelfTest_cacheQuery(cache, copy, start, end, expected, &options, false);
+    errors += SelfTest_cacheQuery(cache, copy, start, end, expected, &options, true);
+
+    // Each edit changes the version : the next query is computed again
+    for (int edit = 0; edit < 3; edit++) {
+        if (edit == 0) {
+            Graph_addArc(copy, start, end, 1);
+        } else if (edit == 1) {
+            Graph_setArcWeight(copy, Graph_arcEnd(copy, start) - 1, 0);
+        } else {
+            Graph_removeArc(copy, Graph_arcEnd(copy, start) - 1);
+        }
+        Graph_dijkstra(copy, start, -1, predecessors, expected, NULL);
+        errors += SelfTest_cacheQuery(cache, copy, start, end, expected, &options, false);
+        errors += SelfTest_cacheQuery(cache, copy, start, end, expected, &options, true);
+    }
+
+    // Moves keep the version
+    Vector2 position = Graph_getNodePosition(copy, end);
+    position.x += 1.0f;
+    Graph_moveNode(copy, end, position);
+    errors += SelfTest_cacheQuery(cache, copy, start, end, expected, &options, true);
+
+    // A full cache keeps every result until one more is inserted. CLOCK then
+    // gives a second chance to the oldest entry, which has been used again,
+    // and replaces the next one
+    ShortestPathCache_clear(cache);
+    for (int v = 0; v < SELF_TEST_CACHE_CAPACITY; v++) {
+        errors += SelfTest_cacheQuery(cache, copy, start, v, expected, &options, false);
+    }
+    errors += SelfTest_cacheQuery(cache, copy, start, SELF_TEST_CACHE_CAPACITY - 1, expected, &options, true);
+    errors += SelfTest_cacheQuery(cache, copy, start, 0, expected, &options, true);
+    errors += SelfTest_cacheQuery(cache, copy, start, SELF_TEST_CACHE_CAPACITY, expected, &options, false);
+    errors += SelfTest_cacheQuery(cache, copy, start, 0, expected, &options, true);
+    errors += SelfTest_cacheQuery(cache, copy, start, 1, expected, &options, false);
+
+    DijkstraWorkspace_destroy(options.workspace);
+    ShortestPathCache_destroy(cache);
+    free(predecessors);
+    free(expected);
+    Graph_destroy(copy);
+    return SelfTest_report("Shortest path cache", errors);
+}
+
+/// @brief Modifie au hasard les arcs d'une copie du graphe et compare après
+/// chaque modification l'arbre dynamique à un nouveau calcul de Graph_dijkstra().
+static int SelfTest_dynamic(Graph* graph) {
+    if (Graph_size(graph) == 0) {
+        return SelfTest_report("Dynamic shortest paths", 0);
+    }
+
+    Graph* copy = Graph_snapshot(graph);
+    DynamicShortestPath* tree = DynamicShortestPath_create(copy, 0);
+    int size = Graph_size(copy);
+    int* predecessors = (int*)malloc(size * sizeof(int));
+    AssertNew(predecessors);
+    float* expected = (float*)malloc(size * sizeof(float));
+    AssertNew(expected);
+
+    uint32_t state = 362436069u;
+    int errors = 0;
+    for (int edit = 0; edit < SELF_TEST_EDITS; edit++) {
+        int weight = (int)(SelfTest_random(&state) % (SELF_TEST_MAX_WEIGHT + 1));
+        int choice = (int)(SelfTest_random(&state) % 3);
+        if (choice == 0 || Graph_arcCount(copy) == 0) {
+            int from = (int)(SelfTest_random(&state) % size);
+            int to = (int)(SelfTest_random(&state) % size);
+            Graph_addArc(copy, from, to, weight);
+        } else if (choice == 1) {
+            Graph_removeArc(copy, (int)(SelfTest_random(&state) % Graph_arcCount(copy)));
+        } else {
+            Graph_setArcWeight(copy, (int)(SelfTest_random(&state) % Graph_arcCount(copy)), weight);
+        }
+
+        Graph_dijkstra(copy, tree->source, -1, predecessors, expected, NULL);
+        for (int v = 0; v < size; v++) {
+            if (DynamicShortestPath_distance(tree, v) != expected[v]) {
+                errors++;
+            } else {
+                errors += SelfTest_chainErrors(copy, expected, tree->source, v, tree->predecessors);
+            }
+        }
+    }
+
+    free(predecessors);
+    free(expected);
+    DynamicShortestPath_destroy(tree);
+    Graph_destroy(copy);
+    return SelfTest_report("Dynamic shortest paths", errors);
+}
+
+/// @brief Enregistre le graphe au format JSON puis le recharge : le graphe
+/// relu doit avoir la même empreinte et les mêmes positions, au dixième près.
+static int SelfTest_json(Graph* graph) {
+    if (!Graph_saveAs(graph, SELF_TEST_JSON_FILE, false, NULL)) {
+        return SelfTest_report("JSON round trip", 1);
+    }
+
+    int errors = 0;
+    Graph* copy = Graph_loadFile(SELF_TEST_JSON_FILE);
+    if (copy == NULL || Graph_size(copy) != Graph_size(graph) || Graph_fingerprint(copy) != Graph_fingerprint(graph)) {
+        errors++;
+    } else {
+        for (int v = 0; v < Graph_size(graph); v++) {
+            Vector2 position = Graph_getNodePosition(graph, v);
+            Vector2 reloaded = Graph_getNodePosition(copy, v);
+            if (fabsf(position.x - reloaded.x) > 0.051f || fabsf(position.y - reloaded.y) > 0.051f) {
+                errors++;
+            }
+        }
+    }
+    Graph_destroy(copy);
+
+    remove(SELF_TEST_JSON_FILE);
+    return SelfTest_report("JSON round trip", errors);
+}
+
+/// @brief Renumérote dans l'ordre demandé une copie journalisée du graphe :
+/// les identifiants doivent suivre leurs sommets, les distances de Graph_dijkstra()
+/// ne doivent pas changer et le journal rejoué doit redonner la même numérotation.
+static int SelfTest_renumber(const SelfTestReference* reference, NodeOrder order, const char* engine) {
+    Graph* graph = reference->graph;
+    if (!Graph_saveBinary(graph, SELF_TEST_FILE)) {
+        return SelfTest_report(engine, 1);
+    }
+
+    Graph* copy = Graph_loadFile(SELF_TEST_FILE);
+    EditJournal* journal = copy != NULL ? EditJournal_open(copy) : NULL;
+    if (journal == NULL) {
+        Graph_destroy(copy);
+        remove(SELF_TEST_FILE);
+        return SelfTest_report(engine, 1);
+    }
+
+    int size = Graph_size(copy);
+    int* predecessors = (int*)malloc(maxInt(size, 1) * sizeof(int));
+    AssertNew(predecessors);
+    float* distances = (float*)malloc(maxInt(size, 1) * sizeof(float));
+    AssertNew(distances);
+
+    NodePermutation* permutation = Graph_renumber(copy, order);
+    int* newIndices = permutation->newIndices;
+    int errors = 0;
+
+    // Each identifier follows its node, and the index of an identifier is up to date
+    for (int v = 0; v < size; v++) {
+        if (strcmp(Graph_getNodeId(copy, newIndices[v]), Graph_getNodeId(graph, v)) != 0
+            || Graph_getNodeIndex(copy, Graph_getNodeId(copy, v)) != v) {
+            errors++;
+        }
+    }
+
+    for (int i = 0; i < reference->sourcesCount; i++) {
+        Graph_dijkstra(copy, newIndices[reference->sources[i]], -1, predecessors, distances, NULL);
+        for (int v = 0; v < size; v++) {
+            if (distances[newIndices[v]] != SelfTestReference_distance(reference, i, v)) {
+                errors++;
+            }
+        }
+    }
+
+    EditJournal_commit(journal);
+    uint64_t fingerprint = Graph_fingerprint(copy);
+    EditJournal_close(journal);
+    Graph_destroy(copy);
+
+    // The journal renumbers the snapshot the same way
+    copy = Graph_loadFile(SELF_TEST_FILE);
+    journal = copy != NULL ? EditJournal_open(copy) : NULL;
+    if (journal == NULL || Graph_size(copy) != size || Graph_fingerprint(copy) != fingerprint) {
+        errors++;
+    } else {
+        for (int v = 0; v < size; v++) {
+            if (Graph_getNodeIndex(copy, Graph_getNodeId(graph, v)) != newIndices[v]) {
+                errors++;
+            }
+        }
+    }
+    EditJournal_close(journal);
+    Graph_destroy(copy);
+
+    NodePermutation_destroy(permutation);
+    free(predecessors);
+    free(distances);
+    remove(SELF_TEST_FILE);
+    remove(SELF_TEST_FILE EDIT_JOURNAL_EXTENSION);
+    return SelfTest_report(engine, errors);
+}
+
+/// @brief Vérifie tous les moteurs sur un graphe.
+/// @return Le nombre de moteurs en échec.
+static int SelfTest_graph(Graph* graph, const char* name) {
+    printf("%s : %d nodes, %d arcs\n", name, Graph_size(graph), Graph_arcCount(graph));
+
+    SelfTestReference reference;
+    SelfTestReference_init(&reference, graph);
+    int size = Graph_size(graph);
+    int* predecessors = (int*)malloc(maxInt(size, 1) * sizeof(int));
+    AssertNew(predecessors);
+    float* distances = (float*)malloc(maxInt(size, 1) * sizeof(float));
+    AssertNew(distances);
+
+    int failures = 0;
+    failures += SelfTest_bfs(&reference, predecessors, distances);
+    failures += SelfTest_dijkstra(&reference, DIJKSTRA_QUEUE_HEAP, "Dijkstra, heap", predecessors, distances);
+    failures += SelfTest_dijkstra(&reference, DIJKSTRA_QUEUE_SCAN, "Dijkstra, linear scan", predecessors, distances);
+    failures += SelfTest_dijkstra(&reference, DIJKSTRA_QUEUE_BUCKET, "Dijkstra, buckets", predecessors, distances);
+    failures += SelfTest_dijkstraInt(&reference, predecessors);
+    failures += SelfTest_deltaStepping(&reference, predecessors, distances);
+    failures += SelfTest_pointToPoint(&reference, "Bidirectional Dijkstra", Graph_bidirectionalDijkstra, NULL, predecessors, distances);
+    failures += SelfTest_pointToPoint(&reference, "A* with coordinates", Graph_astar, NULL, predecessors, distances);
+    failures += SelfTest_alt(&reference, predecessors, distances);
+    failures += SelfTest_allPairs(&reference);
+    failures += SelfTest_contractionHierarchy(&reference);
+    failures += SelfTest_hubLabels(&reference);
+    failures += SelfTest_batch(&reference);
+    failures += SelfTest_cache(&reference);
+    failures += SelfTest_reachability(&reference);
+    failures += SelfTest_dynamic(graph);
+    failures += SelfTest_spanningForest(graph);
+    failures += SelfTest_json(graph);
+    failures += SelfTest_journal(graph);
+    failures += SelfTest_renumber(&reference, NODE_ORDER_BFS, "Renumbering, BFS order");
+    failures += SelfTest_renumber(&reference, NODE_ORDER_RCM, "Renumbering, RCM order");
+    failures += SelfTest_renumber(&reference, NODE_ORDER_HILBERT, "Renumbering, Hilbert order");
+
+    free(predecessors);
+    free(distances);
+    SelfTestReference_destroy(&reference);
+    return failures;
+}
+
+int SelfTest_run(const char* fileName) {
+    int failures = 0;
+
+    if (fileName != NULL) {
+        Graph* graph = Graph_loadFile(fileName);
+        if (graph == NULL) {
+            printf("%s : cannot be loaded\n", fileName);
+            failures++;
+        } else {
+            failures += SelfTest_graph(graph, fileName);
+            Graph_destroy(graph);
+        }
+    }
+
+    // Fixed seeds : the random graphs are the same at each run
+    Graph* weighted = SelfTest_randomGraph(SELF_TEST_NODES, SELF_TEST_ARCS, SELF_TEST_MAX_WEIGHT, 2463534242u);
+    failures += SelfTest_graph(weighted, "Random weighted graph");
+    Graph_destroy(weighted);
+
+    Graph* unweighted = SelfTest_randomGraph(SELF_TEST_NODES, SELF_TEST_ARCS, 0, 88675123u);
+    failures += SelfTest_graph(unweighted, "Random unweighted graph");
+    Graph_destroy(unweighted);
+
+    // Many zero-weight arcs : equal distances and zero-length cycles
+    Graph* zeroWeights = SelfTest_randomGraph(SELF_TEST_NODES, SELF_TEST_ARCS, 1, 521288629u);
+    failures += SelfTest_graph(zeroWeights, "Random graph, weights 0 and 1");
+    Graph_destroy(zeroWeights);
+
+    if (failures == 0) {
+        printf("Every engine agrees with Graph_dijkstra\n");
+    } else {
+        printf("%d engine checks failed\n", failures);
+    }
+    return failures;
+}
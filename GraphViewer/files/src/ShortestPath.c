@@ -1,41 +1,180 @@
 #include "ShortestPath.h"
+#include "ContractionHierarchy.h"
+#include "AltIndex.h"
+#include "HubLabels.h"
+#include "BreadthFirstSearch.h"
+#include "ReachabilityIndex.h"
+
+ShortestPathOptions ShortestPathOptions_default() {
+    ShortestPathOptions options;
+    options.method = SHORTEST_PATH_DIJKSTRA;
+    options.queue = DIJKSTRA_QUEUE_HEAP;
+    options.heapArity = 4;
+    options.heuristicScale = -1.0f;
+    options.landmarks = NULL;
+    options.workspace = NULL;
+    options.stats = NULL;
+    options.hierarchy = NULL;
+    options.hubLabels = NULL;
+    options.reachability = NULL;
+    return options;
+}
+
+DijkstraWorkspace* DijkstraWorkspace_create(Graph* graph) {
+    DijkstraWorkspace* workspace = (DijkstraWorkspace*)calloc(1, sizeof(DijkstraWorkspace));
+    AssertNew(workspace);
+    DijkstraWorkspace_reset(workspace, graph, 4);
+    return workspace;
+}
 
-int Graph_getNodeIndex(Graph* graph, const char* nodeId) {
-    printf("nodeId : %s\n", nodeId);
+void DijkstraWorkspace_destroy(DijkstraWorkspace* workspace) {
+    if (workspace == NULL) return;
 
-    NodesList* current = graph->nodes;
-    int index = 0;
-    while (current != NULL && current->node != NULL) {
-        if (strcmp(current->node->id, nodeId) == 0) {
-            return index;
-        }
-        current = current->next;
-        index++;
+    free(workspace->stamps);
+    free(workspace->distances);
+    free(workspace->predecessors);
+    IndexedHeap_destroy(workspace->heap);
+    free(workspace);
+}
+
+void DijkstraWorkspace_reset(DijkstraWorkspace* workspace, Graph* graph, int arity) {
+    int size = graph->nodesCount;
+    arity = maxInt(arity, 2);
+
+    if (size > workspace->capacity || workspace->stamps == NULL) {
+        int capacity = maxInt(size, 1);
+        free(workspace->stamps);
+        free(workspace->distances);
+        free(workspace->predecessors);
+
+        workspace->stamps = (uint32_t*)calloc(capacity, sizeof(uint32_t));
+        AssertNew(workspace->stamps);
+        workspace->distances = (float*)malloc(capacity * sizeof(float));
+        AssertNew(workspace->distances);
+        workspace->predecessors = (int*)malloc(capacity * sizeof(int));
+        AssertNew(workspace->predecessors);
+        workspace->capacity = capacity;
+        workspace->generation = 0;
+
+        IndexedHeap_destroy(workspace->heap);
+        workspace->heap = NULL;
+    }
+
+    if (workspace->heap == NULL || workspace->heap->arity != arity) {
+        IndexedHeap_destroy(workspace->heap);
+        workspace->heap = IndexedHeap_create(workspace->capacity, arity);
+    } else {
+        IndexedHeap_clear(workspace->heap);
+    }
+
+    // Stamp 0 is never a valid generation, on wrap around every stamp is cleared
+    workspace->generation++;
+    if (workspace->generation == 0) {
+        memset(workspace->stamps, 0, workspace->capacity * sizeof(uint32_t));
+        workspace->generation = 1;
     }
-    return -1; // Node not found
 }
 
-char* Graph_getNodeId(Graph* graph, int index) {
-    printf("node index : %d\n", index);
+static void DijkstraWorkspace_update(DijkstraWorkspace* workspace, int node, float distance, int predecessor) {
+    workspace->stamps[node] = workspace->generation;
+    workspace->distances[node] = distance;
+    workspace->predecessors[node] = predecessor;
+}
 
-    NodesList* current = graph->nodes;
-    int i = 0;
-    while (current != NULL && current->node != NULL) {
-        if (i == index) {
-            return _strdup(current->node->id);
-        }
-        current = current->next;
-        i++;
+/// @brief Copie le résultat de la dernière requête dans des tableaux de taille n.
+static void DijkstraWorkspace_export(DijkstraWorkspace* workspace, int size, int* predecessors, float* distances) {
+    if (predecessors == NULL || distances == NULL) return;
+
+    for (int i = 0; i < size; i++) {
+        predecessors[i] = DijkstraWorkspace_predecessor(workspace, i);
+        distances[i] = DijkstraWorkspace_distance(workspace, i);
+    }
+}
+
+/// @brief Alloue un chemin de length sommets, à remplir par l'appelant.
+static Path* Path_allocate(int length) {
+    Path* path = (Path*)calloc(1, sizeof(Path));
+    AssertNew(path);
+
+    path->capacity = maxInt(length, 4);
+    path->nodes = (int*)malloc(path->capacity * sizeof(int));
+    AssertNew(path->nodes);
+    path->length = length;
+    path->distance = 0.0f;
+
+    return path;
+}
+
+Path* DijkstraWorkspace_getPath(DijkstraWorkspace* workspace, Graph* graph, int end) {
+    assert(workspace && graph);
+    assert(end >= 0);
+
+    // Batch and cached queries miss often, they are not reported
+    if (DijkstraWorkspace_predecessor(workspace, end) < 0) {
+        return NULL;
     }
-    return NULL; // Node not found
+
+    int length = 1;
+    for (int currID = end; DijkstraWorkspace_predecessor(workspace, currID) >= 0; currID = DijkstraWorkspace_predecessor(workspace, currID)) {
+        length++;
+    }
+
+    Path* path = Path_allocate(length);
+    int currID = end;
+    for (int i = length - 1; i >= 0; i--) {
+        path->nodes[i] = currID;
+        currID = DijkstraWorkspace_predecessor(workspace, currID);
+    }
+
+    path->distance = DijkstraWorkspace_distance(workspace, end);
+
+    return path;
 }
 
-Path* Graph_shortestPath(Graph* graph, const char* startId, const char* endId) {
+Path* Graph_shortestPath(Graph* graph, const char* startId, const char* endId, const ShortestPathOptions* options) {
     int start = Graph_getNodeIndex(graph, startId);
     int end = Graph_getNodeIndex(graph, endId);
 
     assert(!(start == -1 || end == -1));
 
+    // Whatever the method, a node is reached from itself by an empty path
+    if (start == end) {
+        if (options != NULL && options->stats != NULL) {
+            options->stats->settledCount = 0;
+        }
+        return Path_create(start);
+    }
+
+    // Impossible queries are rejected before any search
+    if (options != NULL && options->reachability != NULL
+        && ReachabilityIndex_query(options->reachability, start, end) == REACHABILITY_NO) {
+        if (options->stats != NULL) {
+            options->stats->settledCount = 0;
+        }
+        return NULL;
+    }
+
+    ShortestPathMethod method = options != NULL ? options->method : SHORTEST_PATH_DIJKSTRA;
+    if (method == SHORTEST_PATH_CH) {
+        assert(options->hierarchy);
+        return ContractionHierarchy_shortestPath(options->hierarchy, graph, start, end, options->stats);
+    }
+    if (method == SHORTEST_PATH_HUB_LABELS) {
+        assert(options->hubLabels);
+        return HubLabels_shortestPath(options->hubLabels, graph, start, end, options->stats);
+    }
+
+    // With a workspace nothing of size n is allocated or initialised
+    if (options != NULL && options->workspace != NULL
+        && (method == SHORTEST_PATH_DIJKSTRA || method == SHORTEST_PATH_ASTAR)) {
+        if (method == SHORTEST_PATH_ASTAR) {
+            Graph_astar(graph, start, end, NULL, NULL, options);
+        } else {
+            Graph_dijkstra(graph, start, end, NULL, NULL, options);
+        }
+        return DijkstraWorkspace_getPath(options->workspace, graph, end);
+    }
+
     int size = graph->nodesCount;
     int* predecessors = (int*)calloc(size, sizeof(int));
     AssertNew(predecessors);
@@ -43,7 +182,26 @@ Path* Graph_shortestPath(Graph* graph, const char* startId, const char* endId) {
     float* distances = (float*)calloc(size, sizeof(float));
     AssertNew(distances);
 
-    Graph_dijkstra(graph, start, end, predecessors, distances);
+    switch (method) {
+    case SHORTEST_PATH_ASTAR:
+        Graph_astar(graph, start, end, predecessors, distances, options);
+        break;
+
+    case SHORTEST_PATH_BIDIRECTIONAL:
+        Graph_bidirectionalDijkstra(graph, start, end, predecessors, distances, options);
+        break;
+
+    case SHORTEST_PATH_DIJKSTRA:
+    default:
+        // Every arc has the same weight : a breadth-first search is enough,
+        // unless another queue than the heap was asked for
+        if ((options == NULL || options->queue == DIJKSTRA_QUEUE_HEAP) && Graph_uniformWeight(graph) >= 0) {
+            Graph_bfs(graph, start, end, predecessors, distances, Graph_uniformWeight(graph), options != NULL ? options->stats : NULL);
+        } else {
+            Graph_dijkstra(graph, start, end, predecessors, distances, options);
+        }
+        break;
+    }
 
     Path* path = Graph_dijkstraGetPath(graph, predecessors, distances, end);
 
@@ -55,7 +213,7 @@ Path* Graph_shortestPath(Graph* graph, const char* startId, const char* endId) {
     return path;
 }
 
-void Graph_dijkstra(Graph* graph, int start, int end, int* predecessors, float* distances) {
+static int Graph_dijkstraScan(Graph* graph, int end, int* predecessors, float* distances) {
     int size = graph->nodesCount;
 
     bool* explored = (bool*)calloc(size, sizeof(bool));
@@ -64,12 +222,7 @@ void Graph_dijkstra(Graph* graph, int start, int end, int* predecessors, float*
         exit(EXIT_FAILURE);
     }
 
-    for (int i = 0; i < size; i++) {
-        predecessors[i] = -1;
-        distances[i] = INFINITY;
-    }
-    distances[start] = 0.0f;
-
+    int settled = 0;
     while (true) {
         int currID = -1;
         float currDist = INFINITY;
@@ -81,32 +234,401 @@ void Graph_dijkstra(Graph* graph, int start, int end, int* predecessors, float*
         }
 
         if (currID < 0 || currID == end) {
-            printf("Stopping at node %d\n", currID);
             break;
         }
 
-        printf("Exploring node %d with current distance %f\n", currID, currDist);
         explored[currID] = true;
+        settled++;
 
-        NodesList* arc = Graph_getArcList(graph, currID);
-        while (arc != NULL) {
-            printf("Exploring arc to node %s (weight: %d)\n", arc->node->id, arc->weight);
-            int nextID = Graph_getNodeIndex(graph, arc->node->id);
-            if (nextID == -1) {
-                printf("Invalid node %s\n", arc->node->id);
-                continue; // Invalid node, skip
-            }
+        int arcEnd = Graph_arcEnd(graph, currID);
+        for (int arc = Graph_arcBegin(graph, currID); arc < arcEnd; arc++) {
+            int nextID = Graph_arcTarget(graph, arc);
 
-            float dist = distances[currID] + arc->weight;
+            float dist = distances[currID] + Graph_arcWeight(graph, arc);
             if (distances[nextID] > dist) {
-                printf("Updating distance for node %d: %f -> %f\n", nextID, distances[nextID], dist);
                 distances[nextID] = dist;
                 predecessors[nextID] = currID;
             }
-            arc = arc->next;
         }
     }
     free(explored);
+    return settled;
+}
+
+static int Graph_dijkstraHeap(Graph* graph, int start, int end, DijkstraWorkspace* workspace) {
+    // A node leaves the heap exactly once, with its final distance
+    IndexedHeap* heap = workspace->heap;
+    DijkstraWorkspace_update(workspace, start, 0.0f, -1);
+    IndexedHeap_push(heap, start, 0.0f);
+
+    int settled = 0;
+    while (!IndexedHeap_isEmpty(heap)) {
+        int currID = IndexedHeap_pop(heap);
+        settled++;
+        if (currID == end) {
+            break;
+        }
+
+        int arcEnd = Graph_arcEnd(graph, currID);
+        for (int arc = Graph_arcBegin(graph, currID); arc < arcEnd; arc++) {
+            int nextID = Graph_arcTarget(graph, arc);
+
+            float dist = workspace->distances[currID] + Graph_arcWeight(graph, arc);
+            if (DijkstraWorkspace_distance(workspace, nextID) > dist) {
+                DijkstraWorkspace_update(workspace, nextID, dist, currID);
+                IndexedHeap_push(heap, nextID, dist);
+            }
+        }
+    }
+    return settled;
+}
+
+/// @brief Dijkstra avec les files qui initialisent tous les sommets (balayage
+/// et seaux). Avec un espace de travail, le calcul se fait dans ses tableaux,
+/// dont tous les tampons sont ensuite mis à jour.
+static int Graph_dijkstraArrays(Graph* graph, int start, int end, int* predecessors, float* distances, const ShortestPathOptions* options) {
+    int size = graph->nodesCount;
+
+    DijkstraWorkspace* workspace = options->workspace;
+    int* outPredecessors = predecessors;
+    float* outDistances = distances;
+    if (workspace != NULL) {
+        DijkstraWorkspace_reset(workspace, graph, options->heapArity);
+        predecessors = workspace->predecessors;
+        distances = workspace->distances;
+    }
+
+    for (int i = 0; i < size; i++) {
+        predecessors[i] = -1;
+        distances[i] = INFINITY;
+    }
+    distances[start] = 0.0f;
+
+    int settled = 0;
+    if (options->queue == DIJKSTRA_QUEUE_SCAN) {
+        settled = Graph_dijkstraScan(graph, end, predecessors, distances);
+    } else {
+        int64_t* exactDistances = (int64_t*)malloc(size * sizeof(int64_t));
+        AssertNew(exactDistances);
+
+        settled = Graph_dijkstraInt(graph, start, end, predecessors, exactDistances);
+        for (int i = 0; i < size; i++) {
+            distances[i] = exactDistances[i] == INT_DISTANCE_INFINITY ? INFINITY : (float)exactDistances[i];
+        }
+        free(exactDistances);
+    }
+
+    if (workspace != NULL) {
+        for (int i = 0; i < size; i++) {
+            workspace->stamps[i] = workspace->generation;
+        }
+        DijkstraWorkspace_export(workspace, size, outPredecessors, outDistances);
+    }
+    return settled;
+}
+
+void Graph_dijkstra(Graph* graph, int start, int end, int* predecessors, float* distances, const ShortestPathOptions* options) {
+    ShortestPathOptions defaultOptions = ShortestPathOptions_default();
+    if (options == NULL) {
+        options = &defaultOptions;
+    }
+
+    DijkstraWorkspace* workspace = options->workspace;
+    assert(workspace != NULL || (predecessors != NULL && distances != NULL));
+
+    int settled = 0;
+    switch (options->queue) {
+    case DIJKSTRA_QUEUE_SCAN:
+    case DIJKSTRA_QUEUE_BUCKET:
+        settled = Graph_dijkstraArrays(graph, start, end, predecessors, distances, options);
+        break;
+
+    case DIJKSTRA_QUEUE_HEAP:
+    default:
+    {
+        DijkstraWorkspace* heapWorkspace = workspace != NULL ? workspace : DijkstraWorkspace_create(graph);
+        DijkstraWorkspace_reset(heapWorkspace, graph, options->heapArity);
+
+        settled = Graph_dijkstraHeap(graph, start, end, heapWorkspace);
+
+        DijkstraWorkspace_export(heapWorkspace, graph->nodesCount, predecessors, distances);
+        if (workspace == NULL) {
+            DijkstraWorkspace_destroy(heapWorkspace);
+        }
+        break;
+    }
+    }
+
+    if (options->stats != NULL) {
+        options->stats->settledCount = settled;
+    }
+}
+
+int Graph_dijkstraInt(Graph* graph, int start, int end, int* predecessors, int64_t* distances) {
+    int size = graph->nodesCount;
+    for (int i = 0; i < size; i++) {
+        predecessors[i] = -1;
+        distances[i] = INT_DISTANCE_INFINITY;
+    }
+    distances[start] = 0;
+
+    int maxWeight = Graph_maxWeight(graph);
+
+    // Both queues keep several entries per node : an entry whose key is
+    // larger than the current distance of its node is outdated and skipped
+    bool dial = maxWeight <= DIAL_MAX_WEIGHT;
+    BucketQueue* buckets = dial ? BucketQueue_create(maxWeight) : NULL;
+    RadixHeap* radix = dial ? NULL : RadixHeap_create();
+
+    if (dial) BucketQueue_push(buckets, start, 0);
+    else RadixHeap_push(radix, start, 0);
+
+    int settled = 0;
+    while (dial ? !BucketQueue_isEmpty(buckets) : !RadixHeap_isEmpty(radix)) {
+        BucketEntry entry = dial ? BucketQueue_pop(buckets) : RadixHeap_pop(radix);
+        int currID = entry.item;
+        if ((int64_t)entry.key > distances[currID]) {
+            continue;
+        }
+        settled++;
+        if (currID == end) {
+            break;
+        }
+
+        int arcEnd = Graph_arcEnd(graph, currID);
+        for (int arc = Graph_arcBegin(graph, currID); arc < arcEnd; arc++) {
+            int nextID = Graph_arcTarget(graph, arc);
+            assert(Graph_arcWeight(graph, arc) >= 0);
+
+            int64_t dist = distances[currID] + Graph_arcWeight(graph, arc);
+            if (distances[nextID] > dist) {
+                distances[nextID] = dist;
+                predecessors[nextID] = currID;
+                if (dial) BucketQueue_push(buckets, nextID, (uint64_t)dist);
+                else RadixHeap_push(radix, nextID, (uint64_t)dist);
+            }
+        }
+    }
+
+    BucketQueue_destroy(buckets);
+    RadixHeap_destroy(radix);
+    return settled;
+}
+
+void Graph_bidirectionalDijkstra(Graph* graph, int start, int end, int* predecessors, float* distances, const ShortestPathOptions* options) {
+    assert(end >= 0);
+
+    ShortestPathOptions defaultOptions = ShortestPathOptions_default();
+    if (options == NULL) {
+        options = &defaultOptions;
+    }
+    int arity = maxInt(options->heapArity, 2);
+
+    Graph_buildReverse(graph);
+
+    // The forward search works directly in predecessors / distances,
+    // the backward search stores the next node towards end
+    int size = graph->nodesCount;
+    float* backwardDistances = (float*)malloc(size * sizeof(float));
+    AssertNew(backwardDistances);
+    int* successors = (int*)malloc(size * sizeof(int));
+    AssertNew(successors);
+
+    for (int i = 0; i < size; i++) {
+        predecessors[i] = -1;
+        distances[i] = INFINITY;
+        successors[i] = -1;
+        backwardDistances[i] = INFINITY;
+    }
+    distances[start] = 0.0f;
+    backwardDistances[end] = 0.0f;
+
+    IndexedHeap* forward = IndexedHeap_create(size, arity);
+    IndexedHeap* backward = IndexedHeap_create(size, arity);
+    IndexedHeap_push(forward, start, 0.0f);
+    IndexedHeap_push(backward, end, 0.0f);
+
+    float best = start == end ? 0.0f : INFINITY;
+    int meeting = start == end ? start : -1;
+    int settled = 0;
+
+    while (!IndexedHeap_isEmpty(forward) && !IndexedHeap_isEmpty(backward)) {
+        float forwardMin = IndexedHeap_minKey(forward);
+        float backwardMin = IndexedHeap_minKey(backward);
+        if (forwardMin + backwardMin >= best) {
+            break;
+        }
+        settled++;
+
+        if (forwardMin <= backwardMin) {
+            int currID = IndexedHeap_pop(forward);
+
+            int arcEnd = Graph_arcEnd(graph, currID);
+            for (int arc = Graph_arcBegin(graph, currID); arc < arcEnd; arc++) {
+                int nextID = Graph_arcTarget(graph, arc);
+
+                float dist = distances[currID] + Graph_arcWeight(graph, arc);
+                if (distances[nextID] > dist) {
+                    distances[nextID] = dist;
+                    predecessors[nextID] = currID;
+                    IndexedHeap_push(forward, nextID, dist);
+                }
+                if (dist + backwardDistances[nextID] < best) {
+                    best = dist + backwardDistances[nextID];
+                    meeting = nextID;
+                }
+            }
+        } else {
+            int currID = IndexedHeap_pop(backward);
+
+            int arcEnd = Graph_inArcEnd(graph, currID);
+            for (int arc = Graph_inArcBegin(graph, currID); arc < arcEnd; arc++) {
+                int prevID = Graph_inArcSource(graph, arc);
+
+                float dist = backwardDistances[currID] + Graph_inArcWeight(graph, arc);
+                if (backwardDistances[prevID] > dist) {
+                    backwardDistances[prevID] = dist;
+                    successors[prevID] = currID;
+                    IndexedHeap_push(backward, prevID, dist);
+                }
+                if (dist + distances[prevID] < best) {
+                    best = dist + distances[prevID];
+                    meeting = prevID;
+                }
+            }
+        }
+    }
+
+    // Chain the backward half of the path after the forward half, so that
+    // Graph_dijkstraGetPath() can walk it back from end. With arcs of weight 0,
+    // the backward half may go through nodes of the forward half : it is only
+    // chained from the last of them, otherwise the predecessors would loop
+    if (meeting >= 0) {
+        bool* forwardHalf = (bool*)calloc(size, sizeof(bool));
+        AssertNew(forwardHalf);
+        for (int currID = meeting; currID >= 0; currID = predecessors[currID]) {
+            forwardHalf[currID] = true;
+        }
+        int join = meeting;
+        for (int currID = meeting; currID != end; ) {
+            currID = successors[currID];
+            if (forwardHalf[currID]) {
+                join = currID;
+            }
+        }
+        free(forwardHalf);
+
+        for (int currID = join; currID != end; currID = successors[currID]) {
+            int nextID = successors[currID];
+            predecessors[nextID] = currID;
+            distances[nextID] = best - backwardDistances[nextID];
+        }
+    }
+
+    IndexedHeap_destroy(forward);
+    IndexedHeap_destroy(backward);
+    free(backwardDistances);
+    free(successors);
+
+    if (options->stats != NULL) {
+        options->stats->settledCount = settled;
+    }
+}
+
+float Graph_astarAdmissibleScale(Graph* graph) {
+    if (graph->version != 0 && graph->astarScaleVersion == graph->version) {
+        return graph->astarScale;
+    }
+
+    float scale = INFINITY;
+    for (int u = 0; u < graph->nodesCount; u++) {
+        Vector2 from = Graph_getNodePosition(graph, u);
+
+        int arcEnd = Graph_arcEnd(graph, u);
+        for (int arc = Graph_arcBegin(graph, u); arc < arcEnd; arc++) {
+            Vector2 to = Graph_getNodePosition(graph, Graph_arcTarget(graph, arc));
+            float length = sqrtf((to.x - from.x) * (to.x - from.x) + (to.y - from.y) * (to.y - from.y));
+            if (length > 0.0f) {
+                scale = fminf(scale, Graph_arcWeight(graph, arc) / length);
+            }
+        }
+    }
+    // Without any arc of positive length every scale is admissible, the
+    // heuristic is then disabled
+    graph->astarScale = isinf(scale) ? 0.0f : scale;
+    graph->astarScaleVersion = graph->version;
+    return graph->astarScale;
+}
+
+static float Graph_astarHeuristic(Graph* graph, const AltIndex* landmarks, int node, int end, Vector2 target, float scale) {
+    if (landmarks != NULL) {
+        return AltIndex_lowerBound(landmarks, node, end);
+    }
+
+    Vector2 position = Graph_getNodePosition(graph, node);
+    float dx = position.x - target.x;
+    float dy = position.y - target.y;
+    return scale * sqrtf(dx * dx + dy * dy);
+}
+
+void Graph_astar(Graph* graph, int start, int end, int* predecessors, float* distances, const ShortestPathOptions* options) {
+    assert(end >= 0);
+
+    ShortestPathOptions defaultOptions = ShortestPathOptions_default();
+    if (options == NULL) {
+        options = &defaultOptions;
+    }
+    const AltIndex* landmarks = options->landmarks;
+    assert(landmarks == NULL || AltIndex_matches(options->landmarks, graph));
+
+    float scale = 0.0f;
+    if (landmarks == NULL) {
+        scale = options->heuristicScale >= 0.0f ? options->heuristicScale : Graph_astarAdmissibleScale(graph);
+    }
+    Vector2 target = Graph_getNodePosition(graph, end);
+
+    DijkstraWorkspace* workspace = options->workspace != NULL ? options->workspace : DijkstraWorkspace_create(graph);
+    assert(options->workspace != NULL || (predecessors != NULL && distances != NULL));
+    DijkstraWorkspace_reset(workspace, graph, options->heapArity);
+
+    // Same loop as Dijkstra, the heap being ordered by distance + heuristic.
+    // With an inconsistent heuristic a node may be pushed again once settled
+    IndexedHeap* heap = workspace->heap;
+    DijkstraWorkspace_update(workspace, start, 0.0f, -1);
+    IndexedHeap_push(heap, start, Graph_astarHeuristic(graph, landmarks, start, end, target, scale));
+
+    int settled = 0;
+    while (!IndexedHeap_isEmpty(heap)) {
+        int currID = IndexedHeap_pop(heap);
+        settled++;
+        if (currID == end) {
+            break;
+        }
+
+        int arcEnd = Graph_arcEnd(graph, currID);
+        for (int arc = Graph_arcBegin(graph, currID); arc < arcEnd; arc++) {
+            int nextID = Graph_arcTarget(graph, arc);
+
+            float dist = workspace->distances[currID] + Graph_arcWeight(graph, arc);
+            if (DijkstraWorkspace_distance(workspace, nextID) > dist) {
+                DijkstraWorkspace_update(workspace, nextID, dist, currID);
+
+                float estimate = Graph_astarHeuristic(graph, landmarks, nextID, end, target, scale);
+                if (!isinf(estimate)) {
+                    IndexedHeap_push(heap, nextID, dist + estimate);
+                }
+            }
+        }
+    }
+
+    DijkstraWorkspace_export(workspace, graph->nodesCount, predecessors, distances);
+    if (options->workspace == NULL) {
+        DijkstraWorkspace_destroy(workspace);
+    }
+
+    if (options->stats != NULL) {
+        options->stats->settledCount = settled;
+    }
 }
 
 Path* Graph_dijkstraGetPath(Graph* graph, int* predecessors, float* distances, int end) {
@@ -118,17 +640,17 @@ Path* Graph_dijkstraGetPath(Graph* graph, int* predecessors, float* distances, i
         return NULL;
     }
 
-    char* endId = Graph_getNodeId(graph, end);
-    Path* path = Path_create(endId);
-    free(endId);
+    int length = 1;
+    for (int currID = end; predecessors[currID] >= 0; currID = predecessors[currID]) {
+        length++;
+    }
 
+    // Filled backwards, from end to the start
+    Path* path = Path_allocate(length);
     int currID = end;
-
-    while (predecessors[currID] >= 0) {
+    for (int i = length - 1; i >= 0; i--) {
+        path->nodes[i] = currID;
         currID = predecessors[currID];
-        char* nodeId = Graph_getNodeId(graph, currID);
-        ListStr_insertFirst(path->list, nodeId);
-        free(nodeId);
     }
 
     path->distance = distances[end];
@@ -136,32 +658,54 @@ Path* Graph_dijkstraGetPath(Graph* graph, int* predecessors, float* distances, i
     return path;
 }
 
-Path* Path_create(const char* startId) {
-    Path* path = (Path*)calloc(1, sizeof(Path));
-    AssertNew(path);
+Path* Path_create(int start) {
+    Path* path = Path_allocate(1);
+    path->nodes[0] = start;
+    return path;
+}
 
-    path->distance = 0.0f;
-    path->list = ListStr_create();
-    char* nodeId = _strdup(startId);
-    AssertNew(nodeId);
-    ListStr_insertLast(path->list, nodeId);
+void Path_append(Path* path, int node) {
+    if (path->length == path->capacity) {
+        path->capacity *= 2;
+        path->nodes = (int*)realloc(path->nodes, path->capacity * sizeof(int));
+        AssertNew(path->nodes);
+    }
+    path->nodes[path->length++] = node;
+}
 
-    return path;
+Path* Path_copy(const Path* path) {
+    if (path == NULL) return NULL;
+
+    Path* copy = Path_allocate(path->length);
+    memcpy(copy->nodes, path->nodes, path->length * sizeof(int));
+    copy->distance = path->distance;
+    return copy;
 }
 
 void Path_destroy(Path* path) {
     if (path == NULL) return;
 
-    ListStr_destroy(path->list);
+    free(path->nodes);
     free(path);
 }
 
-void Path_print(Path* path) {
+void Path_print(Path* path, Graph* graph) {
     if (path == NULL) {
         printf("path: NULL\n");
         return;
     }
 
     printf("path (distance = %f): ", path->distance);
-    ListStr_print(path->list);
+    for (int i = 0; i < path->length; i++) {
+        printf("%s ", Graph_getNodeId(graph, path->nodes[i]));
+    }
+    printf("\n");
+}
+
+ListStr* Path_toList(Path* path, Graph* graph) {
+    ListStr* list = ListStr_create();
+    for (int i = 0; i < path->length; i++) {
+        ListStr_insertLast(list, Graph_getNodeId(graph, path->nodes[i]));
+    }
+    return list;
 }
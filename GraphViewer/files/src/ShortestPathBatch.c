@@ -0,0 +1,223 @@
+#include "ShortestPathBatch.h"
+#include "Platform.h"
+
+/// @brief Données partagées par les tâches d'un lot. Une tâche traite une ligne.
+typedef struct BatchContext {
+    Graph* graph;
+    ShortestPathOptions options;
+    bool matrix;
+
+    /// @brief Départ de chaque ligne et arrivée de chaque ligne (paires) ou
+    /// de chaque colonne (matrice).
+    int* sources;
+    int* targets;
+
+    ShortestPathBatch* batch;
+
+    /// @brief Espace de travail et nombre de sommets traités de chaque thread.
+    DijkstraWorkspace** workspaces;
+    long long* settled;
+
+    /// @brief Chemins de chaque ligne mis bout à bout, et longueur de chaque case.
+    int** rowPaths;
+    int* pathLengths;
+} BatchContext;
+
+static int* Batch_nodeIndices(Graph* graph, const char* ids[], int count) {
+    int* indices = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+    AssertNew(indices);
+    for (int i = 0; i < count; i++) {
+        indices[i] = Graph_getNodeIndex(graph, ids[i]);
+        assert(indices[i] >= 0);
+    }
+    return indices;
+}
+
+/// @brief Range dans le tampon de la ligne le chemin vers target trouvé par
+/// la dernière recherche de l'espace de travail.
+static int Batch_appendPath(DijkstraWorkspace* workspace, int target, int** buffer, int* size, int* capacity) {
+    if (isinf(DijkstraWorkspace_distance(workspace, target))) {
+        return 0;
+    }
+
+    int length = 1;
+    for (int node = target; DijkstraWorkspace_predecessor(workspace, node) >= 0; node = DijkstraWorkspace_predecessor(workspace, node)) {
+        length++;
+    }
+
+    if (*size + length > *capacity) {
+        *capacity = maxInt(2 * *capacity, *size + length);
+        *buffer = (int*)realloc(*buffer, *capacity * sizeof(int));
+        AssertNew(*buffer);
+    }
+
+    // Written backwards, from target to the start
+    int position = *size + length;
+    for (int node = target; node >= 0; node = DijkstraWorkspace_predecessor(workspace, node)) {
+        (*buffer)[--position] = node;
+    }
+    *size += length;
+    return length;
+}
+
+static void Batch_rowTask(void* data, int row, int worker) {
+    BatchContext* context = (BatchContext*)data;
+    ShortestPathBatch* batch = context->batch;
+
+    if (context->workspaces[worker] == NULL) {
+        context->workspaces[worker] = DijkstraWorkspace_create(context->graph);
+    }
+    DijkstraWorkspace* workspace = context->workspaces[worker];
+
+    ShortestPathStats stats = { 0 };
+    ShortestPathOptions options = context->options;
+    options.workspace = workspace;
+    options.stats = &stats;
+
+    int start = context->sources[row];
+    if (context->matrix) {
+        Graph_dijkstra(context->graph, start, -1, NULL, NULL, &options);
+    } else if (options.method == SHORTEST_PATH_ASTAR) {
+        Graph_astar(context->graph, start, context->targets[row], NULL, NULL, &options);
+    } else {
+        Graph_dijkstra(context->graph, start, context->targets[row], NULL, NULL, &options);
+    }
+    context->settled[worker] += stats.settledCount;
+
+    int columns = batch->columnsCount;
+    int* buffer = NULL;
+    int size = 0;
+    int capacity = 0;
+    for (int column = 0; column < columns; column++) {
+        int target = context->matrix ? context->targets[column] : context->targets[row];
+        size_t cell = (size_t)row * columns + column;
+
+        batch->distances[cell] = DijkstraWorkspace_distance(workspace, target);
+        if (context->rowPaths != NULL) {
+            context->pathLengths[cell] = Batch_appendPath(workspace, target, &buffer, &size, &capacity);
+        }
+    }
+    if (context->rowPaths != NULL) {
+        context->rowPaths[row] = buffer;
+    }
+}
+
+static ShortestPathBatch* Batch_run(BatchContext* context, int rowsCount, int columnsCount, bool withPaths) {
+    ShortestPathBatch* batch = (ShortestPathBatch*)calloc(1, sizeof(ShortestPathBatch));
+    AssertNew(batch);
+    batch->rowsCount = rowsCount;
+    batch->columnsCount = columnsCount;
+
+    size_t cells = (size_t)rowsCount * columnsCount;
+    batch->distances = (float*)malloc((cells > 0 ? cells : 1) * sizeof(float));
+    AssertNew(batch->distances);
+    context->batch = batch;
+
+    if (withPaths) {
+        context->rowPaths = (int**)calloc(rowsCount > 0 ? rowsCount : 1, sizeof(int*));
+        AssertNew(context->rowPaths);
+        context->pathLengths = (int*)malloc((cells > 0 ? cells : 1) * sizeof(int));
+        AssertNew(context->pathLengths);
+    }
+
+    int workers = Platform_workerCount(rowsCount);
+    context->workspaces = (DijkstraWorkspace**)calloc(workers, sizeof(DijkstraWorkspace*));
+    AssertNew(context->workspaces);
+    context->settled = (long long*)calloc(workers, sizeof(long long));
+    AssertNew(context->settled);
+
+    Platform_parallelFor(rowsCount, Batch_rowTask, context);
+
+    long long settled = 0;
+    for (int i = 0; i < workers; i++) {
+        DijkstraWorkspace_destroy(context->workspaces[i]);
+        settled += context->settled[i];
+    }
+    free(context->workspaces);
+    free(context->settled);
+
+    // The paths of every row are gathered in one array, in cell order
+    if (withPaths) {
+        batch->pathOffsets = (int*)malloc((cells + 1) * sizeof(int));
+        AssertNew(batch->pathOffsets);
+        batch->pathOffsets[0] = 0;
+        for (size_t cell = 0; cell < cells; cell++) {
+            batch->pathOffsets[cell + 1] = batch->pathOffsets[cell] + context->pathLengths[cell];
+        }
+
+        batch->pathNodes = (int*)malloc((batch->pathOffsets[cells] > 0 ? batch->pathOffsets[cells] : 1) * sizeof(int));
+        AssertNew(batch->pathNodes);
+        for (int row = 0; row < rowsCount; row++) {
+            size_t first = (size_t)row * columnsCount;
+            int rowSize = batch->pathOffsets[first + columnsCount] - batch->pathOffsets[first];
+            if (rowSize > 0) {
+                memcpy(batch->pathNodes + batch->pathOffsets[first], context->rowPaths[row], rowSize * sizeof(int));
+            }
+            free(context->rowPaths[row]);
+        }
+        free(context->rowPaths);
+        free(context->pathLengths);
+    }
+
+    free(context->sources);
+    free(context->targets);
+
+    if (context->options.stats != NULL) {
+        context->options.stats->settledCount = settled > INT32_MAX ? INT32_MAX : (int)settled;
+    }
+    return batch;
+}
+
+static void Batch_initContext(BatchContext* context, Graph* graph, const ShortestPathOptions* options, bool matrix) {
+    memset(context, 0, sizeof(BatchContext));
+    context->graph = graph;
+    context->options = options != NULL ? *options : ShortestPathOptions_default();
+    context->options.workspace = NULL;
+    context->matrix = matrix;
+    if (matrix || context->options.method != SHORTEST_PATH_ASTAR) {
+        context->options.method = SHORTEST_PATH_DIJKSTRA;
+    }
+
+    // Computed once for the whole batch instead of once per query
+    if (context->options.method == SHORTEST_PATH_ASTAR && context->options.landmarks == NULL
+        && context->options.heuristicScale < 0.0f) {
+        context->options.heuristicScale = Graph_astarAdmissibleScale(graph);
+    }
+
+    // The workers must only read the graph : the fingerprint that Graph_astar
+    // checks against the landmarks (assert builds) is cached before they start
+    if (context->options.method == SHORTEST_PATH_ASTAR && context->options.landmarks != NULL) {
+        Graph_fingerprint(graph);
+    }
+}
+
+ShortestPathBatch* Graph_shortestPathPairs(Graph* graph, const char* startIds[], const char* endIds[], int count, bool withPaths, const ShortestPathOptions* options) {
+    assert(graph && count >= 0);
+
+    BatchContext context;
+    Batch_initContext(&context, graph, options, false);
+    context.sources = Batch_nodeIndices(graph, startIds, count);
+    context.targets = Batch_nodeIndices(graph, endIds, count);
+
+    return Batch_run(&context, count, 1, withPaths);
+}
+
+ShortestPathBatch* Graph_distanceMatrix(Graph* graph, const char* sourceIds[], int sourcesCount, const char* targetIds[], int targetsCount, bool withPaths, const ShortestPathOptions* options) {
+    assert(graph && sourcesCount >= 0 && targetsCount >= 0);
+
+    BatchContext context;
+    Batch_initContext(&context, graph, options, true);
+    context.sources = Batch_nodeIndices(graph, sourceIds, sourcesCount);
+    context.targets = Batch_nodeIndices(graph, targetIds, targetsCount);
+
+    return Batch_run(&context, sourcesCount, targetsCount, withPaths);
+}
+
+void ShortestPathBatch_destroy(ShortestPathBatch* batch) {
+    if (batch == NULL) return;
+
+    free(batch->distances);
+    free(batch->pathOffsets);
+    free(batch->pathNodes);
+    free(batch);
+}
@@ -0,0 +1,117 @@
+#include "ShortestPathCache.h"
+
+static int ShortestPathCache_bucket(const ShortestPathCache* cache, int start, int end, uint64_t version) {
+    uint64_t key = ((uint64_t)(uint32_t)start << 32) | (uint32_t)end;
+    key ^= version * 0x9E3779B97F4A7C15ULL;
+    key ^= key >> 29;
+    key *= 0xBF58476D1CE4E5B9ULL;
+    key ^= key >> 32;
+    return (int)(key & (uint64_t)cache->bucketsMask);
+}
+
+ShortestPathCache* ShortestPathCache_create(int capacity) {
+    assert(capacity > 0);
+
+    ShortestPathCache* cache = (ShortestPathCache*)calloc(1, sizeof(ShortestPathCache));
+    AssertNew(cache);
+    cache->capacity = capacity;
+    cache->entries = (ShortestPathCacheEntry*)calloc(capacity, sizeof(ShortestPathCacheEntry));
+    AssertNew(cache->entries);
+
+    // Power of two, at least twice the capacity so that chains stay short
+    int bucketsCount = 2;
+    while (bucketsCount < 2 * capacity) {
+        bucketsCount *= 2;
+    }
+    cache->bucketsMask = bucketsCount - 1;
+    cache->buckets = (int*)malloc(bucketsCount * sizeof(int));
+    AssertNew(cache->buckets);
+
+    ShortestPathCache_clear(cache);
+    return cache;
+}
+
+void ShortestPathCache_destroy(ShortestPathCache* cache) {
+    if (cache == NULL) return;
+
+    ShortestPathCache_clear(cache);
+    free(cache->entries);
+    free(cache->buckets);
+    free(cache);
+}
+
+void ShortestPathCache_clear(ShortestPathCache* cache) {
+    for (int i = 0; i < cache->capacity; i++) {
+        Path_destroy(cache->entries[i].path);
+        cache->entries[i].path = NULL;
+        cache->entries[i].used = false;
+        cache->entries[i].referenced = false;
+        cache->entries[i].next = -1;
+    }
+    for (int i = 0; i <= cache->bucketsMask; i++) {
+        cache->buckets[i] = -1;
+    }
+    cache->hand = 0;
+}
+
+/// @brief Choisit l'entrée à remplacer et la retire de sa case.
+static int ShortestPathCache_evict(ShortestPathCache* cache) {
+    // Ends after at most one full turn, every referenced bit being cleared on the way
+    while (cache->entries[cache->hand].used && cache->entries[cache->hand].referenced) {
+        cache->entries[cache->hand].referenced = false;
+        cache->hand = (cache->hand + 1) % cache->capacity;
+    }
+    int victim = cache->hand;
+    cache->hand = (cache->hand + 1) % cache->capacity;
+
+    ShortestPathCacheEntry* entry = &cache->entries[victim];
+    if (entry->used) {
+        int* link = &cache->buckets[ShortestPathCache_bucket(cache, entry->start, entry->end, entry->version)];
+        while (*link != victim) {
+            link = &cache->entries[*link].next;
+        }
+        *link = entry->next;
+
+        Path_destroy(entry->path);
+        entry->path = NULL;
+        entry->used = false;
+    }
+    return victim;
+}
+
+Path* ShortestPathCache_shortestPath(ShortestPathCache* cache, Graph* graph, const char* startId, const char* endId, const ShortestPathOptions* options) {
+    assert(cache && graph);
+
+    int start = Graph_getNodeIndex(graph, startId);
+    int end = Graph_getNodeIndex(graph, endId);
+    uint64_t version = Graph_version(graph);
+    int bucket = ShortestPathCache_bucket(cache, start, end, version);
+
+    for (int i = cache->buckets[bucket]; i >= 0; i = cache->entries[i].next) {
+        ShortestPathCacheEntry* entry = &cache->entries[i];
+        if (entry->start == start && entry->end == end && entry->version == version) {
+            entry->referenced = true;
+            cache->hitsCount++;
+            if (options != NULL && options->stats != NULL) {
+                options->stats->settledCount = 0;
+            }
+            return Path_copy(entry->path);
+        }
+    }
+
+    cache->missesCount++;
+    Path* path = Graph_shortestPath(graph, startId, endId, options);
+
+    int victim = ShortestPathCache_evict(cache);
+    ShortestPathCacheEntry* entry = &cache->entries[victim];
+    entry->start = start;
+    entry->end = end;
+    entry->version = version;
+    entry->path = Path_copy(path);
+    entry->used = true;
+    entry->referenced = false;
+    entry->next = cache->buckets[bucket];
+    cache->buckets[bucket] = victim;
+
+    return path;
+}
@@ -0,0 +1,267 @@
+#include "SpanningForest.h"
+#include "UnionFind.h"
+#include "Platform.h"
+
+/// @brief Arc du graphe avec ses deux extrémités, trié par Kruskal.
+typedef struct KruskalEdge {
+    int weight;
+    int arc;
+    int from;
+    int to;
+} KruskalEdge;
+
+static int KruskalEdge_compare(const void* a, const void* b) {
+    const KruskalEdge* first = (const KruskalEdge*)a;
+    const KruskalEdge* second = (const KruskalEdge*)b;
+    if (first->weight != second->weight) {
+        return first->weight < second->weight ? -1 : 1;
+    }
+    return first->arc < second->arc ? -1 : (first->arc > second->arc);
+}
+
+/// @brief Tri parallèle : les parties [bounds[i], bounds[i + 1][ sont triées
+/// indépendamment, puis fusionnées deux à deux jusqu'à n'en former qu'une.
+typedef struct EdgeSort {
+    KruskalEdge* edges;
+    KruskalEdge* buffer;
+    int* bounds;
+    int partsCount;
+
+    /// @brief Nombre de parties déjà fusionnées ensemble à l'étape courante.
+    int width;
+} EdgeSort;
+
+static void EdgeSort_sortTask(void* context, int part, int worker) {
+    (void)worker;
+    EdgeSort* sort = (EdgeSort*)context;
+    int first = sort->bounds[part];
+    qsort(sort->edges + first, sort->bounds[part + 1] - first, sizeof(KruskalEdge), KruskalEdge_compare);
+}
+
+static void EdgeSort_mergeTask(void* context, int pair, int worker) {
+    (void)worker;
+    EdgeSort* sort = (EdgeSort*)context;
+
+    int left = sort->bounds[minInt(2 * pair * sort->width, sort->partsCount)];
+    int middle = sort->bounds[minInt((2 * pair + 1) * sort->width, sort->partsCount)];
+    int right = sort->bounds[minInt((2 * pair + 2) * sort->width, sort->partsCount)];
+
+    int i = left;
+    int j = middle;
+    for (int k = left; k < right; k++) {
+        if (j >= right || (i < middle && KruskalEdge_compare(&sort->edges[i], &sort->edges[j]) <= 0)) {
+            sort->buffer[k] = sort->edges[i++];
+        } else {
+            sort->buffer[k] = sort->edges[j++];
+        }
+    }
+}
+
+static void Kruskal_sort(KruskalEdge* edges, int count) {
+    int workers = Platform_workerCount(INT32_MAX);
+    if (count < SPANNING_PARALLEL_THRESHOLD || workers == 1) {
+        qsort(edges, count, sizeof(KruskalEdge), KruskalEdge_compare);
+        return;
+    }
+
+    EdgeSort sort = { 0 };
+    sort.edges = edges;
+    sort.partsCount = workers;
+    sort.buffer = (KruskalEdge*)malloc(count * sizeof(KruskalEdge));
+    AssertNew(sort.buffer);
+    sort.bounds = (int*)malloc((workers + 1) * sizeof(int));
+    AssertNew(sort.bounds);
+    for (int i = 0; i <= workers; i++) {
+        sort.bounds[i] = (int)((int64_t)count * i / workers);
+    }
+
+    Platform_parallelFor(sort.partsCount, EdgeSort_sortTask, &sort);
+
+    for (sort.width = 1; sort.width < sort.partsCount; sort.width *= 2) {
+        int pairs = (sort.partsCount + 2 * sort.width - 1) / (2 * sort.width);
+        Platform_parallelFor(pairs, EdgeSort_mergeTask, &sort);
+
+        KruskalEdge* swap = sort.edges;
+        sort.edges = sort.buffer;
+        sort.buffer = swap;
+    }
+
+    // After an odd number of merge steps the result is in the buffer
+    if (sort.edges != edges) {
+        memcpy(edges, sort.edges, count * sizeof(KruskalEdge));
+        sort.buffer = sort.edges;
+    }
+    free(sort.buffer);
+    free(sort.bounds);
+}
+
+static SpanningForest* SpanningForest_create(int nodesCount) {
+    SpanningForest* forest = (SpanningForest*)calloc(1, sizeof(SpanningForest));
+    AssertNew(forest);
+    forest->edges = (SpanningEdge*)malloc(maxInt(nodesCount, 1) * sizeof(SpanningEdge));
+    AssertNew(forest->edges);
+    return forest;
+}
+
+static void SpanningForest_add(SpanningForest* forest, int from, int to, int weight) {
+    SpanningEdge* edge = &forest->edges[forest->edgesCount++];
+    edge->from = from;
+    edge->to = to;
+    edge->weight = weight;
+    forest->totalWeight += weight;
+}
+
+SpanningForest* Graph_kruskal(Graph* graph) {
+    assert(graph);
+
+    int size = Graph_size(graph);
+    int arcsCount = Graph_arcCount(graph);
+
+    KruskalEdge* edges = (KruskalEdge*)malloc(maxInt(arcsCount, 1) * sizeof(KruskalEdge));
+    AssertNew(edges);
+    for (int u = 0; u < size; u++) {
+        int arcEnd = Graph_arcEnd(graph, u);
+        for (int arc = Graph_arcBegin(graph, u); arc < arcEnd; arc++) {
+            edges[arc].weight = Graph_arcWeight(graph, arc);
+            edges[arc].arc = arc;
+            edges[arc].from = u;
+            edges[arc].to = Graph_arcTarget(graph, arc);
+        }
+    }
+    Kruskal_sort(edges, arcsCount);
+
+    int* parents = (int*)malloc(maxInt(size, 1) * sizeof(int));
+    AssertNew(parents);
+    UnionFind_init(parents, size);
+
+    SpanningForest* forest = SpanningForest_create(size);
+    for (int i = 0; i < arcsCount && forest->edgesCount < size - 1; i++) {
+        if (UnionFind_union(parents, edges[i].from, edges[i].to)) {
+            SpanningForest_add(forest, edges[i].from, edges[i].to, edges[i].weight);
+        }
+    }
+    forest->treesCount = size - forest->edgesCount;
+
+    free(edges);
+    free(parents);
+    return forest;
+}
+
+/// @brief Données partagées par les threads d'une passe de Borůvka.
+typedef struct Boruvka {
+    Graph* graph;
+    int* sources;
+
+    /// @brief Arbre de chaque sommet au début de la passe.
+    int* trees;
+
+    /// @brief Meilleur arc sortant de chaque arbre (indexé par son représentant) :
+    /// poids dans les 32 bits de poids fort, indice de l'arc dans les autres.
+    volatile uint64_t* best;
+
+    int chunkSize;
+} Boruvka;
+
+static uint64_t Boruvka_key(int weight, int arc) {
+    // Flipping the sign bit orders signed weights as unsigned integers
+    return ((uint64_t)((uint32_t)weight ^ 0x80000000u) << 32) | (uint32_t)arc;
+}
+
+static void Boruvka_offer(volatile uint64_t* best, uint64_t key) {
+    uint64_t current = Atomic_load64(best);
+    while (key < current) {
+        if (Atomic_compareExchange64(best, &current, key)) break;
+    }
+}
+
+static void Boruvka_cheapestTask(void* context, int chunk, int worker) {
+    (void)worker;
+    Boruvka* boruvka = (Boruvka*)context;
+    Graph* graph = boruvka->graph;
+
+    int first = chunk * boruvka->chunkSize;
+    int last = minInt(first + boruvka->chunkSize, Graph_arcCount(graph));
+    for (int arc = first; arc < last; arc++) {
+        int fromTree = boruvka->trees[boruvka->sources[arc]];
+        int toTree = boruvka->trees[Graph_arcTarget(graph, arc)];
+        if (fromTree == toTree) continue;
+
+        uint64_t key = Boruvka_key(Graph_arcWeight(graph, arc), arc);
+        Boruvka_offer(&boruvka->best[fromTree], key);
+        Boruvka_offer(&boruvka->best[toTree], key);
+    }
+}
+
+SpanningForest* Graph_boruvka(Graph* graph) {
+    assert(graph);
+
+    int size = Graph_size(graph);
+    int arcsCount = Graph_arcCount(graph);
+
+    Boruvka boruvka = { 0 };
+    boruvka.graph = graph;
+    boruvka.sources = (int*)malloc(maxInt(arcsCount, 1) * sizeof(int));
+    AssertNew(boruvka.sources);
+    boruvka.trees = (int*)malloc(maxInt(size, 1) * sizeof(int));
+    AssertNew(boruvka.trees);
+    boruvka.best = (volatile uint64_t*)malloc(maxInt(size, 1) * sizeof(uint64_t));
+    AssertNew(boruvka.best);
+
+    for (int u = 0; u < size; u++) {
+        int arcEnd = Graph_arcEnd(graph, u);
+        for (int arc = Graph_arcBegin(graph, u); arc < arcEnd; arc++) {
+            boruvka.sources[arc] = u;
+        }
+        boruvka.trees[u] = u;
+        boruvka.best[u] = UINT64_MAX;
+    }
+
+    int* parents = (int*)malloc(maxInt(size, 1) * sizeof(int));
+    AssertNew(parents);
+    UnionFind_init(parents, size);
+
+    int workers = Platform_workerCount(INT32_MAX);
+    int chunks = arcsCount < SPANNING_PARALLEL_THRESHOLD ? 1 : minInt(arcsCount, 8 * workers);
+    boruvka.chunkSize = maxInt((arcsCount + chunks - 1) / chunks, 1);
+    chunks = (arcsCount + boruvka.chunkSize - 1) / boruvka.chunkSize;
+
+    SpanningForest* forest = SpanningForest_create(size);
+    while (true) {
+        Platform_parallelFor(chunks, Boruvka_cheapestTask, &boruvka);
+
+        int added = 0;
+        for (int u = 0; u < size; u++) {
+            if (boruvka.trees[u] != u || boruvka.best[u] == UINT64_MAX) continue;
+
+            int arc = (int)(uint32_t)boruvka.best[u];
+            boruvka.best[u] = UINT64_MAX;
+
+            // Two trees may choose the same arc
+            int from = boruvka.sources[arc];
+            int to = Graph_arcTarget(graph, arc);
+            if (UnionFind_union(parents, from, to)) {
+                SpanningForest_add(forest, from, to, Graph_arcWeight(graph, arc));
+                added++;
+            }
+        }
+        if (added == 0) break;
+
+        for (int u = 0; u < size; u++) {
+            boruvka.trees[u] = UnionFind_find(parents, u);
+        }
+    }
+    forest->treesCount = size - forest->edgesCount;
+
+    free(boruvka.sources);
+    free(boruvka.trees);
+    free((void*)boruvka.best);
+    free(parents);
+    return forest;
+}
+
+void SpanningForest_destroy(SpanningForest* forest) {
+    if (forest == NULL) return;
+
+    free(forest->edges);
+    free(forest);
+}
@@ -8,29 +8,28 @@
 
 #define MAX_INPUT_CHARS     3
 
+//Time during which the result of a save stays on screen, in seconds
+#define SAVE_MESSAGE_DURATION 2.0
+
 
 //Function to display the graph in the console
 void displayGraphCLI(Graph* graph)
 {
-	NodesList* graphNodes = graph->nodes;
-	while (graphNodes->next != NULL)
+	for (int node = 0; node < Graph_size(graph); node++)
 	{
-		Node* node = graphNodes->node;
-		printf("Node id: %s ", node->id);
-		printf("(data: %d)\n", node->data);
-		NodesList* adjencyList = node->adjacent;
-		while (adjencyList != NULL)
+		printf("Node id: %s ", Graph_getNodeId(graph, node));
+		printf("(index: %d)\n", node);
+		int arcEnd = Graph_arcEnd(graph, node);
+		for (int arc = Graph_arcBegin(graph, node); arc < arcEnd; arc++)
 		{
-			printf("\t-Adjacent node id: %s\n", adjencyList->node->id);
-			adjencyList = adjencyList->next;
+			printf("\t-Adjacent node id: %s\n", Graph_getNodeId(graph, Graph_arcTarget(graph, arc)));
 		}
-		graphNodes = graphNodes->next;
 	}
 }
 
 
 //Function to display the graph in a window
-void displayGraphWindow(Graph* graph)
+void displayGraphWindow(Graph* graph, DynamicShortestPath* tree, EditJournal* journal)
 {
 	// Initialization
 	const int screenWidth = 1200;
@@ -40,7 +39,7 @@ void displayGraphWindow(Graph* graph)
 	Vector2 startPoint = { 100, 100 };
 
 	//Variable needed for moving nodes and creating edges
-	Node* movingNode = NULL;
+	int movingNode = -1;
 	int moveStartPoint = -1;
 	bool moveEndPoint = false;
 	int pressed = 0;
@@ -65,7 +64,21 @@ void displayGraphWindow(Graph* graph)
 
 	InitWindow(screenWidth, screenHeight, "Draw graphs");
 	SetTargetFPS(60);               // Set our game to run at 60 frames-per-second
-	NodesList* editedEges;
+	int editedArc = -1;
+
+	//Highlighted path, rebuilt when an edit changes the shortest path tree
+	Path* path = NULL;
+	int pathVersion = -1;
+
+	//Minimum spanning forest, shown with the M key and rebuilt after each edit
+	SpanningForest* forest = NULL;
+	bool showForest = false;
+	uint64_t forestVersion = 0;
+
+	//Save running on another thread, and result of the last one
+	AsyncSave* save = NULL;
+	bool saveSucceeded = false;
+	double saveMessageEnd = 0.0;
 
 	// Main game loop
 	while (!WindowShouldClose())    // Detect window close button or ESC key
@@ -77,24 +90,68 @@ void displayGraphWindow(Graph* graph)
 		//such user inputs, moving nodes, creating edges, etc.
 
 		prepareGraphToDraw(graph, startPoint, &pressed,
-			&displayEdgeWeightEditBox, &textBox, &letterCount, editedText, &editedEges,
+			&displayEdgeWeightEditBox, &textBox, &letterCount, editedText, &editedArc,
 			&framesCounter, &creatingNode, &movingNode,
 			&mouse, &createEdge);
 
-		// Draw the graph
-		drawGraph(displayEdgeWeightEditBox, &textBox,
-			editedText, letterCount, framesCounter, &currentPoint, &startPoint,
-			graph, moveStartPoint, movingNode, pressed,
-			&mouse, &createEdge);
+		if (tree != NULL && tree->version != pathVersion)
+		{
+			Path_destroy(path);
+			path = DynamicShortestPath_getPath(tree);
+			pathVersion = tree->version;
+		}
 
+		if (IsKeyPressed(KEY_M))
+			showForest = !showForest;
+		if (showForest && (forest == NULL || forestVersion != Graph_version(graph)))
+		{
+			SpanningForest_destroy(forest);
+			forest = Graph_kruskal(graph);
+			forestVersion = Graph_version(graph);
+		}
 
 		//Check if the user wants to save the graph
 		if (IsKeyPressed(KEY_S))
 		{
-			saveGraph(graph);
+			if (journal != NULL)
+			{
+				//Only the edits made since the last save are written
+				saveSucceeded = EditJournal_commit(journal);
+				saveMessageEnd = GetTime() + SAVE_MESSAGE_DURATION;
+			}
+			else if (save == NULL)
+			{
+				//The graph is written on another thread while the window keeps drawing
+				save = Graph_saveAsync(graph);
+			}
+		}
+		if (save != NULL && AsyncSave_isDone(save))
+		{
+			saveSucceeded = AsyncSave_finish(save);
+			save = NULL;
+			saveMessageEnd = GetTime() + SAVE_MESSAGE_DURATION;
 		}
+		if (journal != NULL)
+			EditJournal_update(journal);
+
+		const char* saveMessage = NULL;
+		if (save == NULL && GetTime() < saveMessageEnd)
+			saveMessage = saveSucceeded ? "Graph saved" : "Save failed";
+		else if (journal != NULL && EditJournal_isCompacting(journal))
+			saveMessage = "Compacting the journal...";
+
+		// Draw the graph
+		drawGraph(displayEdgeWeightEditBox, &textBox,
+			editedText, letterCount, framesCounter, &currentPoint, &startPoint,
+			graph, moveStartPoint, movingNode, pressed,
+			&mouse, &createEdge, path, showForest ? forest : NULL, save, saveMessage);
 	}
 
+	//A running save is completed before leaving
+	AsyncSave_finish(save);
+	Path_destroy(path);
+	SpanningForest_destroy(forest);
+
 	// De-Initialization
 	//--------------------------------------------------------------------------------------
 	CloseWindow();        // Close window and OpenGL context
@@ -106,46 +163,46 @@ void displayGraphWindow(Graph* graph)
 
 void prepareGraphToDraw(Graph* graph, Vector2 startPoint,
 	int* pressed, int* show, Rectangle* textBox,
-	int* letterCount, char* editedText, NodesList** editedEges, int* framesCounter, int* creatingNode,
-	Node** nodeToEdit, Vector2* mouse, int* createEdge)
+	int* letterCount, char* editedText, int* editedArc, int* framesCounter, int* creatingNode,
+	int* nodeToEdit, Vector2* mouse, int* createEdge)
 {
 	bool overEdge = false;
 	bool overNode = false;
-	NodesList* currentNodeList = graph->nodes;
-	NodesList* prevNodeList = NULL;
-	while (currentNodeList->next != NULL)
+	int node = 0;
+	while (node < Graph_size(graph))
 	{
-		Node* node = currentNodeList->node;
-
-		if (deleteNodeManagement(mouse, node, prevNodeList, currentNodeList, graph) || deleteEdgeManagement(graph, node, mouse, editedEges))
+		if (deleteNodeManagement(mouse, graph, node) || deleteEdgeManagement(graph, node, mouse, editedArc))
+		{
+			//Indices may have been shifted by the deletion
+			*nodeToEdit = -1;
+			*editedArc = -1;
 			break;
-
-		prevNodeList = currentNodeList;
+		}
 
 		createNodeManagement(creatingNode, graph, mouse);
 		manageNodeRenameEditBox(graph, node, show, textBox, mouse, letterCount, editedText, framesCounter, &overNode, nodeToEdit);
 
-		if (*nodeToEdit == NULL || *createEdge) {
-			manageEdgeWeightEditBox(graph, node, show, textBox, mouse, letterCount, editedText, framesCounter, &overEdge, editedEges);
+		if (*nodeToEdit < 0 || *createEdge) {
+			manageEdgeWeightEditBox(graph, node, show, textBox, mouse, letterCount, editedText, framesCounter, &overEdge, editedArc);
 
 
 
 			//If the mouse is over a node, the user can move it by left clicking on it
-			if (CheckCollisionPointCircle(*mouse, (Vector2) { node->x, node->y }, 50.0f)
+			if (CheckCollisionPointCircle(*mouse, Graph_getNodePosition(graph, node), 50.0f)
 				&& IsMouseButtonDown(MOUSE_BUTTON_LEFT))
 				*nodeToEdit = node;
 
-			if (*nodeToEdit != NULL)
+			if (*nodeToEdit >= 0)
 			{
 				edgeCreationManagement(nodeToEdit, mouse, createEdge, graph);
 
 				//Once the user has moved the node, he can release it by releasing the left mouse button
 				if (IsMouseButtonReleased(MOUSE_BUTTON_LEFT))
-					(*nodeToEdit) = NULL;
+					(*nodeToEdit) = -1;
 			}
 			//If no node is being moved check the next one, but if a node is being moved, stop checking
-			if ((*nodeToEdit) == NULL)
-				currentNodeList = currentNodeList->next;
+			if ((*nodeToEdit) < 0)
+				node++;
 			else
 				break;
 		}
@@ -156,47 +213,15 @@ void prepareGraphToDraw(Graph* graph, Vector2 startPoint,
 }
 
 
-bool deleteNodeManagement(Vector2* mouse, Node* node, NodesList* prevNodeList, NodesList* currentNodeList, Graph* graph)
+bool deleteNodeManagement(Vector2* mouse, Graph* graph, int node)
 {
 	if (IsMouseButtonDown(MOUSE_BUTTON_LEFT) && IsKeyDown(KEY_LEFT_ALT))
 	{
-		bool overNode = CheckCollisionPointCircle(*mouse, (Vector2) { node->x, node->y }, 50.0f);
+		bool overNode = CheckCollisionPointCircle(*mouse, Graph_getNodePosition(graph, node), 50.0f);
 		if (overNode)
 		{
-			if (prevNodeList)
-				prevNodeList->next = currentNodeList->next;
-			else
-				graph->nodes = currentNodeList->next;
-
-			NodesList* parseNodes = graph->nodes;
-			while (parseNodes->next != NULL)
-			{
-				Node* curNode = parseNodes->node;
-				if (curNode->adjacent != NULL)
-				{
-					NodesList* tmp = curNode->adjacent;
-					NodesList* prevTmp = NULL;
-
-					while (tmp != NULL)
-					{
-						if (tmp->node == node)
-						{
-							if (prevTmp != NULL)
-								prevTmp->next = tmp->next;
-							else
-								curNode->adjacent = tmp->next;
-							break;
-						}
-						prevTmp = tmp;
-						tmp = tmp->next;
-					}
-				}
-				parseNodes = parseNodes->next;
-			}
-			graph->nodesCount--;
-
-			free(node->adjacent);
-			free(node);
+			//Removes the node and every edge pointing to it
+			Graph_removeNode(graph, node);
 			return true;
 		}
 	}
@@ -205,31 +230,16 @@ bool deleteNodeManagement(Vector2* mouse, Node* node, NodesList* prevNodeList, N
 
 
 
-bool deleteEdgeManagement(Graph* graph, Node* node, Vector2* mouse, NodesList** editedEges)
+bool deleteEdgeManagement(Graph* graph, int node, Vector2* mouse, int* editedArc)
 {
 	bool edgeRemoved = false;
 	if (IsMouseButtonDown(MOUSE_BUTTON_LEFT) && IsKeyDown(KEY_LEFT_ALT))
 	{
-		bool overEdge = checkOverEdge(graph->oriented, node, mouse, editedEges);
+		bool overEdge = checkOverEdge(graph, node, mouse, editedArc);
 		if (overEdge)
 		{
-			NodesList* prevAdjacent = NULL;
-			NodesList* curAdjacent = node->adjacent;
-			while (curAdjacent != NULL)
-			{
-				if (curAdjacent->node == (*editedEges)->node)
-				{
-					if (prevAdjacent != NULL)
-						prevAdjacent->next = curAdjacent->next;
-					else
-						node->adjacent = curAdjacent->next;
-
-					edgeRemoved = true;
-					break;
-				}
-				prevAdjacent = curAdjacent;
-				curAdjacent = curAdjacent->next;
-			}
+			Graph_removeArc(graph, *editedArc);
+			edgeRemoved = true;
 		}
 	}
 
@@ -241,27 +251,14 @@ void createNodeManagement(int* creatingNode, Graph* graph, Vector2* mouse)
 {
 	if (IsKeyDown(KEY_LEFT_CONTROL) && IsMouseButtonDown(MOUSE_BUTTON_LEFT) && *creatingNode == 0)
 	{
-		NodesList* curNodeList = graph->nodes;
-		graph->nodesCount++;
-		Node* nodeCurrent = (Node*)malloc(sizeof(Node));
-		while (curNodeList->next->node != NULL)
+		//The id must not be used by another node
+		char buffer[12];
+		int newId = Graph_size(graph) + 1;
+		do
 		{
-			curNodeList = curNodeList->next;
-		}
-		char buffer[10];
-		_itoa(graph->nodesCount, buffer, 10);
-		nodeCurrent->id = (char*)malloc(strlen(buffer));
-		strcpy(nodeCurrent->id, buffer);
-		nodeCurrent->data = (int)(mouse->x + mouse->y);
-		nodeCurrent->x = mouse->x;
-		nodeCurrent->y = mouse->y;
-		nodeCurrent->adjacent = NULL;
-		curNodeList->next->node = nodeCurrent;
-
-
-		curNodeList->next->next = (NodesList*)malloc(sizeof(NodesList));
-		curNodeList->next->next->node = NULL;
-		curNodeList->next->next->next = NULL;
+			snprintf(buffer, sizeof(buffer), "%d", newId++);
+		} while (Graph_getNodeIndex(graph, buffer) >= 0);
+		Graph_addNode(graph, buffer, *mouse);
 
 		*creatingNode = 1;
 	}
@@ -271,17 +268,17 @@ void createNodeManagement(int* creatingNode, Graph* graph, Vector2* mouse)
 }
 
 
-void manageNodeRenameEditBox(Graph* graph, Node* node, int* show, Rectangle* textBox,
-	Vector2* mouse, int* letterCount, char* editedText, int* framesCounter, bool* overNode, Node** nodeToEdit)
+void manageNodeRenameEditBox(Graph* graph, int node, int* show, Rectangle* textBox,
+	Vector2* mouse, int* letterCount, char* editedText, int* framesCounter, bool* overNode, int* nodeToEdit)
 {
 	int currentGesture = GetGestureDetected();
 
 	if (!*show)
-		*overNode = CheckCollisionPointCircle(*mouse, (Vector2) { node->x, node->y }, 50.0f);
+		*overNode = CheckCollisionPointCircle(*mouse, Graph_getNodePosition(graph, node), 50.0f);
 
-	if ((currentGesture == GESTURE_DOUBLETAP && *overNode) || (*show && *nodeToEdit != NULL))
+	if ((currentGesture == GESTURE_DOUBLETAP && *overNode) || (*show && *nodeToEdit >= 0))
 	{
-		if (*nodeToEdit == NULL)
+		if (*nodeToEdit < 0)
 			*nodeToEdit = node;
 
 		bool edited = false;
@@ -289,37 +286,41 @@ void manageNodeRenameEditBox(Graph* graph, Node* node, int* show, Rectangle* tex
 
 		if (edited)
 		{
-			strcpy((*nodeToEdit)->id, editedText);
+			if (editedText[0] != '\0' && !Graph_renameNode(graph, *nodeToEdit, editedText))
+				fprintf(stderr, "Node id \"%s\" is already used\n", editedText);
 			strcpy(editedText, "");
 			*letterCount = 0;
 		}
 	}
 	else {
 		if (!IsKeyDown(KEY_LEFT_SHIFT))
-			*nodeToEdit = NULL;
+			*nodeToEdit = -1;
 	}
 }
 
 
 //If the graph is oriented, the function will check if the mouse is over the triangle indicated the orientation
 //If the graph is not oriented, the function will check if the mouse is over anypart of the edge
-bool checkOverEdge(bool oriented, Node* node, Vector2* mouse, NodesList** editedEges)
+bool checkOverEdge(Graph* graph, int node, Vector2* mouse, int* editedArc)
 {
 	bool overEdge = false;
-	NodesList* adjencyList = node->adjacent;
-	Vector3 start = { node->x, node->y,0 };
-	while (adjencyList != NULL && adjencyList->node != NULL)
+	Vector2 nodePosition = Graph_getNodePosition(graph, node);
+	Vector3 start = { nodePosition.x, nodePosition.y,0 };
+	int arc = Graph_arcBegin(graph, node);
+	int arcEnd = Graph_arcEnd(graph, node);
+	for (; arc < arcEnd; arc++)
 	{
-		if (!oriented)
+		Vector2 adjacentPosition = Graph_getNodePosition(graph, Graph_arcTarget(graph, arc));
+		if (!graph->oriented)
 		{
-			if (CheckCollisionPointLine(*mouse, (Vector2) { node->x, node->y }, (Vector2) { adjencyList->node->x, adjencyList->node->y }, 5))
+			if (CheckCollisionPointLine(*mouse, nodePosition, adjacentPosition, 5))
 			{
 				overEdge = true;
 				break;
 			}
 		}
 		else {
-			Vector3 end = { adjencyList->node->x, adjencyList->node->y,0 };
+			Vector3 end = { adjacentPosition.x, adjacentPosition.y,0 };
 			Vector3 normal = Vector3Perpendicular(Vector3Subtract(end, start));
 			Vector2 normalNormalized = Vector2Normalize((Vector2) { normal.x, normal.y });
 
@@ -327,12 +328,12 @@ bool checkOverEdge(bool oriented, Node* node, Vector2* mouse, NodesList** edited
 			normalNormalized.x *= multiplier;
 			normalNormalized.y *= multiplier;
 
-			Vector2 middle = { (node->x + adjencyList->node->x) / 2 + normalNormalized.x ,
-				(node->y + adjencyList->node->y) / 2 + normalNormalized.y };
+			Vector2 middle = { (nodePosition.x + adjacentPosition.x) / 2 + normalNormalized.x ,
+				(nodePosition.y + adjacentPosition.y) / 2 + normalNormalized.y };
 
 			Vector2 colinear = Vector2Normalize((Vector2) {
-				(adjencyList->node->x - node->x) / 2,
-					(adjencyList->node->y - node->y) / 2
+				(adjacentPosition.x - nodePosition.x) / 2,
+					(adjacentPosition.y - nodePosition.y) / 2
 			});
 			colinear.x *= multiplier;
 			colinear.y *= multiplier;
@@ -355,10 +356,9 @@ bool checkOverEdge(bool oriented, Node* node, Vector2* mouse, NodesList** edited
 				break;
 			}
 		}
-		adjencyList = adjencyList->next;
 	}
 	if (overEdge)
-		*editedEges = adjencyList;
+		*editedArc = arc;
 
 	return overEdge;
 }
@@ -411,23 +411,23 @@ void getUserInput(int* show, bool* edited, Rectangle* textBox, Vector2* mouse, i
 	(*framesCounter) %= 100;
 }
 
-void manageEdgeWeightEditBox(Graph* graph, Node* node, int* show, Rectangle* textBox,
+void manageEdgeWeightEditBox(Graph* graph, int node, int* show, Rectangle* textBox,
 	Vector2* mouse, int* letterCount, char* editedText,
-	int* framesCounter, bool* overEdge, NodesList** editedEges)
+	int* framesCounter, bool* overEdge, int* editedArc)
 {
 	int currentGesture = GetGestureDetected();
 
 	if (!*show)
-		*overEdge = checkOverEdge(graph->oriented, node, mouse, editedEges);
+		*overEdge = checkOverEdge(graph, node, mouse, editedArc);
 
 	if ((currentGesture == GESTURE_DOUBLETAP && *overEdge) || *show)
 	{
 		bool edited = false;
 		getUserInput(show, &edited, textBox, mouse, letterCount, editedText, framesCounter, false);
 
-		if (edited)
+		if (edited && *editedArc >= 0)
 		{
-			(*editedEges)->weight = atoi(editedText);
+			Graph_setArcWeight(graph, *editedArc, atoi(editedText));
 			strcpy(editedText, "");
 			*letterCount = 0;
 		}
@@ -435,43 +435,23 @@ void manageEdgeWeightEditBox(Graph* graph, Node* node, int* show, Rectangle* tex
 }
 
 
-void edgeCreationManagement(Node** nodeToMove, Vector2* mouse, int* createEdge, Graph* graph)
+void edgeCreationManagement(int* nodeToMove, Vector2* mouse, int* createEdge, Graph* graph)
 {
 	if (!IsKeyDown(KEY_LEFT_SHIFT))
 	{
-		(*nodeToMove)->x = mouse->x;
-		(*nodeToMove)->y = mouse->y;
+		Graph_moveNode(graph, *nodeToMove, *mouse);
 	}
 	if (IsMouseButtonReleased(MOUSE_BUTTON_LEFT))
 	{
 		if (*createEdge != 0)
 		{
-			NodesList* tmpNodeList = graph->nodes;
-			while (tmpNodeList->node != NULL)
+			for (int target = 0; target < Graph_size(graph); target++)
 			{
-				if (CheckCollisionPointCircle(*mouse, (Vector2) { tmpNodeList->node->x, tmpNodeList->node->y }, 50.0f))
+				if (CheckCollisionPointCircle(*mouse, Graph_getNodePosition(graph, target), 50.0f))
 				{
-					NodesList* tmp = (*nodeToMove)->adjacent;
-					while (tmp != NULL && tmp->next != NULL)
-					{
-						tmp = tmp->next;
-					}
-					if (tmp == NULL) {
-						(*nodeToMove)->adjacent = (NodesList*)malloc(sizeof(NodesList));
-						(*nodeToMove)->adjacent->node = tmpNodeList->node;
-						(*nodeToMove)->adjacent->weight = 1;
-						(*nodeToMove)->adjacent->next = NULL;
-					}
-					else
-					{
-						tmp->next = (NodesList*)malloc(sizeof(NodesList));
-						tmp->next->node = tmpNodeList->node;
-						tmp->next->weight = 1;
-						tmp->next->next = NULL;
-					}
+					Graph_addArc(graph, *nodeToMove, target, 1);
 					break;
 				}
-				tmpNodeList = tmpNodeList->next;
 			}
 		}
 		*createEdge = 0;
@@ -481,92 +461,138 @@ void edgeCreationManagement(Node** nodeToMove, Vector2* mouse, int* createEdge,
 void drawGraph(int showEdgeWeightEditBox, Rectangle* textBox,
 	char* edgeWeight, int letterCount, int framesCounter,
 	Vector2* currentPoint, Vector2* startPoint,
-	Graph* graph, int moveStartPoint, Node* movingNode, int pressed,
-	Vector2* mouse, int* createEdge)
+	Graph* graph, int moveStartPoint, int movingNode, int pressed,
+	Vector2* mouse, int* createEdge, Path* path, SpanningForest* forest,
+	AsyncSave* save, const char* saveMessage)
 {
 	BeginDrawing();
 
 	ClearBackground(RAYWHITE);
 
+	//The forest and the path are drawn first, under the edges and the nodes
+	drawSpanningForest(graph, forest);
+	drawPath(graph, path);
+
 	currentPoint = startPoint;
 	int line = 0;
 	int column = 0;
-	NodesList* graphNodes = graph->nodes;
-	while (graphNodes->next != NULL)
+	for (int node = 0; node < Graph_size(graph); node++)
 	{
-		Node* node = graphNodes->node;
-		if (node->x == -1 && node->y == -1)
+		Vector2 nodePosition = Graph_getNodePosition(graph, node);
+		if (nodePosition.x == -1 && nodePosition.y == -1)
 		{
-			node->x = currentPoint->x;
-			node->y = currentPoint->y;
+			nodePosition = *currentPoint;
+			Graph_setNodePosition(graph, node, nodePosition);
 		}
 		else
 		{
-			currentPoint->x = node->x;
-			currentPoint->y = node->y;
+			*currentPoint = nodePosition;
 		}
-		NodesList* adjencyList = node->adjacent;
-		while (adjencyList != NULL && adjencyList->node != NULL)
+		int arcEnd = Graph_arcEnd(graph, node);
+		for (int arc = Graph_arcBegin(graph, node); arc < arcEnd; arc++)
 		{
-			Vector2 middle = Vector2Add((Vector2) { node->x, node->y }, (Vector2) { adjencyList->node->x, adjencyList->node->y });
+			Vector2 adjacentPosition = Graph_getNodePosition(graph, Graph_arcTarget(graph, arc));
+			Vector2 middle = Vector2Add(nodePosition, adjacentPosition);
 			middle = Vector2Scale(middle, 0.5);
 			if (!graph->oriented)
-				DrawLine((int)node->x, (int)node->y, (int)adjencyList->node->x, (int)adjencyList->node->y, GREEN);
+				DrawLine((int)nodePosition.x, (int)nodePosition.y, (int)adjacentPosition.x, (int)adjacentPosition.y, GREEN);
 			else
-				drawOrientedCurve(node, adjencyList, &middle);
-
-			DrawText(TextFormat("%d", adjencyList->weight), (int)middle.x, (int)middle.y, 30, RED);
+				drawOrientedCurve(nodePosition, adjacentPosition, &middle);
 
-			adjencyList = adjencyList->next;
+			DrawText(TextFormat("%d", Graph_arcWeight(graph, arc)), (int)middle.x, (int)middle.y, 30, RED);
 		}
 
 
 		column = (column + 1) % 5;
 		if (column == 0)
 			line++;
-		node->x = currentPoint->x;
-		node->y = currentPoint->y;
+		Graph_setNodePosition(graph, node, *currentPoint);
 
 		currentPoint->x = startPoint->x + 200 * column;
 		currentPoint->y = startPoint->y + 300 * line;
-
-
-		graphNodes = graphNodes->next;
 	}
-	graphNodes = graph->nodes;
-	while (graphNodes->next != NULL)
+	for (int node = 0; node < Graph_size(graph); node++)
 	{
-		Node* node = graphNodes->node;
-
-		if (node->x == -1 && node->y == -1)
+		Vector2 nodePosition = Graph_getNodePosition(graph, node);
+		if (nodePosition.x == -1 && nodePosition.y == -1)
 		{
-			node->x = currentPoint->x;
-			node->y = currentPoint->y;
+			Graph_setNodePosition(graph, node, *currentPoint);
 		}
 		else
 		{
-			currentPoint->x = node->x;
-			currentPoint->y = node->y;
+			*currentPoint = nodePosition;
 		}
 		DrawCircleV(*currentPoint,
 			CheckCollisionPointCircle(*mouse, *currentPoint, 30.0f) && !IsKeyDown(KEY_LEFT_SHIFT) ? 50.f : 30.f,
 			(moveStartPoint != -1 && movingNode == node) ? RED : BLUE);
-		DrawText(TextFormat("%s", node->id), (int)currentPoint->x - 5, (int)currentPoint->y - 15, 30, WHITE);
-		graphNodes = graphNodes->next;
+		DrawText(TextFormat("%s", Graph_getNodeId(graph, node)), (int)currentPoint->x - 5, (int)currentPoint->y - 15, 30, WHITE);
 	}
 
-	if (IsKeyDown(KEY_LEFT_SHIFT) && movingNode != NULL)
+	if (IsKeyDown(KEY_LEFT_SHIFT) && movingNode >= 0)
 	{
 		*createEdge = 1;
-		DrawLineEx((Vector2) { movingNode->x, movingNode->y }, * mouse, 3, BLACK);
+		DrawLineEx(Graph_getNodePosition(graph, movingNode), * mouse, 3, BLACK);
 	}
 
 	if (showEdgeWeightEditBox)
 		drawEdgeWeightEditBox(showEdgeWeightEditBox, textBox, edgeWeight, letterCount, framesCounter);
 
+	drawSaveStatus(save, saveMessage);
+
 	EndDrawing();
 }
 
+void drawPath(Graph* graph, Path* path)
+{
+	if (path == NULL)
+		return;
+
+	for (int i = 0; i + 1 < path->length; i++)
+	{
+		int from = path->nodes[i];
+		int to = path->nodes[i + 1];
+		//Nodes may have been deleted since the path was computed
+		if (from >= Graph_size(graph) || to >= Graph_size(graph) || Graph_findArc(graph, from, to) < 0)
+			continue;
+
+		DrawLineEx(Graph_getNodePosition(graph, from), Graph_getNodePosition(graph, to), 12, ORANGE);
+	}
+}
+
+void drawSpanningForest(Graph* graph, SpanningForest* forest)
+{
+	if (forest == NULL)
+		return;
+
+	for (int i = 0; i < forest->edgesCount; i++)
+	{
+		int from = forest->edges[i].from;
+		int to = forest->edges[i].to;
+		if (from >= Graph_size(graph) || to >= Graph_size(graph))
+			continue;
+
+		DrawLineEx(Graph_getNodePosition(graph, from), Graph_getNodePosition(graph, to), 20, SKYBLUE);
+	}
+}
+
+void drawSaveStatus(AsyncSave* save, const char* message)
+{
+	int x = 20;
+	int y = GetScreenHeight() - 50;
+	if (save != NULL)
+	{
+		float progress = AsyncSave_progress(save);
+		DrawRectangle(x, y, 300, 30, LIGHTGRAY);
+		DrawRectangle(x, y, (int)(300 * progress), 30, LIME);
+		DrawRectangleLines(x, y, 300, 30, DARKGRAY);
+		DrawText(TextFormat("Saving... %d%%", (int)(100 * progress)), x + 10, y + 5, 20, BLACK);
+	}
+	else if (message != NULL)
+	{
+		DrawText(message, x, y + 5, 20, DARKGRAY);
+	}
+}
+
 void drawEdgeWeightEditBox(int show, Rectangle* textBox, char* edgeWeight, int letterCount, int framesCounter)
 {
 	DrawRectangleRec(*textBox, LIGHTGRAY);
@@ -582,10 +608,10 @@ void drawEdgeWeightEditBox(int show, Rectangle* textBox, char* edgeWeight, int l
 	else DrawText("Press BACKSPACE to delete chars...", (int)textBox->x, (int)textBox->y - 20, 20, GRAY);
 }
 
-void drawOrientedCurve(Node* node, NodesList* adjencyList, Vector2* middle)
+void drawOrientedCurve(Vector2 from, Vector2 to, Vector2* middle)
 {
-	Vector3 start = { node->x, node->y,0 };
-	Vector3 end = { adjencyList->node->x, adjencyList->node->y,0 };
+	Vector3 start = { from.x, from.y,0 };
+	Vector3 end = { to.x, to.y,0 };
 	Vector3 normal = Vector3Perpendicular(Vector3Subtract(end, start));
 	Vector2 normalNormalized = Vector2Normalize((Vector2) { normal.x, normal.y });
 
@@ -593,24 +619,24 @@ void drawOrientedCurve(Node* node, NodesList* adjencyList, Vector2* middle)
 	normalNormalized.x *= multiplier;
 	normalNormalized.y *= multiplier;
 
-	*middle = (Vector2){ (node->x + adjencyList->node->x) / 2 + normalNormalized.x ,
-		(node->y + adjencyList->node->y) / 2 + normalNormalized.y };
+	*middle = (Vector2){ (from.x + to.x) / 2 + normalNormalized.x ,
+		(from.y + to.y) / 2 + normalNormalized.y };
 
 	Vector2 colinear = Vector2Normalize((Vector2) {
-		(adjencyList->node->x - node->x) / 2,
-			(adjencyList->node->y - node->y) / 2
+		(to.x - from.x) / 2,
+			(to.y - from.y) / 2
 	});
 	colinear.x *= multiplier;
 	colinear.y *= multiplier;
-	//DrawLine(node->x, node->y, node->x + control1.x, node->y + control1.y, PURPLE);
-	//DrawLine(adjencyList->node->x, adjencyList->node->y, 
-	//	adjencyList->node->x + control1.x, adjencyList->node->y + control1.y, PURPLE);
+	//DrawLine(from.x, from.y, from.x + control1.x, from.y + control1.y, PURPLE);
+	//DrawLine(to.x, to.y, 
+	//	to.x + control1.x, to.y + control1.y, PURPLE);
 	DrawSplineSegmentBezierCubic(
 		(Vector2) {
-		node->x, node->y
+		from.x, from.y
 	},
 		(Vector2) {
-		node->x + normalNormalized.x, node->y + normalNormalized.y
+		from.x + normalNormalized.x, from.y + normalNormalized.y
 	},
 		(Vector2) {
 		middle->x, middle->y
@@ -620,10 +646,10 @@ void drawOrientedCurve(Node* node, NodesList* adjencyList, Vector2* middle)
 		RED);
 	DrawSplineSegmentBezierCubic(*middle, (Vector2) { middle->x, middle->y },
 		(Vector2) {
-		adjencyList->node->x + normalNormalized.x, adjencyList->node->y + normalNormalized.y
+		to.x + normalNormalized.x, to.y + normalNormalized.y
 	},
 		(Vector2) {
-		adjencyList->node->x, adjencyList->node->y
+		to.x, to.y
 	},
 		2,
 		RED);
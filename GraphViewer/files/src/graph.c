@@ -1,240 +1,1469 @@
 #include "graph.h"
+#include "BufferedWriter.h"
+#include "Platform.h"
+#include "json_stream.h"
 
-Graph* createGraph(typed(json_array)* nodesIdArray, const typed(json_element) jsonContent, const char* fileName)
+#define GRAPH_FILE_MAGIC 0x42475647u // "GVGB"
+#define GRAPH_FILE_VERSION 2
+
+//Extension of the file written before it replaces the saved graph
+#define GRAPH_TEMP_EXTENSION ".tmp"
+
+//FNV-1a parameters of Graph_fingerprint()
+#define GRAPH_FNV_OFFSET 14695981039346656037ull
+#define GRAPH_FNV_PRIME 1099511628211ull
+
+//Number of nodes written between two progress updates
+#define GRAPH_PROGRESS_STEP 4096
+
+/// @brief En-tête d'un fichier de graphe binaire.
+/// Chaque section est repérée par sa position depuis le début du fichier.
+typedef struct GraphFileHeader
 {
-	Graph* graph = (Graph*)calloc(1, sizeof(Graph));
-	AssertNew(graph);
+	uint32_t magic;
+	uint32_t version;
+	int32_t oriented;
+	int32_t nodesCount;
+	int32_t arcsCount;
+	int32_t idIndexCapacity;
+	uint64_t fileSize;
+	uint64_t snapshotId;
+
+	uint64_t arcOffsets;
+	uint64_t arcTargets;
+	uint64_t arcWeights;
+	uint64_t positions;
+	uint64_t idOffsets;
+	uint64_t idStrings;
+	uint64_t idSlots;
+	uint64_t idHashes;
+} GraphFileHeader;
 
-	graph->nodesCount = (int)nodesIdArray->count;
+static char* copyString(const char* str)
+{
+	size_t length = strlen(str);
+	char* copy = (char*)calloc(length + 1, sizeof(char));
+	AssertNew(copy);
 
-	NodesList* nodesList = (NodesList*)calloc(1, sizeof(NodesList));
-	AssertNew(nodesList);
+	memcpy(copy, str, length);
+	return copy;
+}
 
-	graph->nodes = nodesList;
+static void Graph_reserveNodes(Graph* graph, int capacity)
+{
+	if (capacity <= graph->nodesCapacity)
+		return;
 
-	//For the number of nodescount, we create a node and add it to the list
-	//of nodes of the graph, 
-	// each node has an empty adjacent list
-	for (int i = 0; i < graph->nodesCount; i++)
+	if (capacity < 2 * graph->nodesCapacity)
+		capacity = 2 * graph->nodesCapacity;
+
+	graph->ids = (char**)realloc(graph->ids, capacity * sizeof(char*));
+	AssertNew(graph->ids);
+	graph->positions = (Vector2*)realloc(graph->positions, capacity * sizeof(Vector2));
+	AssertNew(graph->positions);
+	graph->arcOffsets = (int*)realloc(graph->arcOffsets, (capacity + 1) * sizeof(int));
+	AssertNew(graph->arcOffsets);
+
+	graph->nodesCapacity = capacity;
+}
+
+static void Graph_reserveArcs(Graph* graph, int capacity)
+{
+	if (capacity <= graph->arcsCapacity)
+		return;
+
+	if (capacity < 2 * graph->arcsCapacity)
+		capacity = 2 * graph->arcsCapacity;
+
+	graph->arcTargets = (int*)realloc(graph->arcTargets, capacity * sizeof(int));
+	AssertNew(graph->arcTargets);
+	graph->arcWeights = (int*)realloc(graph->arcWeights, capacity * sizeof(int));
+	AssertNew(graph->arcWeights);
+
+	//The in-arcs kept up to date by the arc edits have the same capacity
+	if (graph->reverseValid)
+	{
+		graph->reverseSources = (int*)realloc(graph->reverseSources, capacity * sizeof(int));
+		AssertNew(graph->reverseSources);
+		graph->reverseWeights = (int*)realloc(graph->reverseWeights, capacity * sizeof(int));
+		AssertNew(graph->reverseWeights);
+	}
+
+	graph->arcsCapacity = capacity;
+}
+
+/// @brief Recopie sur le tas les tableaux d'un graphe projeté depuis un
+/// fichier binaire, puis libère la projection.
+static void Graph_unmap(Graph* graph)
+{
+	if (graph->mapping == NULL)
+		return;
+
+	int nodesCount = graph->nodesCount;
+	int arcsCount = graph->arcsCount;
+	int nodesCapacity = nodesCount > 0 ? nodesCount : 1;
+	int arcsCapacity = arcsCount > 0 ? arcsCount : 1;
+
+	char** ids = (char**)malloc(nodesCapacity * sizeof(char*));
+	AssertNew(ids);
+	for (int i = 0; i < nodesCount; i++)
+		ids[i] = copyString(graph->idStrings + graph->idOffsets[i]);
+
+	Vector2* positions = (Vector2*)malloc(nodesCapacity * sizeof(Vector2));
+	AssertNew(positions);
+	memcpy(positions, graph->positions, nodesCount * sizeof(Vector2));
+	int* arcOffsets = (int*)malloc((nodesCapacity + 1) * sizeof(int));
+	AssertNew(arcOffsets);
+	memcpy(arcOffsets, graph->arcOffsets, (nodesCount + 1) * sizeof(int));
+	int* arcTargets = (int*)malloc(arcsCapacity * sizeof(int));
+	AssertNew(arcTargets);
+	memcpy(arcTargets, graph->arcTargets, arcsCount * sizeof(int));
+	int* arcWeights = (int*)malloc(arcsCapacity * sizeof(int));
+	AssertNew(arcWeights);
+	memcpy(arcWeights, graph->arcWeights, arcsCount * sizeof(int));
+
+	//The hash table is copied as is, the ids keep their hashes
+	IdIndex* index = &graph->idIndex;
+	if (index->capacity > 0)
+	{
+		int* slots = (int*)malloc(index->capacity * sizeof(int));
+		AssertNew(slots);
+		memcpy(slots, index->slots, index->capacity * sizeof(int));
+		uint32_t* hashes = (uint32_t*)malloc(index->capacity * sizeof(uint32_t));
+		AssertNew(hashes);
+		memcpy(hashes, index->hashes, index->capacity * sizeof(uint32_t));
+		index->slots = slots;
+		index->hashes = hashes;
+	}
+
+	Platform_unmapFile(graph->mapping);
+	graph->mapping = NULL;
+	graph->idStrings = NULL;
+	graph->idOffsets = NULL;
+
+	graph->ids = ids;
+	graph->positions = positions;
+	graph->arcOffsets = arcOffsets;
+	graph->arcTargets = arcTargets;
+	graph->arcWeights = arcWeights;
+	graph->nodesCapacity = nodesCapacity;
+	graph->arcsCapacity = arcsCapacity;
+}
+
+//Last version given to a graph, shared by every graph of the program
+static uint64_t Graph_lastVersion = 0;
+
+static void Graph_touch(Graph* graph)
+{
+	graph->version = ++Graph_lastVersion;
+}
+
+static void Graph_notifyEdit(Graph* graph, const GraphEdit* edit)
+{
+	//The coordinates are not part of the versioned content
+	if (edit->type != GRAPH_EDIT_MOVE_NODE)
+		Graph_touch(graph);
+
+	for (int i = 0; i < graph->observersCount; i++)
+		graph->observers[i].callback(graph->observers[i].context, graph, edit);
+}
+
+static void Graph_notify(Graph* graph, GraphEditType type, int node, int from, int to, int arc, int oldWeight, int weight)
+{
+	GraphEdit edit = { type, node, from, to, arc, oldWeight, weight, NULL };
+	Graph_notifyEdit(graph, &edit);
+}
+
+void Graph_buildReverse(Graph* graph)
+{
+	if (graph->reverseValid)
+		return;
+
+	int nodesCount = graph->nodesCount;
+	int arcsCount = graph->arcsCount;
+	int arcsCapacity = graph->arcsCapacity > arcsCount ? graph->arcsCapacity : arcsCount;
+	if (arcsCapacity < 1)
+		arcsCapacity = 1;
+
+	free(graph->reverseOffsets);
+	free(graph->reverseSources);
+	free(graph->reverseWeights);
+	graph->reverseOffsets = (int*)calloc(nodesCount + 1, sizeof(int));
+	AssertNew(graph->reverseOffsets);
+	graph->reverseSources = (int*)malloc(arcsCapacity * sizeof(int));
+	AssertNew(graph->reverseSources);
+	graph->reverseWeights = (int*)malloc(arcsCapacity * sizeof(int));
+	AssertNew(graph->reverseWeights);
+
+	//Counting sort of the arcs by target
+	for (int arc = 0; arc < arcsCount; arc++)
+		graph->reverseOffsets[graph->arcTargets[arc] + 1]++;
+	for (int i = 0; i < nodesCount; i++)
+		graph->reverseOffsets[i + 1] += graph->reverseOffsets[i];
+
+	int* next = (int*)malloc((nodesCount > 0 ? nodesCount : 1) * sizeof(int));
+	AssertNew(next);
+	memcpy(next, graph->reverseOffsets, nodesCount * sizeof(int));
+
+	for (int u = 0; u < nodesCount; u++)
+	{
+		for (int arc = graph->arcOffsets[u]; arc < graph->arcOffsets[u + 1]; arc++)
+		{
+			int slot = next[graph->arcTargets[arc]]++;
+			graph->reverseSources[slot] = u;
+			graph->reverseWeights[slot] = graph->arcWeights[arc];
+		}
+	}
+	free(next);
+
+	graph->reverseValid = true;
+}
+
+/// @brief Renvoie la position de l'arc from -> arcTargets[arc] parmi les arcs
+/// entrants de sa cible, qui sont triés par source puis dans l'ordre des arcs
+/// sortants. Complexité en O(degré sortant de from + degré entrant de la cible).
+static int Graph_reverseSlot(Graph* graph, int from, int arc)
+{
+	int to = graph->arcTargets[arc];
+	int slot = graph->reverseOffsets[to];
+	while (graph->reverseSources[slot] != from)
+		slot++;
+	for (int other = graph->arcOffsets[from]; other < arc; other++)
+	{
+		if (graph->arcTargets[other] == to)
+			slot++;
+	}
+	return slot;
+}
+
+//Part of the json graph file the streaming loader is reading
+typedef enum GraphJsonSection
+{
+	GRAPH_JSON_NONE,
+	GRAPH_JSON_ORIENTED,
+	GRAPH_JSON_NODES_IDS,
+	GRAPH_JSON_NODE,
+	GRAPH_JSON_EARLY_NODE,
+	GRAPH_JSON_X,
+	GRAPH_JSON_Y,
+	GRAPH_JSON_ADJENCY_LIST
+} GraphJsonSection;
+
+/// @brief État du chargement en flux d'un fichier de graphe JSON : les
+/// événements du parseur sont appliqués directement au graphe, sans
+/// construire le document en mémoire.
+typedef struct GraphJsonLoader
+{
+	Graph* graph;
+
+	/// @brief Raison de l'échec du chargement, NULL tant qu'il n'y en a pas.
+	const char* error;
+
+	/// @brief Clé de l'objet racine et clé de l'objet d'un sommet en cours.
+	GraphJsonSection section;
+	GraphJsonSection field;
+
+	/// @brief Indique si le tableau "nodesIds" a été lu.
+	bool idsRead;
+
+	/// @brief Sommet dont l'objet est en cours de lecture et ses coordonnées.
+	int node;
+	Vector2 position;
+	bool hasX;
+	bool hasY;
+
+	/// @brief Arc en cours de lecture : nombre d'éléments lus, cible et poids.
+	int arcElements;
+	int arcTarget;
+	int arcWeight;
+	bool hasWeight;
+
+	/// @brief Premier arc de chaque sommet dans l'ordre du fichier, -1 tant
+	/// que l'objet du sommet n'a pas été lu. Les arcs d'un sommet sont
+	/// contigus, leur nombre est rangé dans arcOffsets[sommet + 1].
+	int* arcStarts;
+
+	/// @brief Indique si les objets des sommets sont dans l'ordre des indices
+	/// (c'est le cas des fichiers écrits par saveGraph()), dernier objet lu.
+	bool sorted;
+	int lastNode;
+} GraphJsonLoader;
+
+static bool GraphJson_fail(GraphJsonLoader* loader, const char* error)
+{
+	loader->error = error;
+	return false;
+}
+
+static double GraphJson_number(const typed(json_number)* number)
+{
+	if (number->type == JSON_NUMBER_TYPE_DOUBLE)
+		return number->value.as_double;
+	return (double)number->value.as_long;
+}
+
+static void GraphJson_addNodeId(GraphJsonLoader* loader, const char* id)
+{
+	Graph* graph = loader->graph;
+	int node = graph->nodesCount;
+
+	Graph_reserveNodes(graph, node + 1);
+	graph->ids[node] = copyString(id);
+	graph->positions[node] = (Vector2){ -1, -1 };
+	graph->nodesCount++;
+}
+
+static void GraphJson_endNodesIds(GraphJsonLoader* loader)
+{
+	Graph* graph = loader->graph;
+	int nodesCount = graph->nodesCount;
+
+	IdIndex_rebuild(&graph->idIndex, graph->ids, nodesCount);
+
+	loader->arcStarts = (int*)malloc((nodesCount > 0 ? nodesCount : 1) * sizeof(int));
+	AssertNew(loader->arcStarts);
+	for (int i = 0; i < nodesCount; i++)
+	{
+		loader->arcStarts[i] = -1;
+		graph->arcOffsets[i + 1] = 0;
+	}
+	loader->idsRead = true;
+}
+
+/// @brief Choisit la partie du fichier à laquelle appartient une clé de
+/// l'objet racine.
+static bool GraphJson_rootKey(GraphJsonLoader* loader, const char* key)
+{
+	loader->field = GRAPH_JSON_NONE;
+
+	if (strcmp(key, "oriented") == 0)
+	{
+		loader->section = GRAPH_JSON_ORIENTED;
+	}
+	else if (strcmp(key, "nodesIds") == 0)
+	{
+		if (loader->idsRead)
+			return GraphJson_fail(loader, "\"nodesIds\" appears twice");
+		loader->section = GRAPH_JSON_NODES_IDS;
+	}
+	else if (!loader->idsRead)
+	{
+		//Whether it is a node can only be known once the ids are read
+		loader->section = GRAPH_JSON_EARLY_NODE;
+	}
+	else
+	{
+		//Unknown keys are ignored, and only the first object of a node is read
+		int node = Graph_getNodeIndex(loader->graph, key);
+		loader->section = node >= 0 && loader->arcStarts[node] < 0 ? GRAPH_JSON_NODE : GRAPH_JSON_NONE;
+		loader->node = node;
+	}
+	return true;
+}
+
+static bool GraphJson_nodesIdsEvent(GraphJsonLoader* loader, typed(json_event) event, const typed(json_stream_value)* value, int depth)
+{
+	if (depth == 1 && event == JSON_EVENT_ARRAY_BEGIN)
+		return true;
+
+	if (depth == 1 && event == JSON_EVENT_ARRAY_END)
 	{
-		Node* nodeCurrent = (Node*)calloc(1, sizeof(Node));
-		AssertNew(nodeCurrent);
+		GraphJson_endNodesIds(loader);
+		loader->section = GRAPH_JSON_NONE;
+		return true;
+	}
+
+	if (depth == 2 && event == JSON_EVENT_STRING)
+	{
+		GraphJson_addNodeId(loader, value->string);
+		return true;
+	}
+	return GraphJson_fail(loader, "\"nodesIds\" must be an array of strings");
+}
+
+static void GraphJson_beginNode(GraphJsonLoader* loader)
+{
+	int node = loader->node;
+
+	loader->arcStarts[node] = loader->graph->arcsCount;
+	loader->hasX = false;
+	loader->hasY = false;
+
+	if (node < loader->lastNode)
+		loader->sorted = false;
+	loader->lastNode = node;
+}
+
+static void GraphJson_endNode(GraphJsonLoader* loader)
+{
+	Graph* graph = loader->graph;
+	int node = loader->node;
+
+	graph->arcOffsets[node + 1] = graph->arcsCount - loader->arcStarts[node];
+	if (loader->hasX && loader->hasY)
+		graph->positions[node] = loader->position;
+
+	loader->section = GRAPH_JSON_NONE;
+}
+
+/// @brief Lit un élément d'un arc ["cible", poids].
+static void GraphJson_arcElement(GraphJsonLoader* loader, typed(json_event) event, const typed(json_stream_value)* value)
+{
+	Graph* graph = loader->graph;
+	int element = loader->arcElements++;
+
+	if (element == 0 && event == JSON_EVENT_STRING)
+	{
+		loader->arcTarget = Graph_getNodeIndex(graph, value->string);
+		if (loader->arcTarget < 0)
+			fprintf(stderr, "Unknown node \"%s\" in the adjency list of \"%s\"\n", value->string, graph->ids[loader->node]);
+	}
+	else if (element == 1 && event == JSON_EVENT_NUMBER)
+	{
+		loader->arcWeight = (int)GraphJson_number(&value->number);
+		loader->hasWeight = true;
+	}
+}
+
+static void GraphJson_endArc(GraphJsonLoader* loader)
+{
+	Graph* graph = loader->graph;
 
-		typed(json_element) nodeId = nodesIdArray->elements[i];
-		int nameLength = strlen(nodeId.value.as_string);
+	if (loader->arcTarget < 0 || !loader->hasWeight)
+		return;
 
-		nodeCurrent->id = (char*)calloc(nameLength, sizeof(char));
-		AssertNew(nodeCurrent->id);
+	Graph_reserveArcs(graph, graph->arcsCount + 1);
+	graph->arcTargets[graph->arcsCount] = loader->arcTarget;
+	graph->arcWeights[graph->arcsCount] = loader->arcWeight;
+	graph->arcsCount++;
+}
 
-		strcpy(nodeCurrent->id, nodeId.value.as_string);
+static bool GraphJson_nodeEvent(GraphJsonLoader* loader, typed(json_event) event, const typed(json_stream_value)* value, int depth)
+{
+	if (depth == 1)
+	{
+		//A node whose value is not an object has no coordinates nor arcs
+		if (event == JSON_EVENT_OBJECT_BEGIN)
+			GraphJson_beginNode(loader);
+		else if (event == JSON_EVENT_OBJECT_END)
+			GraphJson_endNode(loader);
+		return true;
+	}
 
-		nodeCurrent->data = i * 10;
-		nodeCurrent->x = -1;
-		nodeCurrent->y = -1;
+	if (depth == 2 && event == JSON_EVENT_KEY)
+	{
+		if (strcmp(value->string, "x") == 0)
+			loader->field = GRAPH_JSON_X;
+		else if (strcmp(value->string, "y") == 0)
+			loader->field = GRAPH_JSON_Y;
+		else if (strcmp(value->string, "adjencyList") == 0)
+			loader->field = GRAPH_JSON_ADJENCY_LIST;
+		else
+			loader->field = GRAPH_JSON_NONE;
+		return true;
+	}
 
-		nodeCurrent->adjacent = NULL;
-		nodesList->node = nodeCurrent;
+	if (depth == 2 && event == JSON_EVENT_NUMBER)
+	{
+		if (loader->field == GRAPH_JSON_X)
+		{
+			loader->position.x = (float)GraphJson_number(&value->number);
+			loader->hasX = true;
+		}
+		else if (loader->field == GRAPH_JSON_Y)
+		{
+			loader->position.y = (float)GraphJson_number(&value->number);
+			loader->hasY = true;
+		}
+		return true;
+	}
 
-		nodesList->next = (NodesList*)calloc(1, sizeof(NodesList));
-		AssertNew(nodesList->next);
+	if (loader->field != GRAPH_JSON_ADJENCY_LIST)
+		return true;
 
-		nodesList = nodesList->next;
-		nodesList->node = NULL;
-		nodesList->next = NULL;
+	if (depth == 3 && event == JSON_EVENT_ARRAY_BEGIN)
+	{
+		loader->arcElements = 0;
+		loader->arcTarget = -1;
+		loader->hasWeight = false;
+	}
+	else if (depth == 3 && event == JSON_EVENT_ARRAY_END)
+	{
+		GraphJson_endArc(loader);
 	}
+	else if (depth == 4 && event != JSON_EVENT_ARRAY_END && event != JSON_EVENT_OBJECT_END)
+	{
+		GraphJson_arcElement(loader, event, value);
+	}
+	return true;
+}
 
-	graph->fileName = (char*)calloc(strlen(fileName), sizeof(char));
-	AssertNew(graph->fileName);
+static bool GraphJson_event(void* context, typed(json_event) event, const typed(json_stream_value)* value, int depth)
+{
+	GraphJsonLoader* loader = (GraphJsonLoader*)context;
+
+	if (depth == 0)
+	{
+		if (event != JSON_EVENT_OBJECT_BEGIN && event != JSON_EVENT_OBJECT_END)
+			return GraphJson_fail(loader, "the file does not contain an object");
+		return true;
+	}
+
+	if (depth == 1 && event == JSON_EVENT_KEY)
+		return GraphJson_rootKey(loader, value->string);
+
+	switch (loader->section)
+	{
+	case GRAPH_JSON_ORIENTED:
+		if (depth == 1 && event == JSON_EVENT_NUMBER)
+			loader->graph->oriented = GraphJson_number(&value->number) != 0;
+		else if (depth == 1 && event == JSON_EVENT_BOOLEAN)
+			loader->graph->oriented = value->boolean;
+		else if (depth == 1)
+			return GraphJson_fail(loader, "\"oriented\" must be a number");
+		return true;
 
-	typed(json_element) bOriented = getJsonElementFromName(jsonContent, "oriented");
-	graph->oriented = bOriented.value.as_number.value.as_long;
-	strcpy(graph->fileName, fileName);
+	case GRAPH_JSON_NODES_IDS:
+		return GraphJson_nodesIdsEvent(loader, event, value, depth);
 
+	case GRAPH_JSON_NODE:
+		return GraphJson_nodeEvent(loader, event, value, depth);
+
+	case GRAPH_JSON_EARLY_NODE:
+		if (depth == 1 && event == JSON_EVENT_OBJECT_BEGIN)
+			return GraphJson_fail(loader, "the nodes must follow \"nodesIds\"");
+		return true;
+
+	default:
+		return true;
+	}
+}
+
+/// @brief Range les arcs lus par sommet : leur nombre, rangé dans
+/// arcOffsets[sommet + 1], devient la position de leur premier arc.
+static void GraphJson_packArcs(GraphJsonLoader* loader)
+{
+	Graph* graph = loader->graph;
+	int nodesCount = graph->nodesCount;
+
+	graph->arcOffsets[0] = 0;
+	for (int i = 0; i < nodesCount; i++)
+		graph->arcOffsets[i + 1] += graph->arcOffsets[i];
+
+	//When the nodes are in index order, their arcs are already packed
+	if (loader->sorted)
+		return;
+
+	int capacity = graph->arcsCapacity > 0 ? graph->arcsCapacity : 1;
+	int* targets = (int*)malloc(capacity * sizeof(int));
+	AssertNew(targets);
+	int* weights = (int*)malloc(capacity * sizeof(int));
+	AssertNew(weights);
+
+	for (int i = 0; i < nodesCount; i++)
+	{
+		int count = graph->arcOffsets[i + 1] - graph->arcOffsets[i];
+		if (count == 0)
+			continue;
+
+		memcpy(targets + graph->arcOffsets[i], graph->arcTargets + loader->arcStarts[i], count * sizeof(int));
+		memcpy(weights + graph->arcOffsets[i], graph->arcWeights + loader->arcStarts[i], count * sizeof(int));
+	}
+
+	free(graph->arcTargets);
+	free(graph->arcWeights);
+	graph->arcTargets = targets;
+	graph->arcWeights = weights;
+	graph->arcsCapacity = capacity;
+}
+
+Graph* Graph_create(bool oriented)
+{
+	Graph* graph = (Graph*)calloc(1, sizeof(Graph));
+	AssertNew(graph);
+	Graph_reserveNodes(graph, 1);
+	graph->arcOffsets[0] = 0;
+	graph->oriented = oriented;
+
+	Graph_touch(graph);
 	return graph;
 }
 
 Graph* jsonCreateGraphFromFile(const char* jsonFile)
 {
-	//json structure : 
-	//nbNodes is an integer containing the number of nodes
+	//json structure :
 	//oriented is a boolean containing if the graph is oriented or not
+	//nodesIds is the array of the ids of the nodes, in index order
 	//each node is a dictionary whose key is its id and its value contains its coordinates {x, y} and its adjencyList
 	//The adjencyList is an n-element array of 2-elements array : first element is the id of the connected node and the second is the weight of the edge
-	typed(json_element) jsonContent = interpretJSon(jsonFile);
-	typed(json_element) nodesIds = getJsonElementFromName(jsonContent, "nodesIds");
+	//The file is parsed as a stream : nodes and arcs are added to the graph while they are read,
+	//so nodesIds must come before the nodes
+	FILE* file = fopen(jsonFile, "rb");
+	if (file == NULL)
+	{
+		fprintf(stderr, "Error opening file %s\n", jsonFile);
+		return NULL;
+	}
 
-	typed(json_array)* nodesIdArray = nodesIds.value.as_array;
-	Graph* graph = createGraph(nodesIdArray, jsonContent, jsonFile);
+	Graph* graph = Graph_create(false);
 
+	GraphJsonLoader loader = { 0 };
+	loader.graph = graph;
+	loader.sorted = true;
+	loader.lastNode = -1;
 
-	// Get the nodes from the graph and fill the information from the json file
-	NodesList* curNodeList = graph->nodes;
-	for (int i = 0; i < graph->nodesCount; i++)
+	typed(json_stream_error) error;
+	bool ok = json_stream_parse(file, GraphJson_event, &loader, &error);
+	fclose(file);
+	if (ok && !loader.idsRead)
+		ok = GraphJson_fail(&loader, "\"nodesIds\" is missing");
+
+	if (!ok)
 	{
-		//retrieve the node id
-		//With its id, get the dictionary containing the node information
-		typed(json_element) nodeId = nodesIdArray->elements[i];
-		typed(json_element) nodeAsObject = getJsonElementFromName(jsonContent, nodeId.value.as_string);
+		if (loader.error != NULL)
+			fprintf(stderr, "Invalid graph file %s: %s\n", jsonFile, loader.error);
+		else
+			fprintf(stderr, "Invalid graph file %s at byte %llu\n", jsonFile, (unsigned long long)error.offset);
 
-		//From this dictionnary, get the x and y coordinates of the node
-		Node* curNode = curNodeList->node;
-		curNode->x = -1;
-		typed(json_element) nodeX = getJsonElementFromName(nodeAsObject, "x");
-		curNode->x = (float)nodeX.value.as_number.value.as_double;
+		free(loader.arcStarts);
+		Graph_destroy(graph);
+		return NULL;
+	}
 
-		curNode->y = -1;
-		typed(json_element) nodeY = getJsonElementFromName(nodeAsObject, "y");
-		curNode->y = (float)nodeY.value.as_number.value.as_double;
+	GraphJson_packArcs(&loader);
+	free(loader.arcStarts);
 
-		//From this dictionnary, get the adjency list of the node
-		if (hasElementWithName(nodeAsObject, "adjencyList"))
-		{
+	graph->fileName = copyString(jsonFile);
+	Graph_touch(graph);
+	return graph;
+}
 
-			typed(json_element) connectedNodeIds = getJsonElementFromName(nodeAsObject, "adjencyList");
+void Graph_destroy(Graph* graph)
+{
+	if (graph == NULL)
+		return;
 
-			typed(json_array)* values = connectedNodeIds.value.as_array;
-			char** adjencents = (char**)calloc(values->count, sizeof(char*));
-			AssertNew(adjencents);
+	if (graph->mapping != NULL)
+	{
+		//The arrays and the hash table live in the mapped file
+		Platform_unmapFile(graph->mapping);
+	}
+	else
+	{
+		for (int i = 0; i < graph->nodesCount; i++)
+			free(graph->ids[i]);
 
-			long* adjencentsWeight = (long*)calloc(values->count, sizeof(long));
-			AssertNew(adjencentsWeight);
+		IdIndex_free(&graph->idIndex);
+		free(graph->ids);
+		free(graph->positions);
+		free(graph->arcOffsets);
+		free(graph->arcTargets);
+		free(graph->arcWeights);
+	}
+	free(graph->reverseOffsets);
+	free(graph->reverseSources);
+	free(graph->reverseWeights);
+	free(graph->observers);
+	free(graph->fileName);
+	free(graph);
+}
 
-			//For each element of the adjency list, get the id of the connected node and the weight of the edge
-			for (int j = 0; j < values->count; j++) {
-				typed(json_element) element = values->elements[j];
-				typed(json_array)* edgeInfos = element.value.as_array;
+//Last snapshot id given by Graph_newSnapshotId(), shared by the threads that save graphs
+static volatile uint64_t Graph_lastSnapshotId = 0;
 
-				if (edgeInfos != NULL)
-				{
-					if (edgeInfos->elements[0].value.as_number.value.as_long != -1) {
-						adjencents[j] = (char*)calloc(strlen(edgeInfos->elements[0].value.as_string), sizeof(char));
-						AssertNew(adjencents[j]);
+uint64_t Graph_newSnapshotId(void)
+{
+	uint64_t last = Atomic_load64(&Graph_lastSnapshotId);
+	uint64_t id;
+	do
+	{
+		if (last != 0)
+		{
+			id = last + 1;
+		}
+		else
+		{
+			//splitmix64 finalizer
+			id = ((uint64_t)time(NULL) << 20) ^ (uint64_t)clock() ^ (uint64_t)(uintptr_t)&Graph_lastSnapshotId;
+			id = (id ^ (id >> 30)) * 0xBF58476D1CE4E5B9ull;
+			id = (id ^ (id >> 27)) * 0x94D049BB133111EBull;
+			id ^= id >> 31;
+		}
+		if (id == 0)
+			id = 1;
+	} while (!Atomic_compareExchange64(&Graph_lastSnapshotId, &last, id));
+	return id;
+}
 
-						strcpy(adjencents[j], edgeInfos->elements[0].value.as_string);
-						adjencentsWeight[j] = edgeInfos->elements[1].value.as_number.value.as_long;
-					}
-				}
-			}
+/// @brief Publie le nombre de sommets déjà écrits, tous les
+/// GRAPH_PROGRESS_STEP sommets pour ne pas ralentir l'écriture.
+static void Graph_reportProgress(volatile uint64_t* progress, int node)
+{
+	if (progress != NULL && node % GRAPH_PROGRESS_STEP == 0)
+		Atomic_store64(progress, (uint64_t)node);
+}
 
-			NodesList* adjencyList = (NodesList*)calloc(1, sizeof(NodesList));
-			AssertNew(adjencyList);
+/// @brief Ecrit le graphe au format JSON dans un fichier ouvert.
+static bool Graph_writeJson(Graph* graph, FILE* file, volatile uint64_t* progress)
+{
+	//The text is formatted in a large buffer written in big chunks
+	BufferedWriter writer;
+	BufferedWriter_init(&writer, file, 0);
 
-			curNode->adjacent = adjencyList;
-			adjencyList->node = NULL;
-			adjencyList->next = NULL;
-			createAdjacentList(graph, adjencyList, adjencents, adjencentsWeight, (int)values->count);
+	BufferedWriter_writeString(&writer, "{\"oriented\":");
+	BufferedWriter_writeInt(&writer, graph->oriented);
+	//Saves the nodes ids
+	BufferedWriter_writeString(&writer, ",\"nodesIds\":[");
+	for (int i = 0; i < graph->nodesCount; i++)
+	{
+		BufferedWriter_writeChar(&writer, '"');
+		BufferedWriter_writeString(&writer, Graph_getNodeId(graph, i));
+		BufferedWriter_writeChar(&writer, '"');
+		if (i != graph->nodesCount - 1)
+			BufferedWriter_writeChar(&writer, ',');
+	}
+	BufferedWriter_writeString(&writer, "],");
+
+	//Saves each node information
+	for (int i = 0; i < graph->nodesCount; i++)
+	{
+		Graph_reportProgress(progress, i);
+		BufferedWriter_writeChar(&writer, '"');
+		BufferedWriter_writeString(&writer, Graph_getNodeId(graph, i));
+		BufferedWriter_writeString(&writer, "\":{\"x\":");
+		BufferedWriter_writeFloat1(&writer, graph->positions[i].x);
+		BufferedWriter_writeString(&writer, ",\"y\":");
+		BufferedWriter_writeFloat1(&writer, graph->positions[i].y);
+		BufferedWriter_writeString(&writer, ",\"adjencyList\":[");
+		int end = Graph_arcEnd(graph, i);
+		for (int arc = Graph_arcBegin(graph, i); arc < end; arc++)
+		{
+			BufferedWriter_writeString(&writer, "[\"");
+			BufferedWriter_writeString(&writer, Graph_getNodeId(graph, graph->arcTargets[arc]));
+			BufferedWriter_writeString(&writer, "\",");
+			BufferedWriter_writeInt(&writer, graph->arcWeights[arc]);
+			BufferedWriter_writeChar(&writer, ']');
+			if (arc != end - 1)
+				BufferedWriter_writeChar(&writer, ',');
 		}
-		curNodeList = curNodeList->next;
+		BufferedWriter_writeString(&writer, "]}");
+		if (i != graph->nodesCount - 1)
+			BufferedWriter_writeChar(&writer, ',');
+	}
+	BufferedWriter_writeChar(&writer, '}');
+
+	return BufferedWriter_finish(&writer);
+}
+
+static uint64_t GraphFile_align(uint64_t offset)
+{
+	return (offset + 7) & ~(uint64_t)7;
+}
+
+/// @brief Ecrit une section à sa position, précédée des octets de remplissage.
+static bool GraphFile_writeSection(FILE* file, uint64_t* written, uint64_t offset, const void* data, size_t size)
+{
+	static const char padding[8] = { 0 };
+	bool ok = fwrite(padding, 1, (size_t)(offset - *written), file) == offset - *written;
+	ok = ok && (size == 0 || fwrite(data, 1, size, file) == size);
+	*written = offset + size;
+	return ok;
+}
+
+/// @brief Ecrit le graphe au format binaire dans un fichier ouvert.
+static bool Graph_writeBinary(Graph* graph, FILE* file, uint64_t snapshotId, volatile uint64_t* progress)
+{
+	int nodesCount = graph->nodesCount;
+	int arcsCount = graph->arcsCount;
+
+	int64_t* idOffsets = (int64_t*)malloc((nodesCount > 0 ? nodesCount : 1) * sizeof(int64_t));
+	AssertNew(idOffsets);
+	int64_t idStringsSize = 0;
+	for (int i = 0; i < nodesCount; i++)
+	{
+		idOffsets[i] = idStringsSize;
+		idStringsSize += strlen(Graph_getNodeId(graph, i)) + 1;
+	}
+
+	GraphFileHeader header = { 0 };
+	header.magic = GRAPH_FILE_MAGIC;
+	header.version = GRAPH_FILE_VERSION;
+	header.oriented = graph->oriented;
+	header.nodesCount = nodesCount;
+	header.arcsCount = arcsCount;
+	header.idIndexCapacity = graph->idIndex.capacity;
+	header.snapshotId = snapshotId;
+
+	header.arcOffsets = GraphFile_align(sizeof(GraphFileHeader));
+	header.arcTargets = GraphFile_align(header.arcOffsets + (nodesCount + 1) * sizeof(int));
+	header.arcWeights = GraphFile_align(header.arcTargets + arcsCount * sizeof(int));
+	header.positions = GraphFile_align(header.arcWeights + arcsCount * sizeof(int));
+	header.idOffsets = GraphFile_align(header.positions + nodesCount * sizeof(Vector2));
+	header.idStrings = GraphFile_align(header.idOffsets + nodesCount * sizeof(int64_t));
+	header.idSlots = GraphFile_align(header.idStrings + idStringsSize);
+	header.idHashes = GraphFile_align(header.idSlots + header.idIndexCapacity * sizeof(int));
+	header.fileSize = header.idHashes + header.idIndexCapacity * sizeof(uint32_t);
+
+	uint64_t written = 0;
+	bool ok = GraphFile_writeSection(file, &written, 0, &header, sizeof(header));
+	ok = ok && GraphFile_writeSection(file, &written, header.arcOffsets, graph->arcOffsets, (nodesCount + 1) * sizeof(int));
+	ok = ok && GraphFile_writeSection(file, &written, header.arcTargets, graph->arcTargets, arcsCount * sizeof(int));
+	ok = ok && GraphFile_writeSection(file, &written, header.arcWeights, graph->arcWeights, arcsCount * sizeof(int));
+	ok = ok && GraphFile_writeSection(file, &written, header.positions, graph->positions, nodesCount * sizeof(Vector2));
+	ok = ok && GraphFile_writeSection(file, &written, header.idOffsets, idOffsets, nodesCount * sizeof(int64_t));
+	for (int i = 0; ok && i < nodesCount; i++)
+	{
+		Graph_reportProgress(progress, i);
+		const char* id = Graph_getNodeId(graph, i);
+		ok = GraphFile_writeSection(file, &written, header.idStrings + idOffsets[i], id, strlen(id) + 1);
+	}
+	ok = ok && GraphFile_writeSection(file, &written, header.idSlots, graph->idIndex.slots, header.idIndexCapacity * sizeof(int));
+	ok = ok && GraphFile_writeSection(file, &written, header.idHashes, graph->idIndex.hashes, header.idIndexCapacity * sizeof(uint32_t));
+
+	free(idOffsets);
+	return ok;
+}
+
+bool Graph_saveAs(Graph* graph, const char* fileName, bool binary, volatile uint64_t* progress)
+{
+	//Only the binary format has room for an id
+	return Graph_saveAsSnapshot(graph, fileName, binary, binary ? Graph_newSnapshotId() : 0, progress);
+}
+
+bool Graph_saveAsSnapshot(Graph* graph, const char* fileName, bool binary, uint64_t snapshotId, volatile uint64_t* progress)
+{
+	assert(graph && fileName);
+
+	//A mapped file cannot be replaced on every platform
+	if (graph->mapping != NULL && strcmp(graph->fileName, fileName) == 0)
+		Graph_unmap(graph);
+
+	//The graph is written next to its file, which is only replaced once complete
+	size_t length = strlen(fileName);
+	char* tempName = (char*)malloc(length + sizeof(GRAPH_TEMP_EXTENSION));
+	AssertNew(tempName);
+	memcpy(tempName, fileName, length);
+	memcpy(tempName + length, GRAPH_TEMP_EXTENSION, sizeof(GRAPH_TEMP_EXTENSION));
+
+	FILE* file = fopen(tempName, binary ? "wb" : "w");
+	if (file == NULL)
+	{
+		fprintf(stderr, "Error opening file %s\n", tempName);
+		free(tempName);
+		return false;
+	}
+
+	if (!binary)
+		snapshotId = 0;
+	bool ok = binary ? Graph_writeBinary(graph, file, snapshotId, progress) : Graph_writeJson(graph, file, progress);
+	ok = ok && Platform_syncFile(file);
+	ok = fclose(file) == 0 && ok;
+	ok = ok && Platform_replaceFile(tempName, fileName);
+	if (!ok)
+	{
+		fprintf(stderr, "Error writing file %s\n", fileName);
+		remove(tempName);
+	}
+	else
+	{
+		graph->snapshotId = snapshotId;
+		if (progress != NULL)
+			Atomic_store64(progress, (uint64_t)graph->nodesCount);
 	}
+	free(tempName);
+	return ok;
+}
+
+void saveGraph(Graph* graph)
+{
+	Graph_saveAs(graph, graph->fileName, graph->binaryFile, NULL);
+}
+
+bool Graph_saveBinary(Graph* graph, const char* fileName)
+{
+	return Graph_saveAs(graph, fileName, true, NULL);
+}
+
+Graph* Graph_snapshot(Graph* graph)
+{
+	assert(graph);
+
+	//The file of a mapped graph is about to be replaced
+	Graph_unmap(graph);
+
+	int nodesCount = graph->nodesCount;
+	int arcsCount = graph->arcsCount;
+	int nodesCapacity = nodesCount > 0 ? nodesCount : 1;
+	int arcsCapacity = arcsCount > 0 ? arcsCount : 1;
+
+	Graph* copy = (Graph*)calloc(1, sizeof(Graph));
+	AssertNew(copy);
+	copy->nodesCount = nodesCount;
+	copy->arcsCount = arcsCount;
+	copy->oriented = graph->oriented;
+	copy->fileName = graph->fileName != NULL ? copyString(graph->fileName) : NULL;
+	copy->binaryFile = graph->binaryFile;
+	copy->snapshotId = graph->snapshotId;
+	copy->nodesCapacity = nodesCapacity;
+	copy->arcsCapacity = arcsCapacity;
 
-	//json_print(&element, 2);
-	//json_free(&element);
+	copy->ids = (char**)malloc(nodesCapacity * sizeof(char*));
+	AssertNew(copy->ids);
+	for (int i = 0; i < nodesCount; i++)
+		copy->ids[i] = copyString(graph->ids[i]);
+
+	copy->positions = (Vector2*)malloc(nodesCapacity * sizeof(Vector2));
+	AssertNew(copy->positions);
+	copy->arcOffsets = (int*)malloc((nodesCapacity + 1) * sizeof(int));
+	AssertNew(copy->arcOffsets);
+	copy->arcTargets = (int*)malloc(arcsCapacity * sizeof(int));
+	AssertNew(copy->arcTargets);
+	copy->arcWeights = (int*)malloc(arcsCapacity * sizeof(int));
+	AssertNew(copy->arcWeights);
+
+	//The arrays of an empty graph may not be allocated
+	copy->arcOffsets[0] = 0;
+	if (nodesCount > 0)
+	{
+		memcpy(copy->positions, graph->positions, nodesCount * sizeof(Vector2));
+		memcpy(copy->arcOffsets, graph->arcOffsets, (nodesCount + 1) * sizeof(int));
+	}
+	if (arcsCount > 0)
+	{
+		memcpy(copy->arcTargets, graph->arcTargets, arcsCount * sizeof(int));
+		memcpy(copy->arcWeights, graph->arcWeights, arcsCount * sizeof(int));
+	}
+
+	//The binary format stores the hash table, so it is copied as is
+	IdIndex* index = &graph->idIndex;
+	copy->idIndex = *index;
+	if (index->capacity > 0)
+	{
+		copy->idIndex.slots = (int*)malloc(index->capacity * sizeof(int));
+		AssertNew(copy->idIndex.slots);
+		memcpy(copy->idIndex.slots, index->slots, index->capacity * sizeof(int));
+		copy->idIndex.hashes = (uint32_t*)malloc(index->capacity * sizeof(uint32_t));
+		AssertNew(copy->idIndex.hashes);
+		memcpy(copy->idIndex.hashes, index->hashes, index->capacity * sizeof(uint32_t));
+	}
+
+	//Same content, same version
+	copy->version = graph->version;
+	return copy;
+}
+
+/// @brief Vérifie qu'une section de count éléments est alignée et tient dans le fichier.
+static bool GraphFile_checkSection(const GraphFileHeader* header, uint64_t offset, uint64_t count, size_t elementSize)
+{
+	return offset % 8 == 0 && offset >= sizeof(GraphFileHeader) && offset <= header->fileSize
+		&& count <= (header->fileSize - offset) / elementSize;
+}
+
+static bool GraphFile_checkHeader(const GraphFileHeader* header, size_t fileSize)
+{
+	if (fileSize < sizeof(GraphFileHeader) || header->magic != GRAPH_FILE_MAGIC || header->version != GRAPH_FILE_VERSION)
+		return false;
+	if (header->fileSize != fileSize || header->nodesCount < 0 || header->arcsCount < 0)
+		return false;
+
+	//The hash table needs a power of two capacity and an empty slot
+	int capacity = header->idIndexCapacity;
+	if (capacity < 0 || (capacity & (capacity - 1)) != 0 || (header->nodesCount > 0 && capacity <= header->nodesCount))
+		return false;
+
+	uint64_t nodesCount = (uint64_t)header->nodesCount;
+	uint64_t arcsCount = (uint64_t)header->arcsCount;
+	return GraphFile_checkSection(header, header->arcOffsets, nodesCount + 1, sizeof(int))
+		&& GraphFile_checkSection(header, header->arcTargets, arcsCount, sizeof(int))
+		&& GraphFile_checkSection(header, header->arcWeights, arcsCount, sizeof(int))
+		&& GraphFile_checkSection(header, header->positions, nodesCount, sizeof(Vector2))
+		&& GraphFile_checkSection(header, header->idOffsets, nodesCount, sizeof(int64_t))
+		&& GraphFile_checkSection(header, header->idStrings, 0, 1)
+		&& GraphFile_checkSection(header, header->idSlots, (uint64_t)capacity, sizeof(int))
+		&& GraphFile_checkSection(header, header->idHashes, (uint64_t)capacity, sizeof(uint32_t));
+}
+
+/// @brief Vérifie le contenu des sections en un seul parcours, en O(n + m) :
+/// les fonctions du graphe peuvent ensuite y accéder sans autre contrôle.
+static bool GraphFile_checkContent(const GraphFileHeader* header, const char* data)
+{
+	int nodesCount = header->nodesCount;
+	int arcsCount = header->arcsCount;
+
+	//The arcs of each node follow those of the previous node and lead to a node of the graph
+	const int* arcOffsets = (const int*)(data + header->arcOffsets);
+	if (arcOffsets[0] != 0 || arcOffsets[nodesCount] != arcsCount)
+		return false;
+	for (int i = 0; i < nodesCount; i++)
+	{
+		if (arcOffsets[i + 1] < arcOffsets[i])
+			return false;
+	}
+	const int* arcTargets = (const int*)(data + header->arcTargets);
+	for (int i = 0; i < arcsCount; i++)
+	{
+		if (arcTargets[i] < 0 || arcTargets[i] >= nodesCount)
+			return false;
+	}
+
+	//The ids are stored before the hash table, the last one ends with the table or its padding
+	if (header->idSlots < header->idStrings)
+		return false;
+	uint64_t stringsSize = header->idSlots - header->idStrings;
+	const char* idStrings = data + header->idStrings;
+	if (nodesCount > 0 && (stringsSize == 0 || idStrings[stringsSize - 1] != '\0'))
+		return false;
+	const int64_t* idOffsets = (const int64_t*)(data + header->idOffsets);
+	for (int i = 0; i < nodesCount; i++)
+	{
+		if (idOffsets[i] < 0 || (uint64_t)idOffsets[i] >= stringsSize)
+			return false;
+	}
+
+	//Each node has one slot, the others are empty so that every search ends
+	const int* idSlots = (const int*)(data + header->idSlots);
+	int usedSlots = 0;
+	for (int i = 0; i < header->idIndexCapacity; i++)
+	{
+		if (idSlots[i] >= nodesCount)
+			return false;
+		if (idSlots[i] >= 0)
+			usedSlots++;
+	}
+	return usedSlots == nodesCount;
+}
+
+Graph* Graph_loadBinary(const char* fileName)
+{
+	FileMapping* mapping = Platform_mapFile(fileName);
+	if (mapping == NULL)
+	{
+		fprintf(stderr, "Error opening file %s\n", fileName);
+		return NULL;
+	}
+
+	char* data = (char*)FileMapping_data(mapping);
+	const GraphFileHeader* header = (const GraphFileHeader*)data;
+	if (!GraphFile_checkHeader(header, FileMapping_size(mapping)) || !GraphFile_checkContent(header, data))
+	{
+		fprintf(stderr, "Invalid graph file %s\n", fileName);
+		Platform_unmapFile(mapping);
+		return NULL;
+	}
+
+	//Every array points into the file, nothing is copied
+	Graph* graph = (Graph*)calloc(1, sizeof(Graph));
+	AssertNew(graph);
+	graph->nodesCount = header->nodesCount;
+	graph->arcsCount = header->arcsCount;
+	graph->oriented = header->oriented;
+	graph->fileName = copyString(fileName);
+	graph->binaryFile = true;
+	graph->snapshotId = header->snapshotId;
+	graph->mapping = mapping;
+
+	graph->arcOffsets = (int*)(data + header->arcOffsets);
+	graph->arcTargets = (int*)(data + header->arcTargets);
+	graph->arcWeights = (int*)(data + header->arcWeights);
+	graph->positions = (Vector2*)(data + header->positions);
+	graph->idOffsets = (const int64_t*)(data + header->idOffsets);
+	graph->idStrings = data + header->idStrings;
+
+	graph->idIndex.capacity = header->idIndexCapacity;
+	graph->idIndex.count = header->nodesCount;
+	graph->idIndex.slots = header->idIndexCapacity > 0 ? (int*)(data + header->idSlots) : NULL;
+	graph->idIndex.hashes = header->idIndexCapacity > 0 ? (uint32_t*)(data + header->idHashes) : NULL;
+
+	Graph_touch(graph);
 	return graph;
 }
 
-void createAdjacentList(Graph* graph,
-	NodesList* adjencyList,
-	char* adjacents[],
-	long adjacentsWeight[],
-	int nbElement)
+bool Graph_convertJsonToBinary(const char* jsonFile, const char* binaryFile)
 {
-	//look in graphe for node 2, 3 and 4 because we have 
-	// an edge between node 1 and 2, 3 and 4
-	for (int i = 0; i < nbElement; i++)
+	Graph* graph = jsonCreateGraphFromFile(jsonFile);
+	if (graph == NULL)
+		return false;
+
+	bool ok = Graph_saveBinary(graph, binaryFile);
+	Graph_destroy(graph);
+	return ok;
+}
+
+Graph* Graph_loadFile(const char* fileName)
+{
+	size_t length = strlen(fileName);
+	size_t extensionLength = strlen(GRAPH_BINARY_EXTENSION);
+	if (length >= extensionLength && strcmp(fileName + length - extensionLength, GRAPH_BINARY_EXTENSION) == 0)
+		return Graph_loadBinary(fileName);
+
+	return jsonCreateGraphFromFile(fileName);
+}
+
+int Graph_uniformWeight(Graph* graph)
+{
+	//Version 0 is a graph that was never loaded nor edited
+	if (graph->version != 0 && graph->uniformWeightVersion == graph->version)
+		return graph->uniformWeight;
+
+	int weight = graph->arcsCount > 0 && graph->arcWeights[0] >= 0 ? graph->arcWeights[0] : -1;
+	for (int arc = 1; arc < graph->arcsCount && weight >= 0; arc++)
+	{
+		if (graph->arcWeights[arc] != weight)
+			weight = -1;
+	}
+
+	graph->uniformWeight = weight;
+	graph->uniformWeightVersion = graph->version;
+	return weight;
+}
+
+int Graph_maxWeight(Graph* graph)
+{
+	if (graph->version != 0 && graph->maxWeightVersion == graph->version)
+		return graph->maxWeight;
+
+	int weight = 0;
+	for (int arc = 0; arc < graph->arcsCount; arc++)
 	{
-		NodesList* tmp = graph->nodes;
-		//If vertexNode is not NULL, we have to create the next element of the list
-		//and set this new element as the next of current adjacent element
-		if (adjencyList->node != NULL)
+		if (graph->arcWeights[arc] > weight)
+			weight = graph->arcWeights[arc];
+	}
+
+	graph->maxWeight = weight;
+	graph->maxWeightVersion = graph->version;
+	return weight;
+}
+
+static uint64_t Graph_hash(uint64_t hash, const void* data, size_t size)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= GRAPH_FNV_PRIME;
+	}
+	return hash;
+}
+
+uint64_t Graph_fingerprint(Graph* graph)
+{
+	if (graph->version != 0 && graph->fingerprintVersion == graph->version)
+		return graph->fingerprint;
+
+	int32_t counts[3] = { graph->nodesCount, graph->arcsCount, graph->oriented != 0 };
+	uint64_t hash = Graph_hash(GRAPH_FNV_OFFSET, counts, sizeof(counts));
+
+	//The ids are hashed with their '\0', so that their order is part of the content
+	for (int i = 0; i < graph->nodesCount; i++)
+	{
+		const char* id = Graph_getNodeId(graph, i);
+		hash = Graph_hash(hash, id, strlen(id) + 1);
+	}
+	hash = Graph_hash(hash, graph->arcOffsets, (graph->nodesCount + 1) * sizeof(int));
+	hash = Graph_hash(hash, graph->arcTargets, graph->arcsCount * sizeof(int));
+	hash = Graph_hash(hash, graph->arcWeights, graph->arcsCount * sizeof(int));
+
+	graph->fingerprint = hash;
+	graph->fingerprintVersion = graph->version;
+	return hash;
+}
+
+int Graph_arcSource(Graph* graph, int arc)
+{
+	assert(graph && arc >= 0 && arc < graph->arcsCount);
+
+	//Last node u such that arcOffsets[u] <= arc
+	int low = 0;
+	int high = graph->nodesCount - 1;
+	while (low < high)
+	{
+		int mid = (low + high + 1) / 2;
+		if (graph->arcOffsets[mid] <= arc)
+			low = mid;
+		else
+			high = mid - 1;
+	}
+	return low;
+}
+
+int Graph_getNodeIndex(Graph* graph, const char* nodeId)
+{
+	if (graph->mapping != NULL)
+		return IdIndex_findPacked(&graph->idIndex, graph->idStrings, graph->idOffsets, nodeId);
+
+	return IdIndex_find(&graph->idIndex, graph->ids, nodeId);
+}
+
+int Graph_findArc(Graph* graph, int from, int to)
+{
+	int end = Graph_arcEnd(graph, from);
+	for (int arc = Graph_arcBegin(graph, from); arc < end; arc++)
+	{
+		if (graph->arcTargets[arc] == to)
+			return arc;
+	}
+	return -1;
+}
+
+void Graph_addObserver(Graph* graph, GraphEditCallback callback, void* context)
+{
+	assert(graph && callback);
+
+	graph->observers = (GraphObserver*)realloc(graph->observers, (graph->observersCount + 1) * sizeof(GraphObserver));
+	AssertNew(graph->observers);
+	graph->observers[graph->observersCount].callback = callback;
+	graph->observers[graph->observersCount].context = context;
+	graph->observersCount++;
+}
+
+void Graph_removeObserver(Graph* graph, GraphEditCallback callback, void* context)
+{
+	for (int i = 0; i < graph->observersCount; i++)
+	{
+		if (graph->observers[i].callback == callback && graph->observers[i].context == context)
 		{
-			adjencyList->next = (NodesList*)calloc(1, sizeof(NodesList));
-			AssertNew(adjencyList->next);
+			memmove(graph->observers + i, graph->observers + i + 1, (graph->observersCount - i - 1) * sizeof(GraphObserver));
+			graph->observersCount--;
+			return;
+		}
+	}
+}
+
+int Graph_addNode(Graph* graph, const char* nodeId, Vector2 position)
+{
+	Graph_unmap(graph);
 
-			adjencyList = adjencyList->next;
-			adjencyList->weight = 1;
-			adjencyList->node = NULL;
-			adjencyList->next = NULL;
+	int nodeIndex = graph->nodesCount;
+	Graph_reserveNodes(graph, nodeIndex + 1);
+
+	graph->ids[nodeIndex] = copyString(nodeId);
+	graph->positions[nodeIndex] = position;
+	graph->arcOffsets[nodeIndex + 1] = graph->arcsCount;
+	graph->nodesCount++;
+	graph->reverseValid = false;
+	IdIndex_insert(&graph->idIndex, graph->ids, nodeIndex);
+	Graph_notify(graph, GRAPH_EDIT_ADD_NODE, nodeIndex, -1, -1, -1, -1, -1);
+
+	return nodeIndex;
+}
+
+void Graph_moveNode(Graph* graph, int nodeIndex, Vector2 position)
+{
+	assert(nodeIndex >= 0 && nodeIndex < graph->nodesCount);
+
+	Vector2 oldPosition = graph->positions[nodeIndex];
+	if (oldPosition.x == position.x && oldPosition.y == position.y)
+		return;
+
+	graph->positions[nodeIndex] = position;
+	//Moves keep the version, but the scale of A* depends on the coordinates
+	graph->astarScaleVersion = 0;
+	Graph_notify(graph, GRAPH_EDIT_MOVE_NODE, nodeIndex, -1, -1, -1, -1, -1);
+}
+
+void Graph_removeNode(Graph* graph, int nodeIndex)
+{
+	assert(nodeIndex >= 0 && nodeIndex < graph->nodesCount);
+	Graph_unmap(graph);
+
+	//Compact the arrays in place : the arcs of nodeIndex and the arcs pointing
+	//to it are dropped, and every index greater than nodeIndex is shifted down
+	int arcsCount = 0;
+	int nodesCount = 0;
+	int begin = graph->arcOffsets[0];
+	for (int u = 0; u < graph->nodesCount; u++)
+	{
+		int end = graph->arcOffsets[u + 1];
+		if (u == nodeIndex)
+		{
+			free(graph->ids[u]);
+			begin = end;
+			continue;
 		}
 
-		//look for the node in the graph
-		while (tmp != NULL)
+		graph->arcOffsets[nodesCount] = arcsCount;
+		for (int arc = begin; arc < end; arc++)
 		{
-			if (tmp->node != NULL && strcmp(tmp->node->id, adjacents[i]) == 0)
-			{
-				adjencyList->node = tmp->node;
-				adjencyList->weight = adjacentsWeight[i];
-				break;
-			}
-			tmp = tmp->next;
+			int target = graph->arcTargets[arc];
+			if (target == nodeIndex)
+				continue;
+
+			graph->arcTargets[arcsCount] = target > nodeIndex ? target - 1 : target;
+			graph->arcWeights[arcsCount] = graph->arcWeights[arc];
+			arcsCount++;
 		}
+		graph->ids[nodesCount] = graph->ids[u];
+		graph->positions[nodesCount] = graph->positions[u];
+		nodesCount++;
+		begin = end;
 	}
+	graph->arcOffsets[nodesCount] = arcsCount;
+
+	graph->nodesCount = nodesCount;
+	graph->arcsCount = arcsCount;
+	graph->reverseValid = false;
+
+	//Every index above nodeIndex has changed
+	IdIndex_rebuild(&graph->idIndex, graph->ids, nodesCount);
+	Graph_notify(graph, GRAPH_EDIT_REMOVE_NODE, nodeIndex, -1, -1, -1, -1, -1);
 }
 
-void graph_destroy() {
+bool Graph_renameNode(Graph* graph, int nodeIndex, const char* nodeId)
+{
+	assert(nodeIndex >= 0 && nodeIndex < graph->nodesCount);
 
+	int owner = Graph_getNodeIndex(graph, nodeId);
+	if (owner == nodeIndex)
+		return true;
+	if (owner >= 0)
+		return false;
+
+	Graph_unmap(graph);
+	IdIndex_remove(&graph->idIndex, graph->ids, nodeIndex);
+	free(graph->ids[nodeIndex]);
+	graph->ids[nodeIndex] = copyString(nodeId);
+	IdIndex_insert(&graph->idIndex, graph->ids, nodeIndex);
+	Graph_notify(graph, GRAPH_EDIT_RENAME_NODE, nodeIndex, -1, -1, -1, -1, -1);
+	return true;
 }
 
-void saveGraph(Graph* graph)
+int Graph_addArc(Graph* graph, int from, int to, int weight)
 {
-	FILE* file = fopen(graph->fileName, "w");
-	if (file == NULL)
+	assert(from >= 0 && from < graph->nodesCount);
+	assert(to >= 0 && to < graph->nodesCount);
+
+	Graph_unmap(graph);
+	Graph_reserveArcs(graph, graph->arcsCount + 1);
+
+	if (graph->reverseValid)
 	{
-		fprintf(stderr, "Error opening file %s\n", graph->fileName);
-		return;
+		//The new in-arc of to follows the ones coming from nodes up to from
+		int slot = graph->reverseOffsets[to];
+		while (slot < graph->reverseOffsets[to + 1] && graph->reverseSources[slot] <= from)
+			slot++;
+		int movedIn = graph->arcsCount - slot;
+		memmove(graph->reverseSources + slot + 1, graph->reverseSources + slot, movedIn * sizeof(int));
+		memmove(graph->reverseWeights + slot + 1, graph->reverseWeights + slot, movedIn * sizeof(int));
+		graph->reverseSources[slot] = from;
+		graph->reverseWeights[slot] = weight;
+		for (int u = to + 1; u <= graph->nodesCount; u++)
+			graph->reverseOffsets[u]++;
 	}
-	fprintf(file, "{");
-	fprintf(file, "\"oriented\":%d,", graph->oriented);
-	//Saves the nodes ids
-	fprintf(file, "\"nodesIds\":[");
-	NodesList* curNodeList = graph->nodes;
-	for (size_t i = 0; i < graph->nodesCount; i++)
+
+	//The new arc is the last one of from, the arcs of the next nodes move one slot to the right
+	int arc = graph->arcOffsets[from + 1];
+	int moved = graph->arcsCount - arc;
+	memmove(graph->arcTargets + arc + 1, graph->arcTargets + arc, moved * sizeof(int));
+	memmove(graph->arcWeights + arc + 1, graph->arcWeights + arc, moved * sizeof(int));
+
+	graph->arcTargets[arc] = to;
+	graph->arcWeights[arc] = weight;
+	graph->arcsCount++;
+
+	for (int u = from + 1; u <= graph->nodesCount; u++)
+		graph->arcOffsets[u]++;
+	Graph_notify(graph, GRAPH_EDIT_ADD_ARC, -1, from, to, arc, -1, weight);
+
+	return arc;
+}
+
+void Graph_removeArc(Graph* graph, int arc)
+{
+	assert(arc >= 0 && arc < graph->arcsCount);
+
+	int from = Graph_arcSource(graph, arc);
+	int to = graph->arcTargets[arc];
+	int weight = graph->arcWeights[arc];
+
+	if (graph->reverseValid)
 	{
-		Node* curNode = curNodeList->node;
-		fprintf(file, "\"%s\"", curNode->id);
-		curNodeList = curNodeList->next;
-		if (i != graph->nodesCount - 1)
-			fprintf(file, ",");
+		int slot = Graph_reverseSlot(graph, from, arc);
+		int movedIn = graph->arcsCount - slot - 1;
+		memmove(graph->reverseSources + slot, graph->reverseSources + slot + 1, movedIn * sizeof(int));
+		memmove(graph->reverseWeights + slot, graph->reverseWeights + slot + 1, movedIn * sizeof(int));
+		for (int u = to + 1; u <= graph->nodesCount; u++)
+			graph->reverseOffsets[u]--;
+	}
+
+	int moved = graph->arcsCount - arc - 1;
+	memmove(graph->arcTargets + arc, graph->arcTargets + arc + 1, moved * sizeof(int));
+	memmove(graph->arcWeights + arc, graph->arcWeights + arc + 1, moved * sizeof(int));
+	graph->arcsCount--;
+
+	for (int u = from + 1; u <= graph->nodesCount; u++)
+		graph->arcOffsets[u]--;
+	Graph_notify(graph, GRAPH_EDIT_REMOVE_ARC, -1, from, to, arc, weight, -1);
+}
+
+void Graph_setArcWeight(Graph* graph, int arc, int weight)
+{
+	assert(arc >= 0 && arc < graph->arcsCount);
+	int oldWeight = graph->arcWeights[arc];
+	int from = Graph_arcSource(graph, arc);
+	if (graph->reverseValid)
+		graph->reverseWeights[Graph_reverseSlot(graph, from, arc)] = weight;
+	graph->arcWeights[arc] = weight;
+	Graph_notify(graph, GRAPH_EDIT_SET_WEIGHT, -1, from, graph->arcTargets[arc], arc, oldWeight, weight);
+}
+
+void Graph_permuteNodes(Graph* graph, const int* newIndices)
+{
+	Graph_unmap(graph);
+
+	int nodesCount = graph->nodesCount;
+	int capacity = graph->nodesCapacity > 0 ? graph->nodesCapacity : 1;
+
+	char** ids = (char**)malloc(capacity * sizeof(char*));
+	AssertNew(ids);
+	Vector2* positions = (Vector2*)malloc(capacity * sizeof(Vector2));
+	AssertNew(positions);
+	int* arcOffsets = (int*)malloc((capacity + 1) * sizeof(int));
+	AssertNew(arcOffsets);
+	int arcsCapacity = graph->arcsCapacity > 0 ? graph->arcsCapacity : 1;
+	int* arcTargets = (int*)malloc(arcsCapacity * sizeof(int));
+	AssertNew(arcTargets);
+	int* arcWeights = (int*)malloc(arcsCapacity * sizeof(int));
+	AssertNew(arcWeights);
+
+	int* oldIndices = (int*)malloc((nodesCount > 0 ? nodesCount : 1) * sizeof(int));
+	AssertNew(oldIndices);
+	for (int u = 0; u < nodesCount; u++)
+	{
+		assert(newIndices[u] >= 0 && newIndices[u] < nodesCount);
+		oldIndices[newIndices[u]] = u;
 	}
-	fprintf(file, "],");
 
-	//Saves each node information	
-	curNodeList = graph->nodes;
-	for (size_t i = 1; i <= graph->nodesCount; i++)
+	//The arcs of each node keep their order, only their targets are renamed
+	int arcsCount = 0;
+	for (int v = 0; v < nodesCount; v++)
 	{
-		Node* curNode = curNodeList->node;
-		fprintf(file, "\"%s\":{\"x\":%.1f,\"y\":%.1f,\"adjencyList\":[", curNode->id, curNode->x, curNode->y);
-		NodesList* adjencyList = curNode->adjacent;
-		while (adjencyList != NULL && adjencyList->node != NULL)
+		int u = oldIndices[v];
+		ids[v] = graph->ids[u];
+		positions[v] = graph->positions[u];
+		arcOffsets[v] = arcsCount;
+		for (int arc = graph->arcOffsets[u]; arc < graph->arcOffsets[u + 1]; arc++)
 		{
-			fprintf(file, "[\"%s\",%d]", adjencyList->node->id, adjencyList->weight);
-			adjencyList = adjencyList->next;
-			if (adjencyList != NULL)
-				fprintf(file, ",");
+			arcTargets[arcsCount] = newIndices[graph->arcTargets[arc]];
+			arcWeights[arcsCount] = graph->arcWeights[arc];
+			arcsCount++;
 		}
-		fprintf(file, "]}");
-		if (i != graph->nodesCount)
-			fprintf(file, ",");
-		curNodeList = curNodeList->next;
 	}
-	fprintf(file, "}");
-	fclose(file);
-}
+	arcOffsets[nodesCount] = arcsCount;
+	free(oldIndices);
 
-NodesList* Graph_getArcList(Graph* graph, int nodeIndex) {
-	NodesList* current = graph->nodes;
-	int i = 0;
-	while (current != NULL && current->node != NULL) {
-		if (i == nodeIndex) {
-			printf("Exploring arcs for node %s\n", current->node->id);
-			NodesList* arc = current->node->adjacent;
-			while (arc != NULL) {
-				printf(" -> %s (weight: %d)\n", arc->node->id, arc->weight);
-				arc = arc->next;
-			}
-			return current->node->adjacent;
-		}
-		current = current->next;
-		i++;
-	}
-	return NULL;
+	free(graph->ids);
+	free(graph->positions);
+	free(graph->arcOffsets);
+	free(graph->arcTargets);
+	free(graph->arcWeights);
+	graph->ids = ids;
+	graph->positions = positions;
+	graph->arcOffsets = arcOffsets;
+	graph->arcTargets = arcTargets;
+	graph->arcWeights = arcWeights;
+	graph->reverseValid = false;
+	IdIndex_rebuild(&graph->idIndex, graph->ids, nodesCount);
+
+	GraphEdit edit = { GRAPH_EDIT_PERMUTE_NODES, -1, -1, -1, -1, -1, -1, newIndices };
+	Graph_notifyEdit(graph, &edit);
 }
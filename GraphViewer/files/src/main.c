@@ -1,17 +1,77 @@
 #include "graph.h"
 #include "ShortestPath.h"
+#include "AltIndex.h"
+#include "DynamicShortestPath.h"
+#include "ReachabilityIndex.h"
+#include "EditJournal.h"
+#include "SelfTest.h"
 
 #include "display.h"
 
-int main() {
-	Graph* graph = jsonCreateGraphFromFile("./resources/graph.json");
+int main(int argc, char* argv[]) {
+	//GraphViewer --convert graph.json graph.gvb writes the binary version of a json graph
+	if (argc == 4 && strcmp(argv[1], "--convert") == 0)
+		return Graph_convertJsonToBinary(argv[2], argv[3]) ? 0 : 1;
 
-	Path* path = Graph_shortestPath(graph, "0", "5");
-	Path_print(path);
+	//GraphViewer --selftest [graph] checks every engine against Dijkstra, on the graph and on random graphs
+	if (argc >= 2 && strcmp(argv[1], "--selftest") == 0)
+		return SelfTest_run(argc >= 3 ? argv[2] : "./resources/graph.json") == 0 ? 0 : 1;
 
-	displayGraphWindow(graph);
+	//A binary graph (.gvb) is mapped in place instead of being parsed
+	Graph* graph = Graph_loadFile(argc >= 2 ? argv[1] : "./resources/graph.json");
+	if (graph == NULL)
+		return 1;
 
-	Path_destroy(path);
+	//The edits saved in the journal since the graph file was written are replayed
+	EditJournal* journal = EditJournal_open(graph);
+
+	//Queries without any path are answered without searching, the index follows the edits
+	ReachabilityIndex* reachability = ReachabilityIndex_create(graph);
+
+	//GraphViewer graph start end compares the searches between two nodes, "0" and "5" by default
+	const char* start = argc >= 4 ? argv[2] : "0";
+	const char* end = argc >= 4 ? argv[3] : "5";
+	DynamicShortestPath* tree = NULL;
+	if (Graph_getNodeIndex(graph, start) >= 0 && Graph_getNodeIndex(graph, end) >= 0)
+	{
+		ShortestPathStats stats;
+		ShortestPathOptions options = ShortestPathOptions_default();
+		options.stats = &stats;
+		options.reachability = reachability;
+
+		Path* path = Graph_shortestPath(graph, start, end, &options);
+		Path_print(path, graph);
+		int dijkstraSettled = stats.settledCount;
+
+		//Same query guided by the node coordinates
+		options.method = SHORTEST_PATH_ASTAR;
+		Path* astarPath = Graph_shortestPath(graph, start, end, &options);
+		int astarSettled = stats.settledCount;
+		Path_destroy(astarPath);
+
+		//Same query guided by landmarks, whose tables are kept next to the graph
+		AltIndex* landmarks = AltIndex_loadOrBuild(graph, NULL, 8, ALT_LANDMARKS_AVOID);
+		options.landmarks = landmarks;
+		Path* altPath = Graph_shortestPath(graph, start, end, &options);
+		printf("Settled nodes : Dijkstra %d, A* %d, ALT %d\n", dijkstraSettled, astarSettled, stats.settledCount);
+		Path_destroy(altPath);
+		AltIndex_destroy(landmarks);
+		Path_destroy(path);
+
+		//The highlighted path follows the edits made in the window
+		tree = DynamicShortestPath_create(graph, Graph_getNodeIndex(graph, start));
+		DynamicShortestPath_setTarget(tree, Graph_getNodeIndex(graph, end));
+	}
+	else
+	{
+		printf("Unknown node %s or %s, no path is searched\n", start, end);
+	}
+	displayGraphWindow(graph, tree, journal);
+
+	EditJournal_close(journal);
+	DynamicShortestPath_destroy(tree);
+	ReachabilityIndex_destroy(reachability);
+	Graph_destroy(graph);
 
 	return 0;
 }
@@ -0,0 +1,430 @@
+#include "json_stream.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Determines whether a character `ch` is whitespace
+ */
+#define is_whitespace(ch) (ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t')
+
+/**
+ * @brief State of a streaming parse
+ */
+typedef struct json_stream_s {
+  FILE *file;
+  char *buffer;
+  typed(size) length;
+  typed(size) position;
+
+  /**
+   * @brief Offset of `buffer[0]` in the document
+   */
+  typed(uint64) offset;
+
+  /**
+   * @brief Text of the string or number being read
+   */
+  char *token;
+  typed(size) token_length;
+  typed(size) token_capacity;
+
+  typed(json_stream_handler) handler;
+  void *context;
+  typed(json_stream_error) error;
+  bool failed;
+} typed(json_stream);
+
+/**
+ * @brief Parses the value starting at the current position
+ */
+static bool json_stream_parse_value(typed(json_stream) *, int);
+
+/**
+ * @brief Returns the next character without consuming it, EOF at the end of
+ * the file. The buffer is refilled when it has been consumed
+ */
+static int json_stream_peek(typed(json_stream) * stream) {
+  if (stream->position == stream->length) {
+    stream->offset += stream->length;
+    stream->length =
+        fread(stream->buffer, 1, JSON_STREAM_BUFFER_SIZE, stream->file);
+    stream->position = 0;
+    if (stream->length == 0)
+      return EOF;
+  }
+  return (unsigned char)stream->buffer[stream->position];
+}
+
+static int json_stream_next(typed(json_stream) * stream) {
+  int ch = json_stream_peek(stream);
+  if (ch != EOF)
+    stream->position++;
+  return ch;
+}
+
+static void json_stream_skip_whitespace(typed(json_stream) * stream) {
+  int ch = json_stream_peek(stream);
+  while (ch != EOF && is_whitespace(ch)) {
+    stream->position++;
+    ch = json_stream_peek(stream);
+  }
+}
+
+/**
+ * @brief Records the first error of the parse
+ */
+static bool json_stream_fail(typed(json_stream) * stream,
+                             typed(json_error) error) {
+  if (!stream->failed) {
+    stream->failed = true;
+    stream->error.error = error;
+    stream->error.offset = stream->offset + stream->position;
+  }
+  return false;
+}
+
+static bool json_stream_emit(typed(json_stream) * stream,
+                             typed(json_event) event,
+                             const typed(json_stream_value) * value,
+                             int depth) {
+  if (stream->handler(stream->context, event, value, depth))
+    return true;
+
+  stream->error.stopped = true;
+  return json_stream_fail(stream, JSON_ERROR_EMPTY);
+}
+
+static void json_stream_push(typed(json_stream) * stream, char ch) {
+  if (stream->token_length + 1 >= stream->token_capacity) {
+    stream->token_capacity *= 2;
+    stream->token = (char *)realloc(stream->token, stream->token_capacity);
+    if (stream->token == NULL)
+      abort();
+  }
+  stream->token[stream->token_length++] = ch;
+}
+
+/**
+ * @brief Appends a code point to the token, encoded in UTF-8
+ */
+static void json_stream_push_code_point(typed(json_stream) * stream,
+                                        uint32_t code) {
+  if (code < 0x80) {
+    json_stream_push(stream, (char)code);
+  } else if (code < 0x800) {
+    json_stream_push(stream, (char)(0xC0 | (code >> 6)));
+    json_stream_push(stream, (char)(0x80 | (code & 0x3F)));
+  } else if (code < 0x10000) {
+    json_stream_push(stream, (char)(0xE0 | (code >> 12)));
+    json_stream_push(stream, (char)(0x80 | ((code >> 6) & 0x3F)));
+    json_stream_push(stream, (char)(0x80 | (code & 0x3F)));
+  } else {
+    json_stream_push(stream, (char)(0xF0 | (code >> 18)));
+    json_stream_push(stream, (char)(0x80 | ((code >> 12) & 0x3F)));
+    json_stream_push(stream, (char)(0x80 | ((code >> 6) & 0x3F)));
+    json_stream_push(stream, (char)(0x80 | (code & 0x3F)));
+  }
+}
+
+/**
+ * @brief Reads the 4 hexadecimal digits of a \u escape
+ */
+static bool json_stream_read_hex(typed(json_stream) * stream, uint32_t *code) {
+  *code = 0;
+  for (int i = 0; i < 4; i++) {
+    int ch = json_stream_next(stream);
+    *code <<= 4;
+    if (ch >= '0' && ch <= '9')
+      *code |= (uint32_t)(ch - '0');
+    else if (ch >= 'a' && ch <= 'f')
+      *code |= (uint32_t)(ch - 'a' + 10);
+    else if (ch >= 'A' && ch <= 'F')
+      *code |= (uint32_t)(ch - 'A' + 10);
+    else
+      return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Reads a string, opening quote included, into the token
+ */
+static bool json_stream_read_string(typed(json_stream) * stream,
+                                    typed(json_error) error) {
+  stream->token_length = 0;
+  if (json_stream_next(stream) != '"')
+    return json_stream_fail(stream, error);
+
+  while (true) {
+    int ch = json_stream_next(stream);
+    if (ch == '"')
+      break;
+    if (ch == EOF || ch < 0x20)
+      return json_stream_fail(stream, error);
+    if (ch != '\\') {
+      json_stream_push(stream, (char)ch);
+      continue;
+    }
+
+    uint32_t code;
+    switch (json_stream_next(stream)) {
+    case '"':
+      json_stream_push(stream, '"');
+      break;
+    case '\\':
+      json_stream_push(stream, '\\');
+      break;
+    case '/':
+      json_stream_push(stream, '/');
+      break;
+    case 'b':
+      json_stream_push(stream, '\b');
+      break;
+    case 'f':
+      json_stream_push(stream, '\f');
+      break;
+    case 'n':
+      json_stream_push(stream, '\n');
+      break;
+    case 'r':
+      json_stream_push(stream, '\r');
+      break;
+    case 't':
+      json_stream_push(stream, '\t');
+      break;
+    case 'u':
+      if (!json_stream_read_hex(stream, &code))
+        return json_stream_fail(stream, error);
+      // A high surrogate must be followed by the low one
+      if (code >= 0xD800 && code < 0xDC00) {
+        uint32_t low;
+        if (json_stream_next(stream) != '\\' ||
+            json_stream_next(stream) != 'u' ||
+            !json_stream_read_hex(stream, &low) || low < 0xDC00 ||
+            low >= 0xE000)
+          return json_stream_fail(stream, error);
+        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+      } else if (code >= 0xDC00 && code < 0xE000) {
+        return json_stream_fail(stream, error);
+      }
+      json_stream_push_code_point(stream, code);
+      break;
+    default:
+      return json_stream_fail(stream, error);
+    }
+  }
+  stream->token[stream->token_length] = '\0';
+  return true;
+}
+
+static bool json_stream_is_number(int ch) {
+  return (ch >= '0' && ch <= '9') || ch == '-' || ch == '+' || ch == '.' ||
+         ch == 'e' || ch == 'E';
+}
+
+/**
+ * @brief Reads a number. Like {json_parse}, a number with a decimal point or
+ * an exponent is a double, the others are longs
+ */
+static bool json_stream_read_number(typed(json_stream) * stream,
+                                    typed(json_number) * number) {
+  stream->token_length = 0;
+  bool is_double = false;
+  for (int ch = json_stream_peek(stream); json_stream_is_number(ch);
+       ch = json_stream_peek(stream)) {
+    is_double = is_double || ch == '.' || ch == 'e' || ch == 'E';
+    json_stream_push(stream, (char)ch);
+    stream->position++;
+  }
+  stream->token[stream->token_length] = '\0';
+
+  char *end;
+  errno = 0;
+  if (is_double) {
+    number->type = JSON_NUMBER_TYPE_DOUBLE;
+    number->value.as_double = strtod(stream->token, &end);
+  } else {
+    number->type = JSON_NUMBER_TYPE_LONG;
+    number->value.as_long = strtol(stream->token, &end, 10);
+  }
+  if (stream->token_length == 0 || *end != '\0' || errno == ERANGE)
+    return json_stream_fail(stream, JSON_ERROR_INVALID_VALUE);
+  return true;
+}
+
+/**
+ * @brief Consumes the characters of `literal`
+ */
+static bool json_stream_expect(typed(json_stream) * stream,
+                               typed(json_string) literal) {
+  for (; *literal != '\0'; literal++) {
+    if (json_stream_next(stream) != *literal)
+      return json_stream_fail(stream, JSON_ERROR_INVALID_VALUE);
+  }
+  return true;
+}
+
+static bool json_stream_parse_object(typed(json_stream) * stream, int depth) {
+  typed(json_stream_value) value = {0};
+
+  stream->position++;
+  if (!json_stream_emit(stream, JSON_EVENT_OBJECT_BEGIN, &value, depth))
+    return false;
+
+  json_stream_skip_whitespace(stream);
+  if (json_stream_peek(stream) == '}') {
+    stream->position++;
+    return json_stream_emit(stream, JSON_EVENT_OBJECT_END, &value, depth);
+  }
+
+  while (true) {
+    json_stream_skip_whitespace(stream);
+    if (!json_stream_read_string(stream, JSON_ERROR_INVALID_KEY))
+      return false;
+    value.string = stream->token;
+    value.length = stream->token_length;
+    if (!json_stream_emit(stream, JSON_EVENT_KEY, &value, depth + 1))
+      return false;
+
+    json_stream_skip_whitespace(stream);
+    if (json_stream_next(stream) != ':')
+      return json_stream_fail(stream, JSON_ERROR_INVALID_KEY);
+    if (!json_stream_parse_value(stream, depth + 1))
+      return false;
+
+    json_stream_skip_whitespace(stream);
+    int ch = json_stream_next(stream);
+    if (ch == '}')
+      break;
+    if (ch != ',')
+      return json_stream_fail(stream, JSON_ERROR_INVALID_TYPE);
+  }
+
+  value.string = NULL;
+  value.length = 0;
+  return json_stream_emit(stream, JSON_EVENT_OBJECT_END, &value, depth);
+}
+
+static bool json_stream_parse_array(typed(json_stream) * stream, int depth) {
+  typed(json_stream_value) value = {0};
+
+  stream->position++;
+  if (!json_stream_emit(stream, JSON_EVENT_ARRAY_BEGIN, &value, depth))
+    return false;
+
+  json_stream_skip_whitespace(stream);
+  if (json_stream_peek(stream) == ']') {
+    stream->position++;
+    return json_stream_emit(stream, JSON_EVENT_ARRAY_END, &value, depth);
+  }
+
+  while (true) {
+    if (!json_stream_parse_value(stream, depth + 1))
+      return false;
+
+    json_stream_skip_whitespace(stream);
+    int ch = json_stream_next(stream);
+    if (ch == ']')
+      break;
+    if (ch != ',')
+      return json_stream_fail(stream, JSON_ERROR_INVALID_TYPE);
+  }
+  return json_stream_emit(stream, JSON_EVENT_ARRAY_END, &value, depth);
+}
+
+bool json_stream_parse_value(typed(json_stream) * stream, int depth) {
+  typed(json_stream_value) value = {0};
+
+  if (depth > JSON_STREAM_MAX_DEPTH)
+    return json_stream_fail(stream, JSON_ERROR_INVALID_VALUE);
+
+  json_stream_skip_whitespace(stream);
+  int ch = json_stream_peek(stream);
+  switch (ch) {
+  case '{':
+    return json_stream_parse_object(stream, depth);
+
+  case '[':
+    return json_stream_parse_array(stream, depth);
+
+  case '"':
+    if (!json_stream_read_string(stream, JSON_ERROR_INVALID_VALUE))
+      return false;
+    value.string = stream->token;
+    value.length = stream->token_length;
+    return json_stream_emit(stream, JSON_EVENT_STRING, &value, depth);
+
+  case 't':
+  case 'f':
+    value.boolean = ch == 't';
+    return json_stream_expect(stream, value.boolean ? "true" : "false") &&
+           json_stream_emit(stream, JSON_EVENT_BOOLEAN, &value, depth);
+
+  case 'n':
+    return json_stream_expect(stream, "null") &&
+           json_stream_emit(stream, JSON_EVENT_NULL, &value, depth);
+
+  case EOF:
+    return json_stream_fail(stream, JSON_ERROR_EMPTY);
+
+  default:
+    if (!json_stream_is_number(ch))
+      return json_stream_fail(stream, JSON_ERROR_INVALID_TYPE);
+    return json_stream_read_number(stream, &value.number) &&
+           json_stream_emit(stream, JSON_EVENT_NUMBER, &value, depth);
+  }
+}
+
+typed(json_boolean) json_stream_parse(FILE *file,
+                                      typed(json_stream_handler) handler,
+                                      void *context,
+                                      typed(json_stream_error) * error) {
+  typed(json_stream) stream = {0};
+  stream.file = file;
+  stream.handler = handler;
+  stream.context = context;
+  stream.buffer = (char *)malloc(JSON_STREAM_BUFFER_SIZE);
+  stream.token_capacity = 64;
+  stream.token = (char *)malloc(stream.token_capacity);
+  if (stream.buffer == NULL || stream.token == NULL)
+    abort();
+
+  bool ok = json_stream_parse_value(&stream, 0);
+  if (ok) {
+    // Only whitespace may follow the root value
+    json_stream_skip_whitespace(&stream);
+    if (json_stream_peek(&stream) != EOF)
+      ok = json_stream_fail(&stream, JSON_ERROR_INVALID_TYPE);
+  }
+  if (ok && ferror(file))
+    ok = json_stream_fail(&stream, JSON_ERROR_EMPTY);
+
+  if (error != NULL)
+    *error = stream.error;
+  free(stream.buffer);
+  free(stream.token);
+  return ok;
+}
+
+typed(json_boolean) json_stream_parse_file(typed(json_string) path,
+                                           typed(json_stream_handler) handler,
+                                           void *context,
+                                           typed(json_stream_error) * error) {
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    if (error != NULL) {
+      typed(json_stream_error) empty = {0};
+      *error = empty;
+      error->error = JSON_ERROR_EMPTY;
+    }
+    return false;
+  }
+
+  bool ok = json_stream_parse(file, handler, context, error);
+  fclose(file);
+  return ok;
+}
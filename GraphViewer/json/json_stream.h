@@ -0,0 +1,100 @@
+#ifndef JSON_STREAM_H
+#define JSON_STREAM_H
+
+    #include "json.h"
+
+    /**
+     * @brief Size of the blocks read from the file by the streaming parser
+     */
+    #define JSON_STREAM_BUFFER_SIZE (1 << 16)
+
+    /**
+     * @brief Maximum nesting of objects and arrays accepted by the
+     * streaming parser, which bounds its recursion
+     */
+    #define JSON_STREAM_MAX_DEPTH 512
+
+    typedef enum json_event_e {
+        JSON_EVENT_OBJECT_BEGIN = 0,
+        JSON_EVENT_OBJECT_END,
+        JSON_EVENT_ARRAY_BEGIN,
+        JSON_EVENT_ARRAY_END,
+        JSON_EVENT_KEY,
+        JSON_EVENT_STRING,
+        JSON_EVENT_NUMBER,
+        JSON_EVENT_BOOLEAN,
+        JSON_EVENT_NULL
+    } typed(json_event);
+
+    /**
+     * @brief Value attached to an event. `string` is only set for
+     * {JSON_EVENT_KEY} and {JSON_EVENT_STRING}, `number` for
+     * {JSON_EVENT_NUMBER} and `boolean` for {JSON_EVENT_BOOLEAN}
+     */
+    typedef struct json_stream_value_s {
+        /**
+         * @brief Unescaped and null terminated string, owned by the parser
+         * and only valid during the call of the handler
+         */
+        typed(json_string) string;
+        typed(size) length;
+        typed(json_number) number;
+        typed(json_boolean) boolean;
+    } typed(json_stream_value);
+
+    /**
+     * @brief Function called for each event of the document, in order
+     *
+     * @param depth The number of objects and arrays containing the event:
+     * 0 for the root value, 1 for the keys and values of the root object...
+     * The END event of a container has the depth of its BEGIN event
+     * @return false to stop the parsing
+     */
+    typedef typed(json_boolean) (*typed(json_stream_handler))(
+        void *context, typed(json_event) event,
+        const typed(json_stream_value) *value, int depth);
+
+    typedef struct json_stream_error_s {
+        /**
+         * @brief Kind of syntax error, meaningless if `stopped` is true
+         */
+        typed(json_error) error;
+
+        /**
+         * @brief Offset of the error from the start of the document, in bytes
+         */
+        typed(uint64) offset;
+
+        /**
+         * @brief Whether the parsing was stopped by the handler
+         */
+        typed(json_boolean) stopped;
+    } typed(json_stream_error);
+
+    /**
+     * @brief Parses a JSON document read from a file, without building it in
+     * memory: each object, array, key and value is reported to `handler` as
+     * soon as it is read (SAX-style parsing). The memory used is a fixed size
+     * buffer plus the longest string or number of the document, whatever
+     * the size of the file
+     *
+     * @param file The file, read from its current position to its end
+     * @param error Receives the reason of a failure, may be NULL
+     * @return true if the whole document was parsed
+     */
+    typed(json_boolean) json_stream_parse(FILE *file,
+                                          typed(json_stream_handler) handler,
+                                          void *context,
+                                          typed(json_stream_error) *error);
+
+    /**
+     * @brief Opens a file and parses it with {json_stream_parse}
+     *
+     * @return false if the file cannot be opened or parsed
+     */
+    typed(json_boolean) json_stream_parse_file(typed(json_string) path,
+                                               typed(json_stream_handler) handler,
+                                               void *context,
+                                               typed(json_stream_error) *error);
+
+#endif // !JSON_STREAM_H